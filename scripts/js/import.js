@@ -290,39 +290,47 @@ function addTrailer(obj) {
 
 // main script part
 
-if (getPlaylistType(orig.mimetype) === '') {
-    var arr = orig.mimetype.split('/');
-    var mime = arr[0];
-    
-    // All virtual objects are references to objects in the
-    // PC-Directory, so make sure to correctly set the reference ID!
-    
-    var obj = orig; 
-    obj.refID = orig.id;
-    
-    if (mime === 'audio') {
-        addAudio(obj);
-    }
-    
-    if (mime === 'video') {
-        if (obj.onlineservice === ONLINE_SERVICE_APPLE_TRAILERS) {
-            addTrailer(obj);
-        } else {
-            addVideo(obj);
-        }
-    }
-    
-    if (mime === 'image') {
-        addImage(obj);
-    }
+// called for every imported object, the script itself only runs once
+function importItem(orig) {
+    if (getPlaylistType(orig.mimetype) === '') {
+        var arr = orig.mimetype.split('/');
+        var mime = arr[0];
 
-    // We now also have OGG Theora recognition, so we can ensure that
-    // Vorbis
-    if (orig.mimetype === 'application/ogg') {
-        if (orig.theora === 1) {
-            addVideo(obj);
-        } else {
+        // All virtual objects are references to objects in the
+        // PC-Directory, so make sure to correctly set the reference ID!
+
+        var obj = orig;
+        obj.refID = orig.id;
+
+        if (mime === 'audio') {
             addAudio(obj);
         }
+
+        if (mime === 'video') {
+            if (obj.onlineservice === ONLINE_SERVICE_APPLE_TRAILERS) {
+                addTrailer(obj);
+            } else {
+                addVideo(obj);
+            }
+        }
+
+        if (mime === 'image') {
+            addImage(obj);
+        }
+
+        // We now also have OGG Theora recognition, so we can ensure that
+        // Vorbis
+        if (orig.mimetype === 'application/ogg') {
+            if (orig.theora === 1) {
+                addVideo(obj);
+            } else {
+                addAudio(obj);
+            }
+        }
     }
 }
+
+// servers without entry point support run the whole script for every object
+if (typeof orig !== 'undefined') {
+    importItem(orig);
+}
@@ -40,6 +40,7 @@
 
 #include "content_manager.h"
 #include "database/database.h"
+#include "util/directory_crawler.h"
 
 #define INOTIFY_MAX_USER_WATCHES_FILE "/proc/sys/fs/inotify/max_user_watches"
 
@@ -47,6 +48,7 @@ AutoscanInotify::AutoscanInotify(std::shared_ptr<Database> database, std::shared
     : database(std::move(database))
     , content(std::move(content))
     , config(std::move(config))
+    , quietPeriod(this->config->getIntOption(CFG_IMPORT_AUTOSCAN_INOTIFY_QUIET_PERIOD))
 {
     std::error_code ec;
     if (isRegularFile(INOTIFY_MAX_USER_WATCHES_FILE, ec)) {
@@ -144,10 +146,13 @@ void AutoscanInotify::threadProc()
 
             lock.unlock();
 
-            /* --- get event --- (blocking) */
-            inotify_event* event = inotify->nextEvent();
+            /* --- get event --- (blocking, until a pending move expires) */
+            inotify_event* event = inotify->nextEvent(getTimeout());
             /* --- */
 
+            expireMoves();
+            flushChanges();
+
             if (event) {
                 int wd = event->wd;
                 int mask = event->mask;
@@ -177,7 +182,10 @@ void AutoscanInotify::threadProc()
                     checkMoveWatches(wd, wdObj);
                 }
 
-                if (mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)) {
+                // the directory was already moved with its watches
+                bool movedAlready = (mask & IN_MOVE_SELF) && movedWatches.erase(wd) > 0;
+
+                if (!movedAlready && mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)) {
                     recheckNonexistingMonitors(wd, wdObj);
                 }
 
@@ -198,8 +206,15 @@ void AutoscanInotify::threadProc()
                     }
                 }
 
-                if (adir != nullptr && mask & (IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_UNMOUNT | IN_CREATE)) {
-                    if (!(mask & (IN_MOVED_TO | IN_CREATE))) {
+                if (movedAlready) {
+                    log_debug("ignoring move of {}, already moved", path.c_str());
+                } else if (adir != nullptr && (mask & IN_MOVED_FROM) && event->cookie != 0) {
+                    startMove(event->cookie, path, mask & IN_ISDIR, adir);
+                } else if (adir != nullptr && (mask & IN_MOVED_TO) && finishMove(event->cookie, path, mask & IN_ISDIR, adir)) {
+                    if (mask & IN_ISDIR)
+                        monitorUnmonitorRecursive(path, false, adir, false);
+                } else if (adir != nullptr && mask & (IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_UNMOUNT | IN_CREATE)) {
+                    if (!(mask & (IN_MOVED_TO | IN_CREATE | IN_CLOSE_WRITE))) {
                         log_debug("deleting {}", path.c_str());
 
                         if (mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)) {
@@ -214,26 +229,18 @@ void AutoscanInotify::threadProc()
                             }
                         }
 
-                        int objectID = database->findObjectIDByPath(path, !(mask & IN_ISDIR));
-                        if (objectID != INVALID_OBJECT_ID)
-                            content->removeObject(objectID, !(mask & IN_MOVED_TO));
+                        queueChange(path, mask & IN_ISDIR, true, false, adir);
                     }
                     if (mask & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE)) {
                         log_debug("adding {}", path.c_str());
-                        // path, recursive, async, hidden, rescanResource, low priority, cancellable
-                        AutoScanSetting asSetting;
-                        asSetting.followSymlinks = config->getBoolOption(CFG_IMPORT_FOLLOW_SYMLINKS);
-                        asSetting.recursive = adir->getRecursive();
-                        asSetting.hidden = adir->getHidden();
-                        asSetting.rescanResource = true;
-                        asSetting.mergeOptions(config, path);
-                        content->addFile(path, adir->getLocation(), asSetting, true, true, false);
+                        queueChange(path, mask & IN_ISDIR, false, true, adir);
 
                         if (mask & IN_ISDIR)
                             monitorUnmonitorRecursive(path, false, adir, false);
                     }
                 }
                 if (mask & IN_IGNORED) {
+                    movedWatches.erase(wd);
                     removeWatchMoves(wd);
                     removeDescendants(wd);
                     watches->erase(wd);
@@ -245,6 +252,161 @@ void AutoscanInotify::threadProc()
     }
 }
 
+void AutoscanInotify::startMove(uint32_t cookie, const fs::path& path, bool isDir, const std::shared_ptr<AutoscanDirectory>& adir)
+{
+    log_debug("waiting for the new location of {}", path.c_str());
+    auto expires = std::chrono::steady_clock::now() + std::chrono::milliseconds(INOTIFY_MOVE_TIMEOUT);
+    pendingMoves[cookie] = PendingMove { path, isDir, adir, expires };
+}
+
+bool AutoscanInotify::finishMove(uint32_t cookie, const fs::path& path, bool isDir, const std::shared_ptr<AutoscanDirectory>& adir)
+{
+    auto it = pendingMoves.find(cookie);
+    if (cookie == 0 || it == pendingMoves.end())
+        return false;
+
+    auto move = it->second;
+    pendingMoves.erase(it);
+
+    // moves between autoscan directories and to or from hidden names are imported again
+    bool hidden = path.filename().string().at(0) == '.';
+    bool wasHidden = move.path.filename().string().at(0) == '.';
+    if (move.adir != adir || ((hidden || wasHidden) && !adir->getHidden())) {
+        queueChange(move.path, move.isDir, true, false, move.adir);
+        return false;
+    }
+
+    log_debug("moving {} to {}", move.path.c_str(), path.c_str());
+    if (isDir)
+        renameWatches(move.path, path);
+    renameChanges(move.path, path);
+    content->moveFile(move.path, isDir, path, adir->getLocation());
+    // imports the file if it was unknown so far, a moved file is unchanged
+    if (!isDir)
+        queueChange(path, false, false, true, adir);
+    return true;
+}
+
+void AutoscanInotify::expireMoves()
+{
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = pendingMoves.begin(); it != pendingMoves.end();) {
+        if (it->second.expires <= now) {
+            log_debug("deleting {}, moved away", it->second.path.c_str());
+            queueChange(it->second.path, it->second.isDir, true, false, it->second.adir);
+            it = pendingMoves.erase(it);
+        } else
+            ++it;
+    }
+}
+
+void AutoscanInotify::queueChange(const fs::path& path, bool isDir, bool remove, bool add, const std::shared_ptr<AutoscanDirectory>& adir)
+{
+    auto due = std::chrono::steady_clock::now() + quietPeriod;
+    auto it = pendingChanges.find(path);
+    if (it == pendingChanges.end()) {
+        pendingChanges.emplace(path, PendingChange { isDir, remove, add, adir, due });
+    } else {
+        // the last event decides if the path exists, a removal in between is kept
+        auto& change = it->second;
+        change.isDir = isDir;
+        change.remove = change.remove || remove;
+        change.add = add;
+        change.adir = adir;
+        change.due = due;
+    }
+    changeQueue.emplace_back(due, path);
+}
+
+void AutoscanInotify::flushChanges()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::vector<FileChange> changes;
+    std::unordered_set<std::string> addedDirs;
+
+    while (!changeQueue.empty() && changeQueue.front().first <= now) {
+        auto [due, path] = std::move(changeQueue.front());
+        changeQueue.pop_front();
+
+        auto it = pendingChanges.find(path);
+        if (it == pendingChanges.end() || it->second.due != due)
+            continue;
+        auto change = it->second;
+        pendingChanges.erase(it);
+
+        // a new directory is imported recursively anyway
+        if (!change.remove && isImportedWithParent(path, change.adir->getLocation(), addedDirs))
+            continue;
+        if (change.isDir && change.add)
+            addedDirs.insert(path.string());
+
+        changes.push_back(FileChange { path, change.isDir, change.remove, change.add, change.adir });
+    }
+
+    if (!changes.empty()) {
+        log_debug("handing over {} changed paths", changes.size());
+        content->handleFileChanges(std::move(changes));
+    }
+}
+
+void AutoscanInotify::renameChanges(const fs::path& oldPath, const fs::path& newPath)
+{
+    std::string prefix = oldPath.string() + DIR_SEPARATOR;
+    for (auto it = pendingChanges.lower_bound(oldPath); it != pendingChanges.end();) {
+        std::string location = it->first.string();
+        if (location != oldPath.string() && !startswith(location, prefix))
+            break;
+
+        auto change = it->second;
+        it = pendingChanges.erase(it);
+        auto newLocation = location == oldPath.string() ? newPath : newPath / location.substr(prefix.size());
+        pendingChanges[newLocation] = change;
+        changeQueue.emplace_back(change.due, newLocation);
+    }
+}
+
+bool AutoscanInotify::isImportedWithParent(const fs::path& path, const fs::path& root, const std::unordered_set<std::string>& addedDirs) const
+{
+    for (auto parent = path.parent_path(); parent.string().size() > root.string().size(); parent = parent.parent_path()) {
+        if (addedDirs.find(parent.string()) != addedDirs.end())
+            return true;
+        auto it = pendingChanges.find(parent);
+        if (it != pendingChanges.end() && it->second.isDir && it->second.add)
+            return true;
+    }
+    return false;
+}
+
+int AutoscanInotify::getTimeout() const
+{
+    std::chrono::steady_clock::time_point next;
+    if (!changeQueue.empty())
+        next = changeQueue.front().first;
+    for (const auto& [cookie, move] : pendingMoves) {
+        if (next == std::chrono::steady_clock::time_point() || move.expires < next)
+            next = move.expires;
+    }
+    if (next == std::chrono::steady_clock::time_point())
+        return -1;
+
+    auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(next - std::chrono::steady_clock::now()).count();
+    return timeout > 0 ? static_cast<int>(timeout) : 0;
+}
+
+void AutoscanInotify::renameWatches(const fs::path& oldPath, const fs::path& newPath)
+{
+    std::string prefix = oldPath.string() + DIR_SEPARATOR;
+    for (const auto& [wd, wdObj] : *watches) {
+        std::string location = wdObj->getPath().string();
+        if (location == oldPath.string()) {
+            wdObj->setPath(newPath);
+            movedWatches.insert(wd);
+        } else if (startswith(location, prefix)) {
+            wdObj->setPath(newPath / location.substr(prefix.size()));
+        }
+    }
+}
+
 void AutoscanInotify::monitor(const std::shared_ptr<AutoscanDirectory>& dir)
 {
     assert(dir->getScanMode() == ScanMode::INotify);
@@ -358,15 +520,15 @@ void AutoscanInotify::recheckNonexistingMonitor(int curWd, const std::vector<std
 
 void AutoscanInotify::checkMoveWatches(int wd, const std::shared_ptr<Wd>& wdObj)
 {
-    auto wdWatches = wdObj->getWdWatches();
-    for (auto it = wdWatches->begin(); it != wdWatches->end(); /*++it*/) {
+    auto& wdWatches = wdObj->getWdWatches();
+    for (auto it = wdWatches.begin(); it != wdWatches.end(); /*++it*/) {
         auto& watch = *it;
         if (watch->getType() == WatchType::Move) {
-            if (wdWatches->size() == 1) {
+            if (wdWatches.size() == 1) {
                 inotify->removeWatch(wd);
                 ++it;
             } else {
-                it = wdWatches->erase(it);
+                it = wdWatches.erase(it);
             }
 
             auto watchMv = std::static_pointer_cast<WatchMove>(watch);
@@ -401,8 +563,8 @@ void AutoscanInotify::checkMoveWatches(int wd, const std::shared_ptr<Wd>& wdObj)
 
 void AutoscanInotify::recheckNonexistingMonitors(int wd, const std::shared_ptr<Wd>& wdObj)
 {
-    auto wdWatches = wdObj->getWdWatches();
-    for (const auto& watch : *wdWatches) {
+    auto& wdWatches = wdObj->getWdWatches();
+    for (const auto& watch : wdWatches) {
         if (watch->getType() == WatchType::Autoscan) {
             auto watchAs = std::static_pointer_cast<WatchAutoscan>(watch);
             auto pathAr = watchAs->getNonexistingPathArray();
@@ -415,20 +577,20 @@ void AutoscanInotify::recheckNonexistingMonitors(int wd, const std::shared_ptr<W
 
 void AutoscanInotify::removeNonexistingMonitor(int wd, const std::shared_ptr<Wd>& wdObj, const std::vector<std::string>& pathAr)
 {
-    auto wdWatches = wdObj->getWdWatches();
-    for (auto it = wdWatches->begin(); it != wdWatches->end(); /*++it*/) {
+    auto& wdWatches = wdObj->getWdWatches();
+    for (auto it = wdWatches.begin(); it != wdWatches.end(); /*++it*/) {
         auto& watch = *it;
         if (watch->getType() == WatchType::Autoscan) {
             auto watchAs = std::static_pointer_cast<WatchAutoscan>(watch);
             if (watchAs->getNonexistingPathArray() == pathAr) {
-                if (wdWatches->size() == 1) {
+                if (wdWatches.size() == 1) {
                     // should be done automatically, because removeWatch triggers an IGNORED event
                     //watches->remove(wd);
 
                     inotify->removeWatch(wd);
                     ++it;
                 } else {
-                    it = wdWatches->erase(it);
+                    it = wdWatches.erase(it);
                 }
                 return;
             }
@@ -447,31 +609,42 @@ void AutoscanInotify::monitorUnmonitorRecursive(const fs::path& startPath, bool
             return;
     }
 
-    DIR* dir = opendir(startPath.c_str());
-    if (!dir) {
-        log_warning("Could not open {}", startPath.c_str());
-        return;
-    }
+    // all directories below share one watch and the start point
+    auto descendant = std::make_shared<WatchAutoscan>(false, adir);
+    int startPointWd = unmonitor ? INOTIFY_ROOT : inotify->addWatch(adir->getLocation(), events);
 
-    struct dirent* dent;
-    while ((dent = readdir(dir)) != nullptr && !shutdownFlag) {
-        char* name = dent->d_name;
-        if (name[0] == '.') {
-            if (name[1] == 0)
-                continue;
-            if (name[1] == '.' && name[2] == 0)
-                continue;
-        }
+    auto start = std::chrono::steady_clock::now();
+    std::size_t count = 0;
 
-        fs::path fullpath = startPath / name;
-        if (fs::is_directory(fullpath))
-            monitorUnmonitorRecursive(fullpath, unmonitor, adir, false);
+    // subdirectories are listed by the shared crawler, watches are set up here
+    auto crawl = content->getDirectoryCrawler()->start(startPath, true, true, true);
+    while (auto listing = crawl->next([this]() { return shutdownFlag; })) {
+        for (const auto& entry : listing->entries) {
+            if (shutdownFlag) {
+                crawl->stop();
+                return;
+            }
+
+            if (unmonitor)
+                unmonitorDirectory(entry.path, adir);
+            else
+                monitorDirectory(entry.path, adir, false, nullptr, descendant, startPointWd);
+
+            if (++count % INOTIFY_PROGRESS_INTERVAL == 0)
+                log_info("{} {} directories below {}", unmonitor ? "Unwatched" : "Watching", count, startPath.c_str());
+        }
     }
+    if (shutdownFlag)
+        return;
 
-    closedir(dir);
+    if (count >= INOTIFY_PROGRESS_INTERVAL) {
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        log_info("{} {} directories below {} in {} ms", unmonitor ? "Unwatched" : "Watching", count, startPath.c_str(), duration);
+    }
 }
 
-int AutoscanInotify::monitorDirectory(const fs::path& path, const std::shared_ptr<AutoscanDirectory>& adir, bool startPoint, const std::vector<std::string>* pathArray)
+int AutoscanInotify::monitorDirectory(const fs::path& path, const std::shared_ptr<AutoscanDirectory>& adir, bool startPoint, const std::vector<std::string>* pathArray,
+    const std::shared_ptr<WatchAutoscan>& descendant, int startPointWd)
 {
     int wd = inotify->addWatch(path, events);
     if (wd < 0) {
@@ -502,14 +675,15 @@ int AutoscanInotify::monitorDirectory(const fs::path& path, const std::shared_pt
         }
 
         if (!alreadyWatching) {
-            auto watch = std::make_shared<WatchAutoscan>(startPoint, adir);
+            auto watch = (descendant != nullptr && !startPoint && pathArray == nullptr) ? descendant : std::make_shared<WatchAutoscan>(startPoint, adir);
             if (pathArray != nullptr) {
                 watch->setNonexistingPathArray(*pathArray);
             }
             wdObj->addWatch(watch);
 
             if (!startPoint) {
-                int startPointWd = inotify->addWatch(adir->getLocation(), events);
+                if (startPointWd < 0)
+                    startPointWd = inotify->addWatch(adir->getLocation(), events);
                 log_debug("getting start point for {} -> {} wd={}", path.c_str(), adir->getLocation().c_str(), startPointWd);
                 if (wd >= 0)
                     addDescendant(startPointWd, wd, adir);
@@ -542,7 +716,7 @@ void AutoscanInotify::unmonitorDirectory(const fs::path& path, const std::shared
     if (watchAs == nullptr) {
         log_debug("autoscan not found in watches? ({}, {})", wd, path.c_str());
     } else {
-        if (wdObj->getWdWatches()->size() == 1) {
+        if (wdObj->getWdWatches().size() == 1) {
             // should be done automatically, because removeWatch triggers an IGNORED event
             //watches->remove(wd);
 
@@ -555,8 +729,8 @@ void AutoscanInotify::unmonitorDirectory(const fs::path& path, const std::shared
 
 std::shared_ptr<AutoscanInotify::WatchAutoscan> AutoscanInotify::getAppropriateAutoscan(const std::shared_ptr<Wd>& wdObj, const std::shared_ptr<AutoscanDirectory>& adir)
 {
-    auto wdWatches = wdObj->getWdWatches();
-    for (const auto& watch : *wdWatches) {
+    auto& wdWatches = wdObj->getWdWatches();
+    for (const auto& watch : wdWatches) {
         if (watch->getType() == WatchType::Autoscan) {
             auto watchAs = std::static_pointer_cast<WatchAutoscan>(watch);
             if (watchAs->getNonexistingPathArray().empty()) {
@@ -573,8 +747,8 @@ std::shared_ptr<AutoscanInotify::WatchAutoscan> AutoscanInotify::getAppropriateA
 {
     fs::path pathBestMatch;
     std::shared_ptr<WatchAutoscan> bestMatch = nullptr;
-    auto wdWatches = wdObj->getWdWatches();
-    for (const auto& watch : *wdWatches) {
+    auto& wdWatches = wdObj->getWdWatches();
+    for (const auto& watch : wdWatches) {
         if (watch->getType() == WatchType::Autoscan) {
             auto watchAs = std::static_pointer_cast<WatchAutoscan>(watch);
             if (watchAs->getNonexistingPathArray().empty()) {
@@ -608,24 +782,24 @@ void AutoscanInotify::removeWatchMoves(int wd)
             break;
         }
 
-        auto wdWatches = wdObj->getWdWatches();
-        if (wdWatches->empty())
+        auto& wdWatches = wdObj->getWdWatches();
+        if (wdWatches.empty())
             break;
 
         if (first) {
             first = false;
         } else {
-            for (auto it = wdWatches->begin(); it != wdWatches->end(); /*++it*/) {
+            for (auto it = wdWatches.begin(); it != wdWatches.end(); /*++it*/) {
                 auto& watch = *it;
                 if (watch->getType() == WatchType::Move) {
                     auto watchMv = std::static_pointer_cast<WatchMove>(watch);
                     if (watchMv->getRemoveWd() == wd) {
                         log_debug("removing watch move");
-                        if (wdWatches->size() == 1) {
+                        if (wdWatches.size() == 1) {
                             inotify->removeWatch(checkWd);
                             ++it;
                         } else
-                            it = wdWatches->erase(it);
+                            it = wdWatches.erase(it);
                     } else
                         ++it;
                 }
@@ -637,15 +811,15 @@ void AutoscanInotify::removeWatchMoves(int wd)
 
 bool AutoscanInotify::removeFromWdObj(const std::shared_ptr<Wd>& wdObj, const std::shared_ptr<Watch>& toRemove)
 {
-    auto wdWatches = wdObj->getWdWatches();
-    for (auto it = wdWatches->begin(); it != wdWatches->end(); /*++it*/) {
+    auto& wdWatches = wdObj->getWdWatches();
+    for (auto it = wdWatches.begin(); it != wdWatches.end(); /*++it*/) {
         auto& watch = *it;
         if (watch == toRemove) {
-            if (wdWatches->size() == 1) {
+            if (wdWatches.size() == 1) {
                 inotify->removeWatch(wdObj->getWd());
                 ++it;
             } else
-                it = wdWatches->erase(it);
+                it = wdWatches.erase(it);
             return true;
         }
         ++it;
@@ -655,8 +829,8 @@ bool AutoscanInotify::removeFromWdObj(const std::shared_ptr<Wd>& wdObj, const st
 
 std::shared_ptr<AutoscanInotify::WatchAutoscan> AutoscanInotify::getStartPoint(const std::shared_ptr<Wd>& wdObj)
 {
-    auto wdWatches = wdObj->getWdWatches();
-    for (const auto& watch : *wdWatches) {
+    auto& wdWatches = wdObj->getWdWatches();
+    for (const auto& watch : wdWatches) {
         if (watch->getType() == WatchType::Autoscan) {
             auto watchAs = std::static_pointer_cast<WatchAutoscan>(watch);
             if (watchAs->isStartPoint())
@@ -696,8 +870,8 @@ void AutoscanInotify::removeDescendants(int wd)
         return;
     }
 
-    auto wdWatches = wdObj->getWdWatches();
-    for (const auto& watch : *wdWatches) {
+    auto& wdWatches = wdObj->getWdWatches();
+    for (const auto& watch : wdWatches) {
         if (watch->getType() == WatchType::Autoscan) {
             auto watchAs = std::static_pointer_cast<WatchAutoscan>(watch);
             for (int descWd : watchAs->getDescendants()) {
@@ -31,11 +31,15 @@
 #ifndef __AUTOSCAN_INOTIFY_H__
 #define __AUTOSCAN_INOTIFY_H__
 
+#include <chrono>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -50,6 +54,11 @@ class ContentManager;
 #define INOTIFY_ROOT (-1)
 #define INOTIFY_UNKNOWN_PARENT_WD (-2)
 
+// milliseconds to wait for the IN_MOVED_TO of a rename
+#define INOTIFY_MOVE_TIMEOUT 500
+// number of directories between progress messages while setting up watches
+#define INOTIFY_PROGRESS_INTERVAL 10000
+
 class AutoscanInotify {
 public:
     AutoscanInotify(std::shared_ptr<Database> database, std::shared_ptr<ContentManager> content, std::shared_ptr<Config> config);
@@ -141,22 +150,22 @@ private:
     class Wd {
     public:
         Wd(fs::path path, int wd, int parentWd)
-            : wdWatches(std::make_shared<std::vector<std::shared_ptr<Watch>>>())
         {
             this->path = std::move(path);
             this->wd = wd;
             this->parentWd = parentWd;
         }
         fs::path getPath() const { return path; }
+        void setPath(fs::path path) { this->path = std::move(path); }
         int getWd() const { return wd; }
         int getParentWd() const { return parentWd; }
         void setParentWd(int parentWd) { this->parentWd = parentWd; }
 
-        std::shared_ptr<std::vector<std::shared_ptr<Watch>>> getWdWatches() const { return wdWatches; }
-        void addWatch(const std::shared_ptr<Watch>& w) { wdWatches->push_back(w); }
+        std::vector<std::shared_ptr<Watch>>& getWdWatches() { return wdWatches; }
+        void addWatch(const std::shared_ptr<Watch>& w) { wdWatches.push_back(w); }
 
     private:
-        std::shared_ptr<std::vector<std::shared_ptr<Watch>>> wdWatches;
+        std::vector<std::shared_ptr<Watch>> wdWatches;
         fs::path path;
         int parentWd;
         int wd;
@@ -164,8 +173,49 @@ private:
 
     std::unique_ptr<std::unordered_map<int, std::shared_ptr<Wd>>> watches;
 
+    /// \brief first half of a rename, waiting for the IN_MOVED_TO with the same cookie
+    struct PendingMove {
+        fs::path path;
+        bool isDir;
+        std::shared_ptr<AutoscanDirectory> adir;
+        std::chrono::steady_clock::time_point expires;
+    };
+    std::unordered_map<uint32_t, PendingMove> pendingMoves;
+    /// \brief watches of directories that were moved in the database, their IN_MOVE_SELF is no removal
+    std::unordered_set<int> movedWatches;
+
+    /// \brief events of a path combined until it is quiet for a while
+    struct PendingChange {
+        bool isDir;
+        bool remove;
+        bool add;
+        std::shared_ptr<AutoscanDirectory> adir;
+        std::chrono::steady_clock::time_point due;
+    };
+    std::map<fs::path, PendingChange> pendingChanges;
+    /// \brief paths in the order they become due, entries of paths that changed again are outdated
+    std::deque<std::pair<std::chrono::steady_clock::time_point, fs::path>> changeQueue;
+    std::chrono::milliseconds quietPeriod;
+
+    void startMove(uint32_t cookie, const fs::path& path, bool isDir, const std::shared_ptr<AutoscanDirectory>& adir);
+    bool finishMove(uint32_t cookie, const fs::path& path, bool isDir, const std::shared_ptr<AutoscanDirectory>& adir);
+    /// \brief remove objects that were moved out of the watched directories
+    void expireMoves();
+    void renameWatches(const fs::path& oldPath, const fs::path& newPath);
+
+    void queueChange(const fs::path& path, bool isDir, bool remove, bool add, const std::shared_ptr<AutoscanDirectory>& adir);
+    /// \brief hand all quiet paths to the content manager in one go
+    void flushChanges();
+    void renameChanges(const fs::path& oldPath, const fs::path& newPath);
+    bool isImportedWithParent(const fs::path& path, const fs::path& root, const std::unordered_set<std::string>& addedDirs) const;
+    /// \brief milliseconds until the next pending move or change is due
+    int getTimeout() const;
+
     void monitorUnmonitorRecursive(const fs::path& startPath, bool unmonitor, const std::shared_ptr<AutoscanDirectory>& adir, bool startPoint);
-    int monitorDirectory(const fs::path& path, const std::shared_ptr<AutoscanDirectory>& adir, bool startPoint, const std::vector<std::string>* pathArray = nullptr);
+    /// \param descendant watch shared by the directories below a start point, created if nullptr
+    /// \param startPointWd watch descriptor of the start point, looked up if negative
+    int monitorDirectory(const fs::path& path, const std::shared_ptr<AutoscanDirectory>& adir, bool startPoint, const std::vector<std::string>* pathArray = nullptr,
+        const std::shared_ptr<WatchAutoscan>& descendant = nullptr, int startPointWd = INOTIFY_ROOT);
     void unmonitorDirectory(const fs::path& path, const std::shared_ptr<AutoscanDirectory>& adir);
 
     static std::shared_ptr<WatchAutoscan> getAppropriateAutoscan(const std::shared_ptr<Wd>& wdObj, const std::shared_ptr<AutoscanDirectory>& adir);
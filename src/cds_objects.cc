@@ -41,6 +41,7 @@ CdsObject::CdsObject(std::shared_ptr<Database> database)
     : database(std::move(database))
     , mtime(0)
     , sizeOnDisk(0)
+    , inode(0)
 {
     id = INVALID_OBJECT_ID;
     parentID = INVALID_OBJECT_ID;
@@ -60,6 +61,7 @@ void CdsObject::copyTo(const std::shared_ptr<CdsObject>& obj)
     obj->setLocation(location);
     obj->setMTime(mtime);
     obj->setSizeOnDisk(sizeOnDisk);
+    obj->setInode(inode);
     obj->setVirtual(virt);
     obj->setMetadata(metadata);
     obj->setAuxData(auxdata);
@@ -88,6 +90,7 @@ int CdsObject::equals(const std::shared_ptr<CdsObject>& obj, bool exactly)
         && !(location == obj->getLocation()
             && mtime == obj->getMTime()
             && sizeOnDisk == obj->getSizeOnDisk()
+            && inode == obj->getInode()
             && virt == obj->isVirtual()
             && std::equal(auxdata.begin(), auxdata.end(), obj->auxdata.begin())
             && objectFlags == obj->getFlags()))
@@ -36,6 +36,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <utility>
 #include <vector>
@@ -81,6 +82,7 @@ static constexpr bool IS_CDS_PURE_ITEM(unsigned int type) { return type == OBJEC
 #define OBJECT_FLAG_ONLINE_SERVICE 0x00000040u
 #define OBJECT_FLAG_OGG_THEORA 0x00000080u
 #define OBJECT_FLAG_PLAYED 0x00000200u
+#define OBJECT_FLAG_LAYOUT_PENDING 0x00000400u
 
 #define OBJECT_AUTOSCAN_NONE 0u
 #define OBJECT_AUTOSCAN_UI 1u
@@ -116,6 +118,9 @@ protected:
     /// \brief File size on disk (in bytes).
     off_t sizeOnDisk;
 
+    /// \brief Inode of the file, detects replaced files with equal time and size.
+    ino_t inode;
+
     /// \brief virtual object flag
     bool virt;
 
@@ -202,6 +207,29 @@ public:
     /// \brief Retrieve the file size (in bytes).
     off_t getSizeOnDisk() const { return sizeOnDisk; }
 
+    /// \brief Set file inode.
+    void setInode(ino_t inode) { this->inode = inode; }
+
+    /// \brief Retrieve the file inode.
+    ino_t getInode() const { return inode; }
+
+    /// \brief Set modification time, size and inode from the file status.
+    void setFingerprint(const struct stat& statbuf)
+    {
+        mtime = statbuf.st_mtime;
+        sizeOnDisk = statbuf.st_size;
+        inode = statbuf.st_ino;
+    }
+
+    /// \brief Check if the file status differs from the stored one.
+    bool fingerprintChanged(const struct stat& statbuf) const
+    {
+        return mtime != statbuf.st_mtime || sizeOnDisk != statbuf.st_size || inode != statbuf.st_ino;
+    }
+
+    /// \brief Check if a fingerprint was stored, it is missing for items imported by older versions.
+    bool hasFingerprint() const { return mtime > 0; }
+
     /// \brief Set the virtual flag.
     void setVirtual(bool virt) { this->virt = virt; }
 
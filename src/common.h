@@ -231,11 +231,13 @@ static constexpr bool IS_FORBIDDEN_CDS_ID(int id) { return id <= CDS_ID_FS_ROOT;
 #define DEFAULT_IMPORT_SCRIPT "import.js"
 #define DEFAULT_PLAYLISTS_SCRIPT "playlists.js"
 #define DEFAULT_PLAYLIST_CREATE_LINK YES
+#define DEFAULT_PLAYLIST_USE_SCRIPT NO
 #define DEFAULT_COMMON_SCRIPT "common.js"
 #define DEFAULT_WEB_DIR "web"
 #define DEFAULT_JS_DIR "js"
 #define DEFAULT_HIDDEN_FILES_VALUE NO
 #define DEFAULT_FOLLOW_SYMLINKS_VALUE YES
+#define DEFAULT_SCAN_THREADS 4
 #define DEFAULT_RESOURCES_CASE_SENSITIVE YES
 #define DEFAULT_UPNP_STRING_LIMIT (-1)
 #define DEFAULT_SESSION_TIMEOUT 30
@@ -246,6 +248,9 @@ static constexpr bool IS_FORBIDDEN_CDS_ID(int id) { return id <= CDS_ID_FS_ROOT;
 #define DEFAULT_ITEMS_PER_PAGE_3 50
 #define DEFAULT_ITEMS_PER_PAGE_4 100
 #define DEFAULT_LAYOUT_TYPE "builtin"
+#define DEFAULT_LAYOUT_SCRIPT_HEAPS 1
+#define DEFAULT_LAYOUT_DEFERRED NO
+#define DEFAULT_LAYOUT_BATCH_SIZE 500
 #define DEFAULT_HIDE_PC_DIRECTORY NO
 #define DEFAULT_CLIENTS_EN_VALUE NO
 #ifdef SOPCAST
@@ -262,6 +267,10 @@ static constexpr bool IS_FORBIDDEN_CDS_ID(int id) { return id <= CDS_ID_FS_ROOT;
 #define CFG_DEFAULT_UPDATE_AT_START 10 // seconds
 #endif
 #define DEFAULT_TRANSCODING_ENABLED NO
+#define DEFAULT_TRANSCODING_MAX_CONCURRENT 0 // unlimited
+#define DEFAULT_TRANSCODING_MAX_CPU_LOAD 0 // percent, disabled
+#define DEFAULT_TRANSCODING_QUEUE_TIMEOUT 30 // seconds
+#define DEFAULT_TRANSCODING_DEGRADE NO
 #define DEFAULT_AUDIO_BUFFER_SIZE 1048576
 #define DEFAULT_AUDIO_CHUNK_SIZE 131072
 #define DEFAULT_AUDIO_FILL_SIZE 262144
@@ -292,6 +301,7 @@ static constexpr bool IS_FORBIDDEN_CDS_ID(int id) { return id <= CDS_ID_FS_ROOT;
 #define DEFAULT_MYSQL_DB "gerbera"
 #define DEFAULT_MYSQL_USER "gerbera"
 #define DEFAULT_MYSQL_ENABLED NO
+#define DEFAULT_MYSQL_CONNECTIONS 4
 
 #else //HAVE_MYSQL
 #define DEFAULT_MYSQL_ENABLED NO
@@ -321,10 +331,20 @@ static constexpr bool IS_FORBIDDEN_CDS_ID(int id) { return id <= CDS_ID_FS_ROOT;
 #ifdef HAVE_CURL
 #define DEFAULT_CURL_BUFFER_SIZE 262144
 #define DEFAULT_CURL_INITIAL_FILL_SIZE 0
+#define DEFAULT_CURL_MAX_CONNECTIONS 16
 #endif
 
 #define DEFAULT_LIBOPTS_ENTRY_SEPARATOR "; "
 
+#define DEFAULT_AUTOSCAN_SKIP_UNCHANGED NO
+#define DEFAULT_INOTIFY_QUIET_PERIOD 1000 // milliseconds
+
+#if defined(HAVE_TAGLIB) || defined(HAVE_MATROSKA)
+#define DEFAULT_ARTWORK_CACHE_ENABLED YES
+#define DEFAULT_ARTWORK_CACHE_DIR ""
+#define DEFAULT_ARTWORK_CACHE_ENTRIES 10000
+#endif
+
 #if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
 #define DEFAULT_FFMPEGTHUMBNAILER_ENABLED NO
 #define DEFAULT_FFMPEGTHUMBNAILER_THUMBSIZE 128
@@ -334,6 +354,10 @@ static constexpr bool IS_FORBIDDEN_CDS_ID(int id) { return id <= CDS_ID_FS_ROOT;
 #define DEFAULT_FFMPEGTHUMBNAILER_IMAGE_QUALITY 8
 #define DEFAULT_FFMPEGTHUMBNAILER_CACHE_DIR_ENABLED YES
 #define DEFAULT_FFMPEGTHUMBNAILER_CACHE_DIR ""
+#define DEFAULT_FFMPEGTHUMBNAILER_WORKERS 2
+#define DEFAULT_FFMPEGTHUMBNAILER_TIMEOUT 10
+#define DEFAULT_FFMPEGTHUMBNAILER_PREGENERATE NO
+#define DEFAULT_FFMPEGTHUMBNAILER_CACHE_DIR_MAX_SIZE 256
 #endif
 
 #if defined(HAVE_LASTFMLIB)
@@ -89,6 +89,7 @@ typedef enum {
     CFG_SERVER_STORAGE_MYSQL_SOCKET,
     CFG_SERVER_STORAGE_MYSQL_PASSWORD,
     CFG_SERVER_STORAGE_MYSQL_DATABASE,
+    CFG_SERVER_STORAGE_MYSQL_CONNECTIONS,
 #endif
 #if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
     CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED,
@@ -99,6 +100,10 @@ typedef enum {
     CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_IMAGE_QUALITY,
     CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_ENABLED,
     CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR,
+    CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_WORKERS,
+    CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_TIMEOUT,
+    CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE,
+    CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_MAX_SIZE,
 #endif
     CFG_SERVER_EXTOPTS_MARK_PLAYED_ITEMS_ENABLED,
     CFG_SERVER_EXTOPTS_MARK_PLAYED_ITEMS_STRING_MODE_PREPEND,
@@ -112,6 +117,7 @@ typedef enum {
 #endif
     CFG_IMPORT_HIDDEN_FILES,
     CFG_IMPORT_FOLLOW_SYMLINKS,
+    CFG_IMPORT_SCAN_THREADS,
     CFG_IMPORT_FILESYSTEM_CHARSET,
     CFG_IMPORT_METADATA_CHARSET,
     CFG_IMPORT_PLAYLIST_CHARSET,
@@ -119,15 +125,22 @@ typedef enum {
     CFG_IMPORT_SCRIPTING_CHARSET,
     CFG_IMPORT_SCRIPTING_COMMON_SCRIPT,
     CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT,
-    CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_LINK_OBJECTS,
+    CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_USE,
     CFG_IMPORT_SCRIPTING_IMPORT_SCRIPT,
+    CFG_IMPORT_SCRIPTING_IMPORT_SCRIPT_HEAPS,
 #endif // JS
+    CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_LINK_OBJECTS,
     CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_TYPE,
+    CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_AUDIO,
+    CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_DEFERRED,
+    CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_BATCH_SIZE,
 #ifdef HAVE_MAGIC
     CFG_IMPORT_MAGIC_FILE,
 #endif
     CFG_IMPORT_AUTOSCAN_TIMED_LIST,
     CFG_IMPORT_AUTOSCAN_USE_INOTIFY,
+    CFG_IMPORT_AUTOSCAN_SKIP_UNCHANGED,
+    CFG_IMPORT_AUTOSCAN_INOTIFY_QUIET_PERIOD,
 #ifdef HAVE_INOTIFY
     CFG_IMPORT_AUTOSCAN_INOTIFY_LIST,
 #endif
@@ -144,12 +157,24 @@ typedef enum {
 #endif
 #if defined(HAVE_TAGLIB)
     CFG_IMPORT_LIBOPTS_ID3_AUXDATA_TAGS_LIST,
+#endif
+#if defined(HAVE_TAGLIB) || defined(HAVE_MATROSKA)
+    CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_ENABLED,
+    CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_DIR,
+    CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_ENTRIES,
 #endif
     CFG_TRANSCODING_TRANSCODING_ENABLED,
     CFG_TRANSCODING_PROFILE_LIST,
+    CFG_TRANSCODING_MAX_CONCURRENT,
+    CFG_TRANSCODING_MAX_CPU_LOAD,
+    CFG_TRANSCODING_QUEUE_TIMEOUT,
+    CFG_TRANSCODING_DEGRADE,
 #ifdef HAVE_CURL
     CFG_EXTERNAL_TRANSCODING_CURL_BUFFER_SIZE,
     CFG_EXTERNAL_TRANSCODING_CURL_FILL_SIZE,
+    CFG_ONLINE_CONTENT_FETCH_BUFFER_SIZE,
+    CFG_ONLINE_CONTENT_FETCH_BUFFER_FILL_SIZE,
+    CFG_ONLINE_CONTENT_FETCH_MAX_CONNECTIONS,
 #endif //HAVE_CURL
 #ifdef SOPCAST
     CFG_ONLINE_CONTENT_SOPCAST_ENABLED,
@@ -198,6 +223,9 @@ typedef enum {
     ATTR_IMPORT_LAYOUT_MAPPING_PATH,
     ATTR_IMPORT_LAYOUT_MAPPING_FROM,
     ATTR_IMPORT_LAYOUT_MAPPING_TO,
+    ATTR_IMPORT_LAYOUT_AUDIO_CONTAINER,
+    ATTR_IMPORT_LAYOUT_AUDIO_PATH,
+    ATTR_IMPORT_LAYOUT_AUDIO_TITLE,
     ATTR_IMPORT_RESOURCES_ADD_FILE,
     ATTR_IMPORT_RESOURCES_NAME,
     ATTR_IMPORT_LIBOPTS_AUXDATA_DATA,
@@ -231,6 +259,9 @@ typedef enum {
     ATTR_TRANSCODING_PROFILES_PROFLE_BUFFER_SIZE,
     ATTR_TRANSCODING_PROFILES_PROFLE_BUFFER_CHUNK,
     ATTR_TRANSCODING_PROFILES_PROFLE_BUFFER_FILL,
+    ATTR_TRANSCODING_PROFILES_PROFLE_MAX_CONCURRENT,
+    ATTR_TRANSCODING_PROFILES_PROFLE_PRIORITY,
+    ATTR_TRANSCODING_PROFILES_PROFLE_FALLBACK,
     ATTR_AUTOSCAN_DIRECTORY,
     ATTR_AUTOSCAN_DIRECTORY_LOCATION,
     ATTR_AUTOSCAN_DIRECTORY_MODE,
@@ -287,6 +318,10 @@ public:
     /// \param option option to retrieve.
     virtual std::map<std::string, std::string> getDictionaryOption(config_option_t option) const = 0;
 
+    /// \brief returns a config option of type dictionary in the order of the config file
+    /// \param option option to retrieve.
+    virtual std::vector<std::pair<std::string, std::string>> getOrderedDictionaryOption(config_option_t option) const = 0;
+
     /// \brief returns a config option of type array of string
     /// \param option option to retrieve.
     virtual std::vector<std::string> getArrayOption(config_option_t option) const = 0;
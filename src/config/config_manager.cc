@@ -199,6 +199,9 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
     std::make_shared<ConfigStringSetup>(CFG_SERVER_STORAGE_MYSQL_DATABASE,
         "/server/storage/mysql/database", "config-server.html#storage",
         DEFAULT_MYSQL_DB),
+    std::make_shared<ConfigIntSetup>(CFG_SERVER_STORAGE_MYSQL_CONNECTIONS,
+        "/server/storage/mysql/connections", "config-server.html#storage",
+        DEFAULT_MYSQL_CONNECTIONS, 1, ConfigIntSetup::CheckMinValue),
 #else
     std::make_shared<ConfigBoolSetup>(CFG_SERVER_STORAGE_MYSQL_ENABLED,
         "/server/storage/mysql/attribute::enabled", "config-server.html#storage",
@@ -282,6 +285,9 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
     std::make_shared<ConfigBoolSetup>(CFG_IMPORT_FOLLOW_SYMLINKS,
         "/import/attribute::follow-symlinks", "config-import.html#import",
         DEFAULT_FOLLOW_SYMLINKS_VALUE),
+    std::make_shared<ConfigIntSetup>(CFG_IMPORT_SCAN_THREADS,
+        "/import/attribute::scan-threads", "config-import.html#import",
+        DEFAULT_SCAN_THREADS, 1, ConfigIntSetup::CheckMinValue),
     std::make_shared<ConfigDictionarySetup>(CFG_IMPORT_MAPPINGS_EXTENSION_TO_MIMETYPE_LIST,
         "/import/mappings/extension-mimetype", "config-import.html#extension-mimetype",
         ATTR_IMPORT_MAPPINGS_MIMETYPE_MAP, ATTR_IMPORT_MAPPINGS_MIMETYPE_FROM, ATTR_IMPORT_MAPPINGS_MIMETYPE_TO),
@@ -313,12 +319,18 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
     std::make_shared<ConfigPathSetup>(CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT,
         "/import/scripting/playlist-script", "config-import.html#playlist-script",
         "", true),
-    std::make_shared<ConfigBoolSetup>(CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_LINK_OBJECTS,
-        "/import/scripting/playlist-script/attribute::create-link", "config-import.html#playlist-script",
-        DEFAULT_PLAYLIST_CREATE_LINK),
+    std::make_shared<ConfigBoolSetup>(CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_USE,
+        "/import/scripting/playlist-script/attribute::use-script", "config-import.html#playlist-script",
+        DEFAULT_PLAYLIST_USE_SCRIPT),
     std::make_shared<ConfigStringSetup>(CFG_IMPORT_SCRIPTING_IMPORT_SCRIPT,
         "/import/scripting/virtual-layout/import-script", "config-import.html#scripting"),
+    std::make_shared<ConfigIntSetup>(CFG_IMPORT_SCRIPTING_IMPORT_SCRIPT_HEAPS,
+        "/import/scripting/virtual-layout/attribute::script-heaps", "config-import.html#scripting",
+        DEFAULT_LAYOUT_SCRIPT_HEAPS, 1, ConfigIntSetup::CheckMinValue),
 #endif // JS
+    std::make_shared<ConfigBoolSetup>(CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_LINK_OBJECTS,
+        "/import/scripting/playlist-script/attribute::create-link", "config-import.html#playlist-script",
+        DEFAULT_PLAYLIST_CREATE_LINK),
     std::make_shared<ConfigStringSetup>(CFG_IMPORT_FILESYSTEM_CHARSET,
         "/import/filesystem-charset", "config-import.html#filesystem-charset",
         DEFAULT_FILESYSTEM_CHARSET),
@@ -331,13 +343,34 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
     std::make_shared<ConfigEnumSetup<std::string>>(CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_TYPE,
         "/import/scripting/virtual-layout/attribute::type", "config-import.html#scripting",
         DEFAULT_LAYOUT_TYPE,
-        std::map<std::string, std::string>({ { "js", "js" }, { "builtin", "builtin" }, { "disabled", "disabled" } })),
+        std::map<std::string, std::string>({ { "js", "js" }, { "builtin", "builtin" }, { "template", "template" }, { "disabled", "disabled" } })),
+    std::make_shared<ConfigDictionarySetup>(CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_AUDIO,
+        "/import/scripting/virtual-layout/audio-layout", "config-import.html#scripting",
+        ATTR_IMPORT_LAYOUT_AUDIO_CONTAINER, ATTR_IMPORT_LAYOUT_AUDIO_PATH, ATTR_IMPORT_LAYOUT_AUDIO_TITLE),
+    std::make_shared<ConfigBoolSetup>(CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_DEFERRED,
+        "/import/scripting/virtual-layout/attribute::deferred", "config-import.html#scripting",
+        DEFAULT_LAYOUT_DEFERRED),
+    std::make_shared<ConfigIntSetup>(CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_BATCH_SIZE,
+        "/import/scripting/virtual-layout/attribute::batch-size", "config-import.html#scripting",
+        DEFAULT_LAYOUT_BATCH_SIZE, 1, ConfigIntSetup::CheckMinValue),
 
     std::make_shared<ConfigBoolSetup>(CFG_TRANSCODING_TRANSCODING_ENABLED,
         "/transcoding/attribute::enabled", "config-transcode.html#transcoding",
         DEFAULT_TRANSCODING_ENABLED),
     std::make_shared<ConfigTranscodingSetup>(CFG_TRANSCODING_PROFILE_LIST,
         "/transcoding", "config-transcode.html#transcoding"),
+    std::make_shared<ConfigIntSetup>(CFG_TRANSCODING_MAX_CONCURRENT,
+        "/transcoding/attribute::max-concurrent", "config-transcode.html#transcoding",
+        DEFAULT_TRANSCODING_MAX_CONCURRENT, 0, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigIntSetup>(CFG_TRANSCODING_MAX_CPU_LOAD,
+        "/transcoding/attribute::max-cpu-load", "config-transcode.html#transcoding",
+        DEFAULT_TRANSCODING_MAX_CPU_LOAD, 0, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigIntSetup>(CFG_TRANSCODING_QUEUE_TIMEOUT,
+        "/transcoding/attribute::queue-timeout", "config-transcode.html#transcoding",
+        DEFAULT_TRANSCODING_QUEUE_TIMEOUT, 0, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigBoolSetup>(CFG_TRANSCODING_DEGRADE,
+        "/transcoding/attribute::degrade", "config-transcode.html#transcoding",
+        DEFAULT_TRANSCODING_DEGRADE),
 
     std::make_shared<ConfigStringSetup>(CFG_IMPORT_LIBOPTS_ENTRY_SEP,
         "/import/library-options/attribute::multi-value-separator", "config-import.html#library-options",
@@ -383,6 +416,18 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
     std::make_shared<ConfigStringSetup>(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR, // ConfigPathSetup
         "/server/extended-runtime-options/ffmpegthumbnailer/cache-dir", "config-extended.html#ffmpegthumbnailer",
         DEFAULT_FFMPEGTHUMBNAILER_CACHE_DIR),
+    std::make_shared<ConfigIntSetup>(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_WORKERS,
+        "/server/extended-runtime-options/ffmpegthumbnailer/attribute::workers", "config-extended.html#ffmpegthumbnailer",
+        DEFAULT_FFMPEGTHUMBNAILER_WORKERS, 1, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigIntSetup>(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_TIMEOUT,
+        "/server/extended-runtime-options/ffmpegthumbnailer/attribute::timeout", "config-extended.html#ffmpegthumbnailer",
+        DEFAULT_FFMPEGTHUMBNAILER_TIMEOUT, 0, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigBoolSetup>(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE,
+        "/server/extended-runtime-options/ffmpegthumbnailer/attribute::pregenerate", "config-extended.html#ffmpegthumbnailer",
+        DEFAULT_FFMPEGTHUMBNAILER_PREGENERATE),
+    std::make_shared<ConfigIntSetup>(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_MAX_SIZE,
+        "/server/extended-runtime-options/ffmpegthumbnailer/cache-dir/attribute::max-size", "config-extended.html#ffmpegthumbnailer",
+        DEFAULT_FFMPEGTHUMBNAILER_CACHE_DIR_MAX_SIZE, 0, ConfigIntSetup::CheckMinValue),
 #endif
     std::make_shared<ConfigBoolSetup>(CFG_SERVER_EXTOPTS_MARK_PLAYED_ITEMS_ENABLED,
         "/server/extended-runtime-options/mark-played-items/attribute::enabled", "config-extended.html#extended-runtime-options",
@@ -446,6 +491,12 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
     std::make_shared<ConfigBoolSetup>(CFG_IMPORT_AUTOSCAN_USE_INOTIFY,
         "/import/autoscan/attribute::use-inotify", "config-import.html#autoscan",
         "auto", ConfigBoolSetup::CheckInotifyValue),
+    std::make_shared<ConfigBoolSetup>(CFG_IMPORT_AUTOSCAN_SKIP_UNCHANGED,
+        "/import/autoscan/attribute::skip-unchanged", "config-import.html#autoscan",
+        DEFAULT_AUTOSCAN_SKIP_UNCHANGED),
+    std::make_shared<ConfigIntSetup>(CFG_IMPORT_AUTOSCAN_INOTIFY_QUIET_PERIOD,
+        "/import/autoscan/attribute::inotify-quiet-period", "config-import.html#autoscan",
+        DEFAULT_INOTIFY_QUIET_PERIOD, 0, ConfigIntSetup::CheckMinValue),
 #ifdef HAVE_INOTIFY
     std::make_shared<ConfigAutoscanSetup>(CFG_IMPORT_AUTOSCAN_INOTIFY_LIST,
         "/import/autoscan", "config-import.html#autoscan",
@@ -458,6 +509,15 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
     std::make_shared<ConfigIntSetup>(CFG_EXTERNAL_TRANSCODING_CURL_FILL_SIZE,
         "/transcoding/attribute::fetch-buffer-fill-size", "config-transcode.html#transcoding",
         DEFAULT_CURL_INITIAL_FILL_SIZE, 0, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigIntSetup>(CFG_ONLINE_CONTENT_FETCH_BUFFER_SIZE,
+        "/import/online-content/attribute::fetch-buffer-size", "config-online.html#online-content",
+        DEFAULT_CURL_BUFFER_SIZE, CURL_MAX_WRITE_SIZE, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigIntSetup>(CFG_ONLINE_CONTENT_FETCH_BUFFER_FILL_SIZE,
+        "/import/online-content/attribute::fetch-buffer-fill-size", "config-online.html#online-content",
+        DEFAULT_CURL_INITIAL_FILL_SIZE, 0, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigIntSetup>(CFG_ONLINE_CONTENT_FETCH_MAX_CONNECTIONS,
+        "/import/online-content/attribute::fetch-max-connections", "config-online.html#online-content",
+        DEFAULT_CURL_MAX_CONNECTIONS, 1, ConfigIntSetup::CheckMinValue),
 #endif //HAVE_CURL
 #ifdef HAVE_LIBEXIF
     std::make_shared<ConfigArraySetup>(CFG_IMPORT_LIBOPTS_EXIF_AUXDATA_TAGS_LIST,
@@ -474,6 +534,17 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
         "/import/library-options/id3/auxdata", "config-import.html#id2",
         ATTR_IMPORT_LIBOPTS_AUXDATA_DATA, ATTR_IMPORT_LIBOPTS_AUXDATA_TAG),
 #endif
+#if defined(HAVE_TAGLIB) || defined(HAVE_MATROSKA)
+    std::make_shared<ConfigBoolSetup>(CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_ENABLED,
+        "/import/library-options/artwork-cache/attribute::enabled", "config-import.html#artwork-cache",
+        DEFAULT_ARTWORK_CACHE_ENABLED),
+    std::make_shared<ConfigStringSetup>(CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_DIR, // ConfigPathSetup
+        "/import/library-options/artwork-cache", "config-import.html#artwork-cache",
+        DEFAULT_ARTWORK_CACHE_DIR),
+    std::make_shared<ConfigIntSetup>(CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_ENTRIES,
+        "/import/library-options/artwork-cache/attribute::max-entries", "config-import.html#artwork-cache",
+        DEFAULT_ARTWORK_CACHE_ENTRIES, 1, ConfigIntSetup::CheckMinValue),
+#endif
 #ifdef HAVE_FFMPEG
     std::make_shared<ConfigArraySetup>(CFG_IMPORT_LIBOPTS_FFMPEG_AUXDATA_TAGS_LIST,
         "/import/library-options/ffmpeg/auxdata", "config-import.html#id5",
@@ -540,6 +611,15 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
     std::make_shared<ConfigIntSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_BUFFER_FILL,
         "fill-size", "config-transcode.html#profiles",
         0, 0, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigIntSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_MAX_CONCURRENT,
+        "max-concurrent", "config-transcode.html#profiles",
+        0, 0, ConfigIntSetup::CheckMinValue),
+    std::make_shared<ConfigIntSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_PRIORITY,
+        "priority", "config-transcode.html#profiles",
+        0),
+    std::make_shared<ConfigStringSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_FALLBACK,
+        "fallback", "config-transcode.html#profiles",
+        false),
     std::make_shared<ConfigIntSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_SAMPFREQ,
         "sample-frequency", "config-transcode.html#profiles",
         "-1", ConfigIntSetup::CheckProfileNumberValue),
@@ -629,6 +709,12 @@ std::vector<std::shared_ptr<ConfigSetup>> ConfigManager::complexOptions = {
     std::make_shared<ConfigStringSetup>(ATTR_IMPORT_LAYOUT_MAPPING_TO,
         "to", "config-import.html#layout",
         ""),
+    std::make_shared<ConfigStringSetup>(ATTR_IMPORT_LAYOUT_AUDIO_PATH,
+        "path", "config-import.html#scripting",
+        ""),
+    std::make_shared<ConfigStringSetup>(ATTR_IMPORT_LAYOUT_AUDIO_TITLE,
+        "title", "config-import.html#scripting",
+        ""),
 
     std::make_shared<ConfigStringSetup>(ATTR_IMPORT_LIBOPTS_AUXDATA_TAG,
         "tag", "config-import.html#auxdata",
@@ -685,9 +771,11 @@ std::map<config_option_t, std::vector<config_option_t>> ConfigManager::parentOpt
 
     { ATTR_IMPORT_LAYOUT_MAPPING_FROM, { CFG_IMPORT_LAYOUT_MAPPING } },
     { ATTR_IMPORT_LAYOUT_MAPPING_TO, { CFG_IMPORT_LAYOUT_MAPPING } },
+    { ATTR_IMPORT_LAYOUT_AUDIO_PATH, { CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_AUDIO } },
+    { ATTR_IMPORT_LAYOUT_AUDIO_TITLE, { CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_AUDIO } },
 };
 
-constexpr std::array<std::pair<config_option_t, const char*>, 16> ConfigManager::simpleOptions { {
+constexpr std::array<std::pair<config_option_t, const char*>, 17> ConfigManager::simpleOptions { {
     { CFG_MAX, "max_option" },
 
     { ATTR_SERVER_UI_ITEMS_PER_PAGE_DROPDOWN_OPTION, "option" },
@@ -700,6 +788,7 @@ constexpr std::array<std::pair<config_option_t, const char*>, 16> ConfigManager:
     { ATTR_TRANSCODING_MIMETYPE_PROF_MAP_TRANSCODE, "transcode" },
     { ATTR_TRANSCODING_MIMETYPE_PROF_MAP_USING, "using" },
     { ATTR_IMPORT_LAYOUT_MAPPING_PATH, "path" },
+    { ATTR_IMPORT_LAYOUT_AUDIO_CONTAINER, "container" },
     { ATTR_TRANSCODING_PROFILES, "profiles" },
     { ATTR_TRANSCODING_PROFILES_PROFLE, "profile" },
     { ATTR_TRANSCODING_PROFILES_PROFLE_AVI4CC_4CC, "fourcc" },
@@ -875,6 +964,7 @@ void ConfigManager::load(const fs::path& userHome)
         setOption(root, CFG_SERVER_STORAGE_MYSQL_PORT);
         setOption(root, CFG_SERVER_STORAGE_MYSQL_SOCKET);
         setOption(root, CFG_SERVER_STORAGE_MYSQL_PASSWORD);
+        setOption(root, CFG_SERVER_STORAGE_MYSQL_CONNECTIONS);
     }
 #else
     if (mysql_en) {
@@ -927,6 +1017,7 @@ void ConfigManager::load(const fs::path& userHome)
 
     setOption(root, CFG_IMPORT_HIDDEN_FILES);
     setOption(root, CFG_IMPORT_FOLLOW_SYMLINKS);
+    setOption(root, CFG_IMPORT_SCAN_THREADS);
     setOption(root, CFG_IMPORT_MAPPINGS_IGNORE_UNKNOWN_EXTENSIONS);
     bool csens = setOption(root, CFG_IMPORT_MAPPINGS_EXTENSION_TO_MIMETYPE_CASE_SENSITIVE)->getBoolOption();
     args["tolower"] = std::to_string(!csens);
@@ -1039,10 +1130,14 @@ void ConfigManager::load(const fs::path& userHome)
     co->setDefaultValue(prefix_dir / DEFAULT_JS_DIR / DEFAULT_COMMON_SCRIPT);
     co->makeOption(root, self);
 
-    setOption(root, CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_LINK_OBJECTS);
+    setOption(root, CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_USE);
 #endif
+    setOption(root, CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_LINK_OBJECTS);
 
     auto layoutType = setOption(root, CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_TYPE)->getOption();
+    setOption(root, CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_AUDIO);
+    setOption(root, CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_DEFERRED);
+    setOption(root, CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_BATCH_SIZE);
 
 #ifndef HAVE_JS
     if (layoutType == "js")
@@ -1068,6 +1163,7 @@ void ConfigManager::load(const fs::path& userHome)
     co->makeOption(root, self, &args);
     args.clear();
     auto script_path = co->getValue()->getOption();
+    setOption(root, CFG_IMPORT_SCRIPTING_IMPORT_SCRIPT_HEAPS);
 
 #endif
     co = findConfigSetup(CFG_SERVER_PORT);
@@ -1078,6 +1174,8 @@ void ConfigManager::load(const fs::path& userHome)
     setOption(root, CFG_IMPORT_MAPPINGS_MIMETYPE_TO_UPNP_CLASS_LIST);
 
     auto useInotify = setOption(root, CFG_IMPORT_AUTOSCAN_USE_INOTIFY)->getBoolOption();
+    setOption(root, CFG_IMPORT_AUTOSCAN_SKIP_UNCHANGED);
+    setOption(root, CFG_IMPORT_AUTOSCAN_INOTIFY_QUIET_PERIOD);
 
     args["hiddenFiles"] = getBoolOption(CFG_IMPORT_HIDDEN_FILES) ? "true" : "false";
     setOption(root, CFG_IMPORT_AUTOSCAN_TIMED_LIST, &args);
@@ -1092,6 +1190,10 @@ void ConfigManager::load(const fs::path& userHome)
     auto tr_en = setOption(root, CFG_TRANSCODING_TRANSCODING_ENABLED)->getBoolOption();
     setOption(root, CFG_TRANSCODING_MIMETYPE_PROF_MAP_ALLOW_UNUSED);
     setOption(root, CFG_TRANSCODING_PROFILES_PROFILE_ALLOW_UNUSED);
+    setOption(root, CFG_TRANSCODING_MAX_CONCURRENT);
+    setOption(root, CFG_TRANSCODING_MAX_CPU_LOAD);
+    setOption(root, CFG_TRANSCODING_QUEUE_TIMEOUT);
+    setOption(root, CFG_TRANSCODING_DEGRADE);
     args["isEnabled"] = tr_en ? "true" : "false";
     setOption(root, CFG_TRANSCODING_PROFILE_LIST, &args);
     args.clear();
@@ -1101,6 +1203,9 @@ void ConfigManager::load(const fs::path& userHome)
         setOption(root, CFG_EXTERNAL_TRANSCODING_CURL_BUFFER_SIZE);
         setOption(root, CFG_EXTERNAL_TRANSCODING_CURL_FILL_SIZE);
     }
+    setOption(root, CFG_ONLINE_CONTENT_FETCH_BUFFER_SIZE);
+    setOption(root, CFG_ONLINE_CONTENT_FETCH_BUFFER_FILL_SIZE);
+    setOption(root, CFG_ONLINE_CONTENT_FETCH_MAX_CONNECTIONS);
 #endif //HAVE_CURL
 
     setOption(root, CFG_IMPORT_RESOURCES_CASE_SENSITIVE);
@@ -1126,6 +1231,12 @@ void ConfigManager::load(const fs::path& userHome)
     setOption(root, CFG_IMPORT_LIBOPTS_ID3_AUXDATA_TAGS_LIST);
 #endif
 
+#if defined(HAVE_TAGLIB) || defined(HAVE_MATROSKA)
+    setOption(root, CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_ENABLED);
+    setOption(root, CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_DIR);
+    setOption(root, CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_ENTRIES);
+#endif
+
 #ifdef HAVE_FFMPEG
     setOption(root, CFG_IMPORT_LIBOPTS_FFMPEG_AUXDATA_TAGS_LIST);
 #endif
@@ -1140,6 +1251,10 @@ void ConfigManager::load(const fs::path& userHome)
         setOption(root, CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_IMAGE_QUALITY);
         setOption(root, CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_ENABLED);
         setOption(root, CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR);
+        setOption(root, CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_WORKERS);
+        setOption(root, CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_TIMEOUT);
+        setOption(root, CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE);
+        setOption(root, CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_MAX_SIZE);
     }
 #endif
 
@@ -1335,6 +1450,11 @@ std::map<std::string, std::string> ConfigManager::getDictionaryOption(config_opt
     return options->at(option)->getDictionaryOption();
 }
 
+std::vector<std::pair<std::string, std::string>> ConfigManager::getOrderedDictionaryOption(config_option_t option) const
+{
+    return options->at(option)->getOrderedDictionaryOption();
+}
+
 std::vector<std::string> ConfigManager::getArrayOption(config_option_t option) const
 {
     return options->at(option)->getArrayOption();
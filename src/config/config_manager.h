@@ -102,6 +102,10 @@ public:
     /// \param option option to retrieve.
     std::map<std::string, std::string> getDictionaryOption(config_option_t option) const override;
 
+    /// \brief returns a config option of type dictionary in the order of the config file
+    /// \param option option to retrieve.
+    std::vector<std::pair<std::string, std::string>> getOrderedDictionaryOption(config_option_t option) const override;
+
     /// \brief returns a config option of type array of string
     /// \param option option to retrieve.
     std::vector<std::string> getArrayOption(config_option_t option) const override;
@@ -140,7 +144,7 @@ public:
 
 protected:
     static std::vector<std::shared_ptr<ConfigSetup>> complexOptions;
-    static const std::array<std::pair<config_option_t, const char*>, 16> simpleOptions;
+    static const std::array<std::pair<config_option_t, const char*>, 17> simpleOptions;
     static std::map<config_option_t, std::vector<config_option_t>> parentOptions;
 
     fs::path filename;
@@ -54,6 +54,22 @@ std::map<std::string, std::string> DictionaryOption::getDictionaryOption(bool fo
     return editOption;
 }
 
+std::vector<std::pair<std::string, std::string>> DictionaryOption::getOrderedDictionaryOption() const
+{
+    std::vector<std::pair<std::string, std::string>> result;
+    result.reserve(option.size());
+    for (const auto& key : order) {
+        auto entry = option.find(key);
+        if (entry != option.end())
+            result.emplace_back(*entry);
+    }
+    for (const auto& entry : option) {
+        if (std::find(order.begin(), order.end(), entry.first) == order.end())
+            result.emplace_back(entry);
+    }
+    return result;
+}
+
 void DictionaryOption::setKey(size_t keyIndex, const std::string& newKey)
 {
     if (!indexMap[keyIndex].empty()) {
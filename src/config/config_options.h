@@ -67,6 +67,11 @@ public:
         throw std::runtime_error("Wrong option type dictionary");
     }
 
+    virtual std::vector<std::pair<std::string, std::string>> getOrderedDictionaryOption() const
+    {
+        throw std::runtime_error("Wrong option type dictionary");
+    }
+
     virtual std::shared_ptr<AutoscanList> getAutoscanListOption() const
     {
         throw std::runtime_error("Wrong option type autoscan list");
@@ -128,8 +133,10 @@ protected:
 
 class DictionaryOption : public ConfigOption {
 public:
-    explicit DictionaryOption(std::map<std::string, std::string> option)
+    /// \param order keys in the order of the config file, key order if empty
+    explicit DictionaryOption(std::map<std::string, std::string> option, const std::vector<std::string>& order = {})
         : option(std::move(option))
+        , order(order)
     {
         this->origSize = this->option.size();
         size_t i = 0;
@@ -141,6 +148,9 @@ public:
 
     std::map<std::string, std::string> getDictionaryOption(bool forEdit = false) const override;
 
+    /// \brief entries in the order of the config file, entries added later follow in key order
+    std::vector<std::pair<std::string, std::string>> getOrderedDictionaryOption() const override;
+
     std::string getKey(size_t index)
     {
         return indexMap[index];
@@ -154,6 +164,7 @@ public:
 
 protected:
     std::map<std::string, std::string> option;
+    std::vector<std::string> order;
     size_t origSize;
     std::map<size_t, std::string> indexMap;
 };
@@ -686,7 +686,7 @@ bool ConfigArraySetup::InitItemsPerPage(const pugi::xml_node& value, std::vector
 ///
 /// This function will create a dictionary with the following
 /// key:value paris: "1":"2", "3":"4"
-bool ConfigDictionarySetup::createDictionaryFromNode(const pugi::xml_node& optValue, std::map<std::string, std::string>& result) const
+bool ConfigDictionarySetup::createDictionaryFromNode(const pugi::xml_node& optValue, std::map<std::string, std::string>& result, std::vector<std::string>* order) const
 {
     if (optValue != nullptr) {
         for (const pugi::xml_node& child : optValue.children()) {
@@ -697,6 +697,8 @@ bool ConfigDictionarySetup::createDictionaryFromNode(const pugi::xml_node& optVa
                     if (tolower) {
                         key = toLower(key);
                     }
+                    if (order != nullptr && result.find(key) == result.end())
+                        order->push_back(key);
                     result[key] = value;
                 } else if (itemNotEmpty) {
                     return false;
@@ -731,7 +733,9 @@ void ConfigDictionarySetup::makeOption(const pugi::xml_node& root, const std::sh
     if (arguments != nullptr && arguments->find("tolower") != arguments->end()) {
         tolower = arguments->find("tolower")->second == "true";
     }
-    newOption(getXmlContent(getXmlElement(root)));
+    std::vector<std::string> order;
+    auto dict = getXmlContent(getXmlElement(root), &order);
+    newOption(dict, order);
     setOption(config);
 }
 
@@ -797,7 +801,7 @@ bool ConfigDictionarySetup::updateDetail(const std::string& optItem, std::string
     return false;
 }
 
-std::map<std::string, std::string> ConfigDictionarySetup::getXmlContent(const pugi::xml_node& optValue) const
+std::map<std::string, std::string> ConfigDictionarySetup::getXmlContent(const pugi::xml_node& optValue, std::vector<std::string>* order) const
 {
     std::map<std::string, std::string> result;
     if (initDict != nullptr) {
@@ -805,7 +809,7 @@ std::map<std::string, std::string> ConfigDictionarySetup::getXmlContent(const pu
             throw std::runtime_error(fmt::format("Init {} dictionary failed '{}'", xpath, optValue));
         }
     } else {
-        if (!createDictionaryFromNode(optValue, result)) {
+        if (!createDictionaryFromNode(optValue, result, order)) {
             throw std::runtime_error(fmt::format("Init {} dictionary failed '{}'", xpath, optValue));
         }
     }
@@ -815,9 +819,9 @@ std::map<std::string, std::string> ConfigDictionarySetup::getXmlContent(const pu
     return result;
 }
 
-std::shared_ptr<ConfigOption> ConfigDictionarySetup::newOption(const std::map<std::string, std::string>& optValue)
+std::shared_ptr<ConfigOption> ConfigDictionarySetup::newOption(const std::map<std::string, std::string>& optValue, const std::vector<std::string>& order)
 {
-    optionValue = std::make_shared<DictionaryOption>(optValue);
+    optionValue = std::make_shared<DictionaryOption>(optValue, order);
     return optionValue;
 }
 
@@ -1080,6 +1084,21 @@ bool ConfigTranscodingSetup::createTranscodingProfileListFromNode(const pugi::xm
             if (cs->hasXmlElement(child))
                 prof->setTheora(cs->getXmlContent(child));
         }
+        {
+            auto cs = findConfigSetup<ConfigIntSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_MAX_CONCURRENT);
+            if (cs->hasXmlElement(child))
+                prof->setMaxConcurrent(cs->getXmlContent(child));
+        }
+        {
+            auto cs = findConfigSetup<ConfigIntSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_PRIORITY);
+            if (cs->hasXmlElement(child))
+                prof->setPriority(cs->getXmlContent(child));
+        }
+        {
+            auto cs = findConfigSetup<ConfigStringSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_FALLBACK);
+            if (cs->hasXmlElement(child))
+                prof->setFallback(cs->getXmlContent(child));
+        }
 
         sub = findConfigSetup<ConfigSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_AGENT)->getXmlElement(child);
         prof->setCommand(findConfigSetup<ConfigStringSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_AGENT_COMMAND)->getXmlContent(sub));
@@ -1272,6 +1291,29 @@ bool ConfigTranscodingSetup::updateDetail(const std::string& optItem, std::strin
                 log_debug("New Transcoding Detail {} {}", index, config->getTranscodingProfileListOption(option)->getByName(entry->getName(), true)->getChunked());
                 return true;
             }
+            index = getItemPath(i, ATTR_TRANSCODING_PROFILES, ATTR_TRANSCODING_PROFILES_PROFLE, ATTR_TRANSCODING_PROFILES_PROFLE_MAX_CONCURRENT);
+            if (optItem == index) {
+                config->setOrigValue(index, entry->getMaxConcurrent());
+                entry->setMaxConcurrent(findConfigSetup<ConfigIntSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_MAX_CONCURRENT)->checkIntValue(optValue));
+                log_debug("New Transcoding Detail {} {}", index, config->getTranscodingProfileListOption(option)->getByName(entry->getName(), true)->getMaxConcurrent());
+                return true;
+            }
+            index = getItemPath(i, ATTR_TRANSCODING_PROFILES, ATTR_TRANSCODING_PROFILES_PROFLE, ATTR_TRANSCODING_PROFILES_PROFLE_PRIORITY);
+            if (optItem == index) {
+                config->setOrigValue(index, entry->getPriority());
+                entry->setPriority(findConfigSetup<ConfigIntSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_PRIORITY)->checkIntValue(optValue));
+                log_debug("New Transcoding Detail {} {}", index, config->getTranscodingProfileListOption(option)->getByName(entry->getName(), true)->getPriority());
+                return true;
+            }
+            index = getItemPath(i, ATTR_TRANSCODING_PROFILES, ATTR_TRANSCODING_PROFILES_PROFLE, ATTR_TRANSCODING_PROFILES_PROFLE_FALLBACK);
+            if (optItem == index) {
+                if (findConfigSetup<ConfigStringSetup>(ATTR_TRANSCODING_PROFILES_PROFLE_FALLBACK)->checkValue(optValue)) {
+                    config->setOrigValue(index, entry->getFallback());
+                    entry->setFallback(optValue);
+                    log_debug("New Transcoding Detail {} {}", index, config->getTranscodingProfileListOption(option)->getByName(entry->getName(), true)->getFallback());
+                    return true;
+                }
+            }
 
             size_t buffer = entry->getBufferSize();
             size_t chunk = entry->getBufferChunkSize();
@@ -523,7 +523,7 @@ protected:
     ///
     /// This function will create a dictionary with the following
     /// key:value paris: "1":"2", "3":"4"
-    bool createDictionaryFromNode(const pugi::xml_node& optValue, std::map<std::string, std::string>& result) const;
+    bool createDictionaryFromNode(const pugi::xml_node& optValue, std::map<std::string, std::string>& result, std::vector<std::string>* order = nullptr) const;
 
     bool updateItem(size_t i, const std::string& optItem, const std::shared_ptr<Config>& config, const std::shared_ptr<DictionaryOption>& value, const std::string& optKey, const std::string& optValue, const std::string& status = "") const;
 
@@ -561,9 +561,9 @@ public:
         return index >= 0 ? fmt::format("{}/{}[{}]/attribute::{}", xpath, ConfigManager::mapConfigOption(nodeOption), index, ConfigManager::mapConfigOption(propOption)) : fmt::format("{}/{}", xpath, ConfigManager::mapConfigOption(nodeOption));
     }
 
-    std::map<std::string, std::string> getXmlContent(const pugi::xml_node& optValue) const;
+    std::map<std::string, std::string> getXmlContent(const pugi::xml_node& optValue, std::vector<std::string>* order = nullptr) const;
 
-    std::shared_ptr<ConfigOption> newOption(const std::map<std::string, std::string>& optValue);
+    std::shared_ptr<ConfigOption> newOption(const std::map<std::string, std::string>& optValue, const std::vector<std::string>& order = {});
 
     std::string getCurrentValue() const override { return ""; }
 };
@@ -31,6 +31,7 @@
 
 #include "content_manager.h" // API
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <dirent.h>
@@ -45,8 +46,15 @@
 #include "config/directory_tweak.h"
 #include "database/database.h"
 #include "layout/fallback_layout.h"
+#include "layout/playlist_layout.h"
+#include "layout/template_layout.h"
+#include "metadata/artwork_cache.h"
 #include "metadata/metadata_handler.h"
+#include "metadata/thumbnailer_pool.h"
+#include "transcoding/transcoding_scheduler.h"
 #include "update_manager.h"
+#include "util/curl_engine.h"
+#include "util/directory_crawler.h"
 #include "util/process.h"
 #include "util/string_converter.h"
 #include "util/timer.h"
@@ -73,15 +81,6 @@
 #include "util/task_processor.h"
 #endif
 
-#ifdef HAVE_MAGIC
-// for older versions of filemagic
-extern "C" {
-#include <magic.h>
-}
-
-static struct magic_set* ms = nullptr;
-#endif
-
 ContentManager::ContentManager(const std::shared_ptr<Config>& config, const std::shared_ptr<Database>& database,
     std::shared_ptr<UpdateManager> update_manager, std::shared_ptr<web::SessionManager> session_manager,
     std::shared_ptr<Timer> timer, std::shared_ptr<TaskProcessor> task_processor,
@@ -103,6 +102,8 @@ ContentManager::ContentManager(const std::shared_ptr<Config>& config, const std:
     working = false;
     shutdownFlag = false;
     layout_enabled = false;
+    layout_deferred = false;
+    layout_batch_size = DEFAULT_LAYOUT_BATCH_SIZE;
 
     // loading extension - mimetype map
     // we can always be sure to get a valid element because everything was prepared by the config manager
@@ -134,6 +135,34 @@ ContentManager::ContentManager(const std::shared_ptr<Config>& config, const std:
 
     database->updateAutoscanList(ScanMode::Timed, config_timed_list);
     autoscan_timed = database->getAutoscanList(ScanMode::Timed);
+
+    transcoding_scheduler = std::make_shared<TranscodingScheduler>(config);
+#if defined(HAVE_TAGLIB) || defined(HAVE_MATROSKA)
+    if (config->getBoolOption(CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_ENABLED)) {
+        fs::path artworkDir = config->getOption(CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_DIR);
+        if (artworkDir.empty())
+            artworkDir = fs::path(config->getOption(CFG_SERVER_HOME)) / "artwork-cache";
+        artwork_cache = std::make_shared<ArtworkCache>(artworkDir, config->getIntOption(CFG_IMPORT_LIBOPTS_ARTWORK_CACHE_ENTRIES));
+    }
+#endif
+    crawler = std::make_unique<DirectoryCrawler>(config->getIntOption(CFG_IMPORT_SCAN_THREADS));
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+    if (config->getBoolOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED))
+        thumbnailer_pool = std::make_shared<ThumbnailerPool>(config);
+    if (thumbnailer_pool != nullptr) {
+        thumbnailer_pool->sweepCache([self = database](const fs::path& location) {
+            try {
+                return self->findObjectByPath(location) != nullptr;
+            } catch (const std::runtime_error&) {
+                // keep the thumbnail if we cannot tell
+                return true;
+            }
+        });
+    }
+#endif
+#ifdef HAVE_CURL
+    curl_engine = std::make_shared<CurlEngine>(config->getIntOption(CFG_ONLINE_CONTENT_FETCH_MAX_CONNECTIONS));
+#endif
 }
 
 void ContentManager::run()
@@ -166,27 +195,14 @@ void ContentManager::run()
 #endif
 /* init filemagic */
 #ifdef HAVE_MAGIC
-    if (!ignore_unknown_extensions) {
-        ms = magic_open(MAGIC_MIME);
-        if (ms == nullptr) {
-            log_error("magic_open failed");
-        } else {
-            std::string optMagicFile = config->getOption(CFG_IMPORT_MAGIC_FILE);
-            const char* magicFile = nullptr;
-            if (!optMagicFile.empty())
-                magicFile = optMagicFile.c_str();
-            if (magic_load(ms, magicFile) == -1) {
-                log_warning("magic_load: {}", magic_error(ms));
-                magic_close(ms);
-                ms = nullptr;
-            }
-        }
-    }
+    setMagicFile(config->getOption(CFG_IMPORT_MAGIC_FILE));
 #endif // HAVE_MAGIC
 
     std::string layout_type = config->getOption(CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_TYPE);
-    if ((layout_type == "builtin") || (layout_type == "js"))
+    if ((layout_type == "builtin") || (layout_type == "template") || (layout_type == "js"))
         layout_enabled = true;
+    layout_deferred = config->getBoolOption(CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_DEFERRED);
+    layout_batch_size = config->getIntOption(CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_BATCH_SIZE);
 
 #ifdef ONLINE_SERVICES
     online_services = std::make_unique<OnlineServiceList>();
@@ -253,6 +269,8 @@ void ContentManager::run()
         throw_std_runtime_error("Could not start task thread");
     }
 
+    requeueLayout();
+
     autoscan_timed->notifyAll(this);
 
 #ifdef HAVE_INOTIFY
@@ -369,11 +387,13 @@ void ContentManager::shutdown()
         pthread_join(taskThread, nullptr);
     taskThread = 0;
 
-#ifdef HAVE_MAGIC
-    if (ms) {
-        magic_close(ms);
-        ms = nullptr;
-    }
+    crawler->shutdown();
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+    if (thumbnailer_pool != nullptr)
+        thumbnailer_pool->shutdown();
+#endif
+#ifdef HAVE_CURL
+    curl_engine->shutdown();
 #endif
     log_debug("end");
     log_debug("ContentManager destroyed");
@@ -451,32 +471,169 @@ std::shared_ptr<CdsObject> ContentManager::createSingleItem(const fs::path& path
             return nullptr;
         }
         if (IS_CDS_ITEM(obj->getObjectType())) {
+            // the flag survives a restart before the layout is built
+            if (layout_deferred && layout != nullptr)
+                obj->setFlag(OBJECT_FLAG_LAYOUT_PENDING);
             addObject(obj);
             isNew = true;
         }
     }
     if (IS_CDS_ITEM(obj->getObjectType()) && layout != nullptr && (processExisting || isNew)) {
-        try {
-            if (rootPath.empty() && (task != nullptr))
-                rootPath = task->getRootPath();
+        if (rootPath.empty() && (task != nullptr))
+            rootPath = task->getRootPath();
 
-            layout->processCdsObject(obj, rootPath);
+        if (layout_deferred) {
+            if (!obj->getFlag(OBJECT_FLAG_LAYOUT_PENDING)) {
+                obj->setFlag(OBJECT_FLAG_LAYOUT_PENDING);
+                database->updateObject(obj, nullptr);
+            }
+            deferLayout(obj, rootPath);
+        } else
+            processLayout(obj, rootPath, task);
+    }
+    return obj;
+}
 
-            std::string mimetype = std::static_pointer_cast<CdsItem>(obj)->getMimeType();
-            std::string content_type = getValueOrDefault(mimetype_contenttype_map, mimetype);
+void ContentManager::processLayout(const std::shared_ptr<CdsObject>& obj, const fs::path& rootPath, const std::shared_ptr<GenericTask>& task)
+{
+    layout->processCdsObject(obj, rootPath);
 
+    std::string mimetype = std::static_pointer_cast<CdsItem>(obj)->getMimeType();
+    std::string content_type = getValueOrDefault(mimetype_contenttype_map, mimetype);
+
+    if (content_type == CONTENT_TYPE_PLAYLIST) {
 #ifdef HAVE_JS
-            if ((playlist_parser_script != nullptr) && (content_type == CONTENT_TYPE_PLAYLIST))
-                playlist_parser_script->processPlaylistObject(obj, task);
-#else
-            if (content_type == CONTENT_TYPE_PLAYLIST)
-                log_warning("Playlist {} will not be parsed: Gerbera was compiled without JS support!", obj->getLocation().c_str());
+        if (playlist_parser_script != nullptr)
+            playlist_parser_script->processPlaylistObject(obj, task);
+        else
 #endif // JS
+            initPlaylistLayout()->processPlaylistObject(obj, task);
+    }
+}
+
+void ContentManager::deferLayout(const std::shared_ptr<CdsObject>& obj, const fs::path& rootPath)
+{
+    std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>> objects;
+    {
+        std::lock_guard<std::mutex> lock(layout_mutex);
+        pending_layout.emplace_back(obj, rootPath);
+        if (pending_layout.size() < layout_batch_size)
+            return;
+        objects.swap(pending_layout);
+    }
+    queueLayout(std::move(objects));
+}
+
+void ContentManager::flushLayout()
+{
+    std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>> objects;
+    {
+        std::lock_guard<std::mutex> lock(layout_mutex);
+        objects.swap(pending_layout);
+    }
+    if (!objects.empty())
+        queueLayout(std::move(objects));
+}
+
+void ContentManager::queueLayout(std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>> objects)
+{
+    auto self = shared_from_this();
+    auto task = std::make_shared<CMLayoutTask>(self, std::move(objects));
+    addTask(task, true);
+}
+
+void ContentManager::requeueLayout()
+{
+    auto objectIDs = database->getObjectsWithFlag(OBJECT_FLAG_LAYOUT_PENDING);
+    if (objectIDs.empty())
+        return;
+    if (!layout_enabled) {
+        database->clearFlagInDB(OBJECT_FLAG_LAYOUT_PENDING);
+        return;
+    }
+
+    log_info("Resuming virtual layout of {} objects", objectIDs.size());
+    auto self = shared_from_this();
+    for (std::size_t i = 0; i < objectIDs.size(); i += layout_batch_size) {
+        auto end = objectIDs.begin() + std::min(objectIDs.size(), i + layout_batch_size);
+        auto task = std::make_shared<CMLayoutTask>(self, std::vector<int>(objectIDs.begin() + i, end));
+        addTask(task, true);
+    }
+}
+
+/// \brief check if path is location or below it, whole path components are compared
+static bool isInLocation(const fs::path& path, fs::path location)
+{
+    if (location.filename().empty())
+        location = location.parent_path();
+    if (location.empty())
+        return false;
+    return std::mismatch(location.begin(), location.end(), path.begin(), path.end()).first == location.end();
+}
+
+void ContentManager::_layoutObjects(const std::vector<int>& objectIDs, const std::shared_ptr<GenericTask>& task)
+{
+    // the import root is not stored, the autoscan directory of the object is the closest match
+    auto autoscanDirectories = getAutoscanDirectories();
+    std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>> objects;
+    for (int objectID : objectIDs) {
+        std::shared_ptr<CdsObject> obj;
+        try {
+            obj = database->loadObject(objectID);
+        } catch (const ObjectNotFoundException&) {
+            continue;
+        }
+        fs::path rootPath;
+        for (const auto& adir : autoscanDirectories) {
+            auto location = adir->getLocation();
+            if (isInLocation(obj->getLocation(), location) && location.string().length() > rootPath.string().length())
+                rootPath = location;
+        }
+        objects.emplace_back(obj, rootPath);
+    }
+    _layoutObjects(objects, task);
+}
+
+void ContentManager::_layoutObjects(const std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>>& objects, const std::shared_ptr<GenericTask>& task)
+{
+    if (layout_enabled)
+        initLayout();
+#ifdef HAVE_JS
+    initJS();
+#endif
+    if (layout == nullptr)
+        return;
+
+    // objects that were removed or replaced in the meantime are skipped,
+    // they are looked up once per directory
+    std::unordered_map<int, std::unordered_map<std::string, PathInfo>> directories;
+    std::vector<int> laidOut;
+    std::size_t done = 0;
+    for (const auto& [obj, rootPath] : objects) {
+        if (!task->isValid() || shutdownFlag)
+            break;
+        if (++done % 100 == 0)
+            task->setDescription(fmt::format("Virtual layout: {} of {} objects", done, objects.size()));
+
+        auto directory = directories.find(obj->getParentID());
+        if (directory == directories.end())
+            directory = directories.emplace(obj->getParentID(), database->getChildPaths(obj->getParentID())).first;
+        auto child = directory->second.find(obj->getLocation());
+        if (child == directory->second.end() || child->second.id != obj->getID()) {
+            log_debug("Skipping layout of removed object {}", obj->getLocation().c_str());
+            continue;
+        }
+
+        // the references must not inherit the flag
+        obj->clearFlag(OBJECT_FLAG_LAYOUT_PENDING);
+        laidOut.push_back(obj->getID());
+        try {
+            processLayout(obj, rootPath, task);
         } catch (const std::runtime_error& e) {
-            throw e;
+            log_error("Failed to add {} to the virtual layout: {}", obj->getLocation().c_str(), e.what());
         }
     }
-    return obj;
+    database->clearFlagInDB(laidOut, OBJECT_FLAG_LAYOUT_PENDING);
 }
 
 int ContentManager::_addFile(const fs::path& path, fs::path rootPath, const AutoScanSetting& asSetting, const std::shared_ptr<CMAddFileTask>& task)
@@ -621,6 +778,7 @@ void ContentManager::_rescanDirectory(const std::shared_ptr<AutoscanDirectory>&
         }
 
         containerID = ensurePathExistence(adir->getLocation());
+        obj = nullptr;
         adir->setObjectID(containerID);
         database->updateAutoscanDirectory(adir);
         location = adir->getLocation();
@@ -660,8 +818,24 @@ void ContentManager::_rescanDirectory(const std::shared_ptr<AutoscanDirectory>&
     asSetting.mergeOptions(config, location);
     log_debug("Rescanning options: recursive={} hidden={} followSymlinks={}", asSetting.recursive, asSetting.hidden, asSetting.followSymlinks);
 
+    // a directory with unchanged time and number of entries still holds the same files
+    bool skipUnchanged = config->getBoolOption(CFG_IMPORT_AUTOSCAN_SKIP_UNCHANGED);
+    struct stat dirStat;
+    bool unchanged = false;
+    if (skipUnchanged && stat(location.c_str(), &dirStat) == 0) {
+        unchanged = obj != nullptr && obj->hasFingerprint()
+            && obj->getMTime() == dirStat.st_mtime
+            && obj->getInode() == dirStat.st_ino;
+        if (unchanged)
+            log_debug("{} is unchanged, checking subdirectories only", location.c_str());
+    } else {
+        skipUnchanged = false;
+    }
+
     // request only items if non-recursive scan is wanted
     auto list = database->getObjects(containerID, !asSetting.recursive);
+    // all known children at once instead of a lookup per entry
+    auto children = database->getChildPaths(containerID);
 
     unsigned int thisTaskID;
     if (task != nullptr) {
@@ -669,120 +843,153 @@ void ContentManager::_rescanDirectory(const std::shared_ptr<AutoscanDirectory>&
     } else
         thisTaskID = 0;
 
-    struct dirent* dent;
-    while ((dent = readdir(dir)) != nullptr) {
-        char* name = dent->d_name;
-        if (name[0] == '.') {
-            if (name[1] == 0) {
-                continue;
+    std::size_t entryCount;
+    bool completed;
+    bool filesOnly = false;
+    for (;;) {
+        entryCount = 0;
+        completed = true;
+        struct dirent* dent;
+        while ((dent = readdir(dir)) != nullptr) {
+            char* name = dent->d_name;
+            if (name[0] == '.') {
+                if (name[1] == 0) {
+                    continue;
+                }
+                if (name[1] == '.' && name[2] == 0) {
+                    continue;
+                }
+                entryCount++;
+                if (!asSetting.hidden) {
+                    continue;
+                }
+            } else
+                entryCount++;
+            fs::path newPath = location / name;
+
+            if ((shutdownFlag) || ((task != nullptr) && !task->isValid())) {
+                completed = false;
+                break;
             }
-            if (name[1] == '.' && name[2] == 0) {
+
+#ifdef DT_REG
+            if (unchanged && dent->d_type == DT_REG)
+                continue;
+#endif
+
+            struct stat statbuf;
+            int ret = stat(newPath.c_str(), &statbuf);
+            if (ret != 0) {
+                log_error("Failed to stat {}, {}", newPath.c_str(), strerror(errno));
                 continue;
             }
-            if (!asSetting.hidden) {
+            if (unchanged && !S_ISDIR(statbuf.st_mode))
+                continue;
+            if (filesOnly && S_ISDIR(statbuf.st_mode)) {
+                // subdirectories were handled by the first pass
+                auto child = children.find(newPath.string());
+                if (child != children.end() && list != nullptr)
+                    list->erase(child->second.id);
                 continue;
             }
-        }
-        fs::path newPath = location / name;
-
-        if ((shutdownFlag) || ((task != nullptr) && !task->isValid()))
-            break;
-
-        struct stat statbuf;
-        int ret = stat(newPath.c_str(), &statbuf);
-        if (ret != 0) {
-            log_error("Failed to stat {}, {}", newPath.c_str(), strerror(errno));
-            continue;
-        }
 
-        // it is possible that someone hits remove while the container is being scanned
-        // in this case we will invalidate the autoscan entry
-        if (adir->getScanID() == INVALID_SCAN_ID) {
-            closedir(dir);
-            return;
-        }
+            // it is possible that someone hits remove while the container is being scanned
+            // in this case we will invalidate the autoscan entry
+            if (adir->getScanID() == INVALID_SCAN_ID) {
+                closedir(dir);
+                return;
+            }
 
-        if (isLink(newPath, asSetting.followSymlinks)) {
-            int objectID = database->findObjectIDByPath(newPath);
-            if (objectID > 0) {
-                if (list != nullptr)
-                    list->erase(objectID);
-                removeObject(objectID, false);
+            auto child = children.find(newPath.string());
+            if (isLink(newPath, asSetting.followSymlinks)) {
+                if (child != children.end()) {
+                    int objectID = child->second.id;
+                    if (list != nullptr)
+                        list->erase(objectID);
+                    removeObject(objectID, false);
+                }
+                log_debug("link {} dropped", newPath.c_str());
+                continue;
             }
-            log_debug("link {} dropped", newPath.c_str());
-            continue;
-        }
 
-        asSetting.recursive = adir->getRecursive();
-        asSetting.followSymlinks = config->getBoolOption(CFG_IMPORT_FOLLOW_SYMLINKS);
-        asSetting.hidden = adir->getHidden();
-        asSetting.mergeOptions(config, location);
-
-        if (S_ISREG(statbuf.st_mode)) {
-            int objectID = database->findObjectIDByPath(newPath);
-            if (objectID > 0) {
-                if (list != nullptr)
-                    list->erase(objectID);
-
-                // check modification time and update file if chagned
-                if (last_modified_current_max < statbuf.st_mtime) {
-                    // readd object - we have to do this in order to trigger
-                    // layout
-                    removeObject(objectID, false, false);
+            asSetting.recursive = adir->getRecursive();
+            asSetting.followSymlinks = config->getBoolOption(CFG_IMPORT_FOLLOW_SYMLINKS);
+            asSetting.hidden = adir->getHidden();
+            asSetting.mergeOptions(config, location);
+
+            if (S_ISREG(statbuf.st_mode)) {
+                if (child != children.end()) {
+                    const auto& info = child->second;
+                    if (list != nullptr)
+                        list->erase(info.id);
+
+                    // items imported by older versions have no fingerprint, fall back to the autoscan time
+                    bool changed = info.hasFingerprint() ? info.fingerprintChanged(statbuf) : last_modified_current_max < statbuf.st_mtime;
+                    if (changed) {
+                        asSetting.recursive = false;
+                        asSetting.rescanResource = false;
+                        updateFileInternal(database->loadObject(info.id), rootpath, asSetting);
+                        // update time variable
+                        if (last_modified_new_max < statbuf.st_mtime)
+                            last_modified_new_max = statbuf.st_mtime;
+                    }
+                } else {
+                    // add file, not recursive, not async, not forced
                     asSetting.recursive = false;
                     asSetting.rescanResource = false;
                     addFileInternal(newPath, rootpath, asSetting, false);
-                    // update time variable
                     if (last_modified_new_max < statbuf.st_mtime)
                         last_modified_new_max = statbuf.st_mtime;
                 }
-            } else {
-                // add file, not recursive, not async, not forced
-                asSetting.recursive = false;
-                asSetting.rescanResource = false;
-                addFileInternal(newPath, rootpath, asSetting, false);
-                if (last_modified_new_max < statbuf.st_mtime)
-                    last_modified_new_max = statbuf.st_mtime;
-            }
-        } else if (S_ISDIR(statbuf.st_mode) && asSetting.recursive) {
-            int objectID = database->findObjectIDByPath(newPath);
-            if (objectID > 0) {
-                log_debug("rescanSubDirectory {}", newPath.c_str());
-                if (list != nullptr)
-                    list->erase(objectID);
-                // add a task to rescan the directory that was found
-                rescanDirectory(adir, objectID, newPath, task->isCancellable());
-            } else {
-                // we have to make sure that we will never add a path to the task list
-                // if it is going to be removed by a pending remove task.
-                // this lock will make sure that remove is not in the process of invalidating
-                // the AutocsanDirectories in the autoscan_timed list at the time when we
-                // are checking for validity.
-                AutoLock lock(mutex);
-
-                // it is possible that someone hits remove while the container is being scanned
-                // in this case we will invalidate the autoscan entry
-                if (adir->getScanID() == INVALID_SCAN_ID) {
-                    closedir(dir);
-                    return;
+            } else if (S_ISDIR(statbuf.st_mode) && asSetting.recursive) {
+                if (child != children.end()) {
+                    int objectID = child->second.id;
+                    log_debug("rescanSubDirectory {}", newPath.c_str());
+                    if (list != nullptr)
+                        list->erase(objectID);
+                    // add a task to rescan the directory that was found
+                    rescanDirectory(adir, objectID, newPath, task->isCancellable());
+                } else {
+                    // we have to make sure that we will never add a path to the task list
+                    // if it is going to be removed by a pending remove task.
+                    // this lock will make sure that remove is not in the process of invalidating
+                    // the AutocsanDirectories in the autoscan_timed list at the time when we
+                    // are checking for validity.
+                    AutoLock lock(mutex);
+
+                    // it is possible that someone hits remove while the container is being scanned
+                    // in this case we will invalidate the autoscan entry
+                    if (adir->getScanID() == INVALID_SCAN_ID) {
+                        closedir(dir);
+                        return;
+                    }
+
+                    log_debug("addSubDirectory {}", newPath.c_str());
+                    // add directory, recursive, async, hidden flag, low priority
+                    asSetting.recursive = true;
+                    asSetting.rescanResource = false;
+                    asSetting.mergeOptions(config, newPath);
+                    addFileInternal(newPath, rootpath, asSetting, true, true, thisTaskID, task->isCancellable());
                 }
-
-                log_debug("addSubDirectory {}", newPath.c_str());
-                // add directory, recursive, async, hidden flag, low priority
-                asSetting.recursive = true;
-                asSetting.rescanResource = false;
-                asSetting.mergeOptions(config, newPath);
-                addFileInternal(newPath, rootpath, asSetting, true, true, thisTaskID, task->isCancellable());
             }
-        }
-    } // while
+        } // while
+
+        // the entries changed within the resolution of the directory time
+        if (!completed || !unchanged || obj->getSizeOnDisk() == static_cast<off_t>(entryCount))
+            break;
+        log_debug("{} has changed entries, checking files", location.c_str());
+        unchanged = false;
+        filesOnly = true;
+        rewinddir(dir);
+    } // for
 
     closedir(dir);
 
-    if ((shutdownFlag) || ((task != nullptr) && !task->isValid()))
+    // a partial scan must neither remove objects nor store the fingerprint
+    if (!completed)
         return;
 
-    if (list != nullptr && !list->empty()) {
+    if (!unchanged && list != nullptr && !list->empty()) {
         auto changedContainers = database->removeObjects(list);
         if (changedContainers != nullptr) {
             session_manager->containerChangedUI(changedContainers->ui);
@@ -790,9 +997,59 @@ void ContentManager::_rescanDirectory(const std::shared_ptr<AutoscanDirectory>&
         }
     }
 
+    if (skipUnchanged && !unchanged) {
+        if (obj == nullptr)
+            obj = database->loadObject(containerID);
+        obj->setMTime(dirStat.st_mtime);
+        obj->setInode(dirStat.st_ino);
+        obj->setSizeOnDisk(entryCount);
+        database->storeFingerprint(obj);
+    }
+
     adir->setCurrentLMT(last_modified_new_max);
 }
 
+void ContentManager::updateFileInternal(const std::shared_ptr<CdsObject>& oldObj, const fs::path& rootpath, const AutoScanSetting& asSetting)
+{
+    fs::path path = oldObj->getLocation();
+    log_debug("Updating changed file {}", path.c_str());
+
+    auto obj = createObjectFromFile(path, asSetting.followSymlinks);
+    if (obj == nullptr || !IS_CDS_ITEM(obj->getObjectType())) {
+        removeObject(oldObj->getID(), false, false);
+        return;
+    }
+
+    auto item = std::static_pointer_cast<CdsItem>(obj);
+    std::string content_type = getValueOrDefault(mimetype_contenttype_map, item->getMimeType());
+    if (content_type == CONTENT_TYPE_PLAYLIST) {
+        // playlist entries are created by the parser on import only
+        removeObject(oldObj->getID(), false, false);
+        addFileInternal(path, rootpath, asSetting, false);
+        return;
+    }
+
+    bool layoutChanged = obj->getTitle() != oldObj->getTitle()
+        || obj->getClass() != oldObj->getClass()
+        || obj->getMetadata() != oldObj->getMetadata();
+
+    // keep id, position and state like the played flag
+    obj->setID(oldObj->getID());
+    obj->setParentID(oldObj->getParentID());
+    obj->setFlags(oldObj->getFlags());
+    updateObject(obj);
+
+    // a pending layout task builds the references of the object
+    if (layoutChanged && layout != nullptr && !obj->getFlag(OBJECT_FLAG_LAYOUT_PENDING)) {
+        auto changedContainers = database->removeReferences(obj->getID());
+        if (changedContainers != nullptr) {
+            session_manager->containerChangedUI(changedContainers->ui);
+            update_manager->containersChanged(changedContainers->upnp);
+        }
+        layout->processCdsObject(obj, rootpath);
+    }
+}
+
 /* scans the given directory and adds everything recursively */
 void ContentManager::addRecursive(const fs::path& path, bool followSymlinks, bool hidden, const std::shared_ptr<CMAddFileTask>& task)
 {
@@ -802,14 +1059,11 @@ void ContentManager::addRecursive(const fs::path& path, bool followSymlinks, boo
             return;
     }
 
-    auto f2i = StringConverter::f2i(config);
-
     DIR* dir = opendir(path.c_str());
     if (!dir) {
         throw_std_runtime_error("could not list directory " + path.string() + " : " + strerror(errno));
     }
-
-    int parentID = database->findObjectIDByPath(path);
+    closedir(dir);
 
     // abort loop if either:
     // no valid directory returned, server is about to shutdown, the task is there and was invalidated
@@ -817,47 +1071,44 @@ void ContentManager::addRecursive(const fs::path& path, bool followSymlinks, boo
         log_debug("IS TASK VALID? [{}], task path: [{}]", task->isValid(), path.c_str());
     }
 
-    struct dirent* dent;
-    while ((dent = readdir(dir)) != nullptr) {
-        char* name = dent->d_name;
-        if (name[0] == '.') {
-            if (name[1] == 0) {
-                continue;
-            }
-            if (name[1] == '.' && name[2] == 0) {
-                continue;
-            }
-            if (!hidden)
-                continue;
-        }
-        fs::path newPath = path / name;
+    // subdirectories are read ahead in parallel, the items are added here one by one
+    auto crawl = crawler->start(path, followSymlinks, hidden);
+    auto cancelled = [this, &task] { return shutdownFlag || (task != nullptr && !task->isValid()); };
 
-        if ((shutdownFlag) || ((task != nullptr) && !task->isValid()))
-            break;
+    std::unique_ptr<DirectoryCrawler::Listing> listing;
+    while ((listing = crawl->next(cancelled)) != nullptr) {
+        int parentID = database->findObjectIDByPath(listing->location);
+        // all known children at once instead of a lookup per entry
+        auto children = parentID > 0 ? database->getChildPaths(parentID) : std::unordered_map<std::string, PathInfo>();
 
-        if (config->getConfigFilename() == newPath)
-            continue;
+        for (const auto& entry : listing->entries) {
+            if (cancelled()) {
+                crawl->stop();
+                return;
+            }
 
-        // For the Web UI
-        if (task != nullptr) {
-            task->setDescription("Importing: " + newPath.string());
-        }
+            // directories are read by the crawler
+            if (entry.isDirectory)
+                continue;
 
-        try {
-            fs::path rootPath("");
-            // check database if parent, process existing
-            auto obj = createSingleItem(newPath, rootPath, followSymlinks, (parentID > 0), true, task);
+            if (config->getConfigFilename() == entry.path)
+                continue;
 
-            if (obj != nullptr && IS_CDS_ITEM(obj->getObjectType()))
-                parentID = obj->getParentID();
+            // For the Web UI
+            if (task != nullptr) {
+                task->setDescription("Importing: " + entry.path.string());
+            }
 
-            if (obj != nullptr && IS_CDS_CONTAINER(obj->getObjectType()))
-                addRecursive(newPath, followSymlinks, hidden, task);
-        } catch (const std::runtime_error& ex) {
-            log_warning("skipping {} (ex:{})", newPath.c_str(), ex.what());
+            try {
+                fs::path rootPath("");
+                // check database if known, process existing
+                bool known = children.find(entry.path.string()) != children.end();
+                createSingleItem(entry.path, rootPath, followSymlinks, known, true, task);
+            } catch (const std::runtime_error& ex) {
+                log_warning("skipping {} (ex:{})", entry.path.c_str(), ex.what());
+            }
         }
     }
-    closedir(dir);
 }
 
 void ContentManager::updateObject(int objectID, const std::map<std::string, std::string>& parameters)
@@ -982,6 +1233,35 @@ void ContentManager::updateObject(int objectID, const std::map<std::string, std:
     }
 }
 
+void ContentManager::addObjects(const std::vector<std::shared_ptr<CdsObject>>& objects)
+{
+    std::unordered_set<int> changedContainers;
+    std::map<int, int> addedChildren;
+    for (const auto& obj : objects) {
+        obj->validate();
+
+        int containerChanged = INVALID_OBJECT_ID;
+        database->addObject(obj, &containerChanged);
+        if (containerChanged != INVALID_OBJECT_ID)
+            changedContainers.insert(containerChanged);
+        addedChildren[obj->getParentID()]++;
+    }
+
+    for (const auto& [parentID, count] : addedChildren) {
+        // the parent was empty before, so its own parent shows a new child
+        if ((parentID != -1) && (database->getChildCount(parentID) == count)) {
+            auto parent = database->loadObject(parentID);
+            changedContainers.insert(parent->getParentID());
+        }
+        changedContainers.insert(parentID);
+    }
+
+    for (int id : changedContainers) {
+        update_manager->containerChanged(id);
+        session_manager->containerChangedUI(id);
+    }
+}
+
 void ContentManager::addObject(const std::shared_ptr<CdsObject>& obj)
 {
     obj->validate();
@@ -1136,8 +1416,7 @@ std::shared_ptr<CdsObject> ContentManager::createObjectFromFile(const fs::path&
         auto item = std::make_shared<CdsItem>(database);
         obj = item;
         item->setLocation(path);
-        item->setMTime(statbuf.st_mtime);
-        item->setSizeOnDisk(statbuf.st_size);
+        item->setFingerprint(statbuf);
 
         if (!mimetype.empty()) {
             item->setMimeType(mimetype);
@@ -1151,6 +1430,10 @@ std::shared_ptr<CdsObject> ContentManager::createObjectFromFile(const fs::path&
 
         if (magic) {
             MetadataHandler::setMetadata(config, item);
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+            if (thumbnailer_pool != nullptr && startswith(item->getMimeType(), "video"))
+                thumbnailer_pool->pregenerate(item->getLocation());
+#endif
         }
     } else if (S_ISDIR(statbuf.st_mode)) {
         auto cont = std::make_shared<CdsContainer>(database);
@@ -1211,6 +1494,8 @@ void ContentManager::initLayout()
 #endif
                 } else if (layout_type == "builtin") {
                     layout = std::make_shared<FallbackLayout>(config, database, self);
+                } else if (layout_type == "template") {
+                    layout = std::make_shared<TemplateLayout>(config, database, self);
                 }
             } catch (const std::runtime_error& e) {
                 layout = nullptr;
@@ -1222,10 +1507,17 @@ void ContentManager::initLayout()
     }
 }
 
+PlaylistLayout* ContentManager::initPlaylistLayout()
+{
+    if (playlist_layout == nullptr)
+        playlist_layout = std::make_unique<PlaylistLayout>(config, database, shared_from_this());
+    return playlist_layout.get();
+}
+
 #ifdef HAVE_JS
 void ContentManager::initJS()
 {
-    if (playlist_parser_script == nullptr) {
+    if (playlist_parser_script == nullptr && config->getBoolOption(CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_USE)) {
         auto self = shared_from_this();
         playlist_parser_script = std::make_unique<PlaylistParserScript>(config, database, self, scripting_runtime);
     }
@@ -1238,6 +1530,7 @@ void ContentManager::destroyJS() { playlist_parser_script = nullptr; }
 void ContentManager::destroyLayout()
 {
     layout = nullptr;
+    playlist_layout = nullptr;
 }
 
 void ContentManager::reloadLayout()
@@ -1285,6 +1578,10 @@ void ContentManager::threadProc()
         }
         // log_debug("content manager ASYNC STOP  {}", task->getDescription().c_str());
 
+        // the objects of the task get their virtual layout in the next batch
+        if (layout_deferred && !shutdownFlag)
+            flushLayout();
+
         if (!shutdownFlag) {
             lock.lock();
         }
@@ -1337,7 +1634,11 @@ int ContentManager::addFileInternal(
         addTask(task, lowPriority);
         return INVALID_OBJECT_ID;
     }
-    return _addFile(path, rootpath, asSetting);
+    int objectID = _addFile(path, rootpath, asSetting);
+    // the task thread flushes after each task, a synchronous add outside of it has to do it
+    if (layout_deferred && !pthread_equal(pthread_self(), taskThread))
+        flushLayout();
+    return objectID;
 }
 
 #ifdef ONLINE_SERVICES
@@ -1505,6 +1806,125 @@ void ContentManager::removeObject(int objectID, bool rescanResource, bool async,
     }
 }
 
+void ContentManager::moveFile(const fs::path& oldPath, bool isDir, const fs::path& newPath, const fs::path& rootpath, bool async)
+{
+    if (async) {
+        auto self = shared_from_this();
+        auto task = std::make_shared<CMMoveFileTask>(self, oldPath, isDir, newPath, rootpath);
+        task->setDescription("Moving to: " + newPath.string());
+        addTask(task);
+    } else {
+        _moveFile(oldPath, isDir, newPath, rootpath);
+    }
+}
+
+void ContentManager::_moveFile(const fs::path& oldPath, bool isDir, const fs::path& newPath, const fs::path& rootpath)
+{
+    auto obj = database->findObjectByPath(oldPath, !isDir);
+    if (obj == nullptr) {
+        log_debug("{} was not imported, nothing to move", oldPath.c_str());
+        return;
+    }
+    log_debug("Moving {} to {}", oldPath.c_str(), newPath.c_str());
+
+    int objectID = obj->getID();
+    int oldParentID = obj->getParentID();
+    int parentID = ensurePathExistence(newPath.parent_path());
+    auto items = database->moveObject(objectID, newPath, parentID);
+
+    update_manager->containerChanged(oldParentID);
+    session_manager->containerChangedUI(oldParentID);
+    if (parentID != oldParentID) {
+        update_manager->containerChanged(parentID);
+        session_manager->containerChangedUI(parentID);
+    }
+
+    if (layout == nullptr)
+        return;
+
+    // no metadata is extracted again, the layout only runs for
+    // items whose title changed or whose containers follow the path
+    for (int id : items) {
+        try {
+            auto item = database->loadObject(id);
+            bool titleChanged = id == objectID && item->getTitle() != obj->getTitle();
+            if (!titleChanged && !layout->dependsOnLocation(item))
+                continue;
+
+            auto changedContainers = database->removeReferences(id);
+            if (changedContainers != nullptr) {
+                session_manager->containerChangedUI(changedContainers->ui);
+                update_manager->containersChanged(changedContainers->upnp);
+            }
+            layout->processCdsObject(item, rootpath);
+        } catch (const std::runtime_error& e) {
+            log_error("Failed to update layout of moved object {}: {}", id, e.what());
+        }
+    }
+}
+
+void ContentManager::handleFileChanges(std::vector<FileChange> changes)
+{
+    auto self = shared_from_this();
+    std::string desc = changes.size() == 1 ? changes.front().path.string() : std::to_string(changes.size()) + " changed files";
+    auto task = std::make_shared<CMFileChangesTask>(self, std::move(changes));
+    task->setDescription("Updating: " + desc);
+    addTask(task, true); // adding with low priority
+}
+
+void ContentManager::_handleFileChanges(const std::vector<FileChange>& changes)
+{
+    if (layout_enabled)
+        initLayout();
+
+#ifdef HAVE_JS
+    initJS();
+#endif
+
+    for (const auto& change : changes) {
+        if (shutdownFlag)
+            return;
+
+        AutoScanSetting asSetting;
+        asSetting.followSymlinks = config->getBoolOption(CFG_IMPORT_FOLLOW_SYMLINKS);
+        asSetting.recursive = change.adir->getRecursive();
+        asSetting.hidden = change.adir->getHidden();
+        asSetting.rescanResource = true;
+        asSetting.mergeOptions(config, change.path);
+
+        try {
+            if (change.isDir) {
+                // directories are replaced as a whole
+                if (change.remove) {
+                    int objectID = database->findObjectIDByPath(change.path);
+                    if (objectID != INVALID_OBJECT_ID)
+                        removeObject(objectID, true);
+                }
+                if (change.add)
+                    addFile(change.path, change.adir->getLocation(), asSetting, true, true, false);
+                continue;
+            }
+
+            auto obj = database->findObjectByPath(change.path, true);
+            if (obj != nullptr && change.add && IS_CDS_ITEM(obj->getObjectType())) {
+                // files that are written or replaced keep their object
+                struct stat statbuf;
+                if (stat(change.path.c_str(), &statbuf) == 0 && S_ISREG(statbuf.st_mode)) {
+                    if (!obj->hasFingerprint() || obj->fingerprintChanged(statbuf))
+                        updateFileInternal(obj, change.adir->getLocation(), asSetting);
+                    continue;
+                }
+            }
+            if (obj != nullptr && (change.remove || change.add))
+                _removeObject(obj->getID(), true, false);
+            if (change.add)
+                _addFile(change.path, change.adir->getLocation(), asSetting);
+        } catch (const std::runtime_error& e) {
+            log_error("Failed to update {}: {}", change.path.c_str(), e.what());
+        }
+    }
+}
+
 void ContentManager::rescanDirectory(const std::shared_ptr<AutoscanDirectory>& adir, int objectId, std::string descPath, bool cancellable)
 {
     // building container path for the description
@@ -1769,6 +2189,71 @@ void CMRemoveObjectTask::run()
     content->_removeObject(objectID, rescanResource, all);
 }
 
+CMMoveFileTask::CMMoveFileTask(std::shared_ptr<ContentManager> content,
+    fs::path oldPath, bool isDir, fs::path newPath, fs::path rootpath)
+    : GenericTask(ContentManagerTask)
+    , content(std::move(content))
+    , oldPath(std::move(oldPath))
+    , isDir(isDir)
+    , newPath(std::move(newPath))
+    , rootpath(std::move(rootpath))
+{
+    this->taskType = MoveFile;
+    cancellable = false;
+}
+
+void CMMoveFileTask::run()
+{
+    content->_moveFile(oldPath, isDir, newPath, rootpath);
+}
+
+CMFileChangesTask::CMFileChangesTask(std::shared_ptr<ContentManager> content, std::vector<FileChange> changes)
+    : GenericTask(ContentManagerTask)
+    , content(std::move(content))
+    , changes(std::move(changes))
+{
+    this->taskType = FileChanges;
+    cancellable = false;
+}
+
+void CMFileChangesTask::run()
+{
+    content->_handleFileChanges(changes);
+}
+
+CMLayoutTask::CMLayoutTask(std::shared_ptr<ContentManager> content,
+    std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>> objects)
+    : GenericTask(ContentManagerTask)
+    , content(std::move(content))
+    , objects(std::move(objects))
+{
+    this->taskType = VirtualLayout;
+    this->cancellable = false;
+    setDescription(fmt::format("Virtual layout: {} objects", this->objects.size()));
+}
+
+CMLayoutTask::CMLayoutTask(std::shared_ptr<ContentManager> content, std::vector<int> objectIDs)
+    : GenericTask(ContentManagerTask)
+    , content(std::move(content))
+    , objectIDs(std::move(objectIDs))
+{
+    this->taskType = VirtualLayout;
+    this->cancellable = false;
+    setDescription(fmt::format("Virtual layout: {} objects", this->objectIDs.size()));
+}
+
+void CMLayoutTask::run()
+{
+    auto self = shared_from_this();
+    if (!objectIDs.empty()) {
+        log_debug("running layout task with {} stored objects", objectIDs.size());
+        content->_layoutObjects(objectIDs, self);
+        return;
+    }
+    log_debug("running layout task with {} objects", objects.size());
+    content->_layoutObjects(objects, self);
+}
+
 CMRescanDirectoryTask::CMRescanDirectoryTask(std::shared_ptr<ContentManager> content,
     std::shared_ptr<AutoscanDirectory> adir, int containerId, bool cancellable)
     : GenericTask(ContentManagerTask)
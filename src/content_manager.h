@@ -78,6 +78,16 @@ class Runtime;
 class LastFm;
 class ContentManager;
 class TaskProcessor;
+class TranscodingScheduler;
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+class ThumbnailerPool;
+#endif
+class ArtworkCache;
+class DirectoryCrawler;
+class PlaylistLayout;
+#ifdef HAVE_CURL
+class CurlEngine;
+#endif
 
 class CMAddFileTask : public GenericTask, public std::enable_shared_from_this<CMAddFileTask> {
 protected:
@@ -107,6 +117,56 @@ public:
     void run() override;
 };
 
+class CMMoveFileTask : public GenericTask {
+protected:
+    std::shared_ptr<ContentManager> content;
+    fs::path oldPath;
+    bool isDir;
+    fs::path newPath;
+    fs::path rootpath;
+
+public:
+    CMMoveFileTask(std::shared_ptr<ContentManager> content,
+        fs::path oldPath, bool isDir, fs::path newPath, fs::path rootpath);
+    void run() override;
+};
+
+/// \brief change of a file or directory, combined from all its inotify events
+struct FileChange {
+    fs::path path;
+    bool isDir;
+    /// \brief the object of the path has to be removed first
+    bool remove;
+    /// \brief the path has to be imported, or updated if the file changed
+    bool add;
+    std::shared_ptr<AutoscanDirectory> adir;
+};
+
+class CMFileChangesTask : public GenericTask {
+protected:
+    std::shared_ptr<ContentManager> content;
+    std::vector<FileChange> changes;
+
+public:
+    CMFileChangesTask(std::shared_ptr<ContentManager> content, std::vector<FileChange> changes);
+    void run() override;
+};
+
+/// \brief Builds the virtual layout of objects that were imported before
+class CMLayoutTask : public GenericTask, public std::enable_shared_from_this<CMLayoutTask> {
+protected:
+    std::shared_ptr<ContentManager> content;
+    std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>> objects;
+    std::vector<int> objectIDs;
+
+public:
+    CMLayoutTask(std::shared_ptr<ContentManager> content,
+        std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>> objects);
+    /// \brief layout of objects that were still waiting when the server stopped
+    CMLayoutTask(std::shared_ptr<ContentManager> content, std::vector<int> objectIDs);
+    void run() override;
+};
+
 class CMRescanDirectoryTask : public GenericTask, public std::enable_shared_from_this<CMRescanDirectoryTask> {
 protected:
     std::shared_ptr<ContentManager> content;
@@ -190,6 +250,17 @@ public:
     int ensurePathExistence(fs::path path);
     void removeObject(int objectID, bool rescanResource, bool async = true, bool all = false);
 
+    /// \brief Moves a file or directory that was renamed on disk, keeping the object ids
+    /// \param oldPath location before the rename
+    /// \param isDir the renamed object is a directory
+    /// \param newPath new location on disk
+    /// \param rootpath absolute path to the container root of the new location
+    /// \param async queue task or perform a blocking call
+    void moveFile(const fs::path& oldPath, bool isDir, const fs::path& newPath, const fs::path& rootpath, bool async = true);
+
+    /// \brief Queues one task to import, update and remove the given paths
+    void handleFileChanges(std::vector<FileChange> changes);
+
     /// \brief Updates an object in the database using the given parameters.
     /// \param objectID ID of the object to update
     /// \param parameters key value pairs of fields to be updated
@@ -228,6 +299,10 @@ public:
     /// The ID of the object provided is ignored and generated by this method
     void addObject(const std::shared_ptr<CdsObject>& obj);
 
+    /// \brief Adds objects to the database with one update per parent container.
+    /// \param objects objects to add, their parentID must be set
+    void addObjects(const std::vector<std::shared_ptr<CdsObject>>& objects);
+
     /// \brief Adds a virtual container chain specified by path.
     /// \param container path separated by '/'. Slashes in container
     /// titles must be escaped.
@@ -305,6 +380,25 @@ public:
 
     void triggerPlayHook(const std::shared_ptr<CdsObject>& obj);
 
+    /// \brief admission control for external transcoders
+    std::shared_ptr<TranscodingScheduler> getTranscodingScheduler() const { return transcoding_scheduler; }
+
+    /// \brief worker pool reading directory trees, shared by all scans
+    DirectoryCrawler* getDirectoryCrawler() const { return crawler.get(); }
+
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+    /// \brief workers generating video thumbnails, nullptr if ffmpegthumbnailer is disabled
+    std::shared_ptr<ThumbnailerPool> getThumbnailerPool() const { return thumbnailer_pool; }
+#endif
+
+    /// \brief store for embedded cover art, nullptr if disabled
+    std::shared_ptr<ArtworkCache> getArtworkCache() const { return artwork_cache; }
+
+#ifdef HAVE_CURL
+    /// \brief shared transfer engine for all online content
+    std::shared_ptr<CurlEngine> getCurlEngine() const { return curl_engine; }
+#endif
+
 protected:
     void initLayout();
     void destroyLayout();
@@ -341,6 +435,16 @@ protected:
 #endif
 
     std::vector<std::shared_ptr<Executor>> process_list;
+    std::shared_ptr<TranscodingScheduler> transcoding_scheduler;
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+    std::shared_ptr<ThumbnailerPool> thumbnailer_pool;
+#endif
+    std::shared_ptr<ArtworkCache> artwork_cache;
+    /// \brief reads the trees of recursive imports, its workers are shared by all of them
+    std::unique_ptr<DirectoryCrawler> crawler;
+#ifdef HAVE_CURL
+    std::shared_ptr<CurlEngine> curl_engine;
+#endif
 
     int addFileInternal(const fs::path& path, const fs::path& rootpath, const AutoScanSetting& asSetting,
         bool async = true,
@@ -350,13 +454,20 @@ protected:
     int _addFile(const fs::path& path, fs::path rootPath, const AutoScanSetting& asSetting,
         const std::shared_ptr<CMAddFileTask>& task = nullptr);
 
+    /// \brief extract a changed file again and update its item in place
+    void updateFileInternal(const std::shared_ptr<CdsObject>& oldObj, const fs::path& rootpath, const AutoScanSetting& asSetting);
+
     void _removeObject(int objectID, bool rescanResource, bool all);
+    void _moveFile(const fs::path& oldPath, bool isDir, const fs::path& newPath, const fs::path& rootpath);
+    void _handleFileChanges(const std::vector<FileChange>& changes);
 
     void _rescanDirectory(const std::shared_ptr<AutoscanDirectory>& adir, int containerID, const std::shared_ptr<GenericTask>& task = nullptr);
     /* for recursive addition */
     void addRecursive(const fs::path& path, bool followSymlinks, bool hidden, const std::shared_ptr<CMAddFileTask>& task);
     static bool isLink(const fs::path& path, bool allowLinks);
     std::shared_ptr<CdsObject> createSingleItem(const fs::path& path, fs::path& rootPath, bool followSymlinks, bool checkDatabase, bool processExisting, const std::shared_ptr<CMAddFileTask>& task);
+    /// \brief add the object to the virtual layout and read it if it is a playlist
+    void processLayout(const std::shared_ptr<CdsObject>& obj, const fs::path& rootPath, const std::shared_ptr<GenericTask>& task);
     bool updateAttachedResources(const char* location, const std::string& parentPath, bool all);
     std::string extension2mimetype(std::string extension);
     std::string mimetype2upnpclass(const std::string& mimeType);
@@ -372,9 +483,25 @@ protected:
 #ifdef HAVE_JS
     std::unique_ptr<PlaylistParserScript> playlist_parser_script;
 #endif
+    std::unique_ptr<PlaylistLayout> playlist_layout;
+    PlaylistLayout* initPlaylistLayout();
 
     bool layout_enabled;
 
+    /// \brief the layout of new objects is built by CMLayoutTask after the import
+    bool layout_deferred;
+    std::size_t layout_batch_size;
+    std::mutex layout_mutex;
+    std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>> pending_layout;
+    void deferLayout(const std::shared_ptr<CdsObject>& obj, const fs::path& rootPath);
+    /// \brief queue a CMLayoutTask for the objects that are still waiting
+    void flushLayout();
+    void queueLayout(std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>> objects);
+    /// \brief queue the objects that are marked with OBJECT_FLAG_LAYOUT_PENDING in the database
+    void requeueLayout();
+    void _layoutObjects(const std::vector<std::pair<std::shared_ptr<CdsObject>, fs::path>>& objects, const std::shared_ptr<GenericTask>& task);
+    void _layoutObjects(const std::vector<int>& objectIDs, const std::shared_ptr<GenericTask>& task);
+
     void setLastModifiedTime(time_t lm);
 
     void signal() { cond.notify_one(); }
@@ -398,7 +525,10 @@ protected:
 
     friend void CMAddFileTask::run();
     friend void CMRemoveObjectTask::run();
+    friend void CMMoveFileTask::run();
+    friend void CMFileChangesTask::run();
     friend void CMRescanDirectoryTask::run();
+    friend void CMLayoutTask::run();
 #ifdef ONLINE_SERVICES
     friend void CMFetchOnlineContentTask::run();
 #endif
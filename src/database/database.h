@@ -36,6 +36,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <sys/stat.h>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -139,6 +141,21 @@ public:
     int getRequestedCount() const { return requestedCount; }
 };
 
+/// \brief Object of the file system as returned by Database::getChildPaths
+struct PathInfo {
+    int id;
+    unsigned int objectType;
+    time_t mtime;
+    off_t sizeOnDisk;
+    ino_t inode;
+
+    bool hasFingerprint() const { return mtime > 0; }
+    bool fingerprintChanged(const struct stat& statbuf) const
+    {
+        return mtime != statbuf.st_mtime || sizeOnDisk != statbuf.st_size || inode != statbuf.st_ino;
+    }
+};
+
 class Database {
 public:
     explicit Database(std::shared_ptr<Config> config);
@@ -200,6 +217,11 @@ public:
     /// \return the obejectID
     virtual int findObjectIDByPath(fs::path fullpath, bool wasRegularFile = false) = 0;
 
+    /// \brief Get the files and directories of a (pc directory) container in one go
+    /// \param parentID the object id of the container
+    /// \return objects by their path, without loading them completely
+    virtual std::unordered_map<std::string, PathInfo> getChildPaths(int parentID) = 0;
+
     /// \brief increments the updateIDs for the given objectIDs
     /// \param ids pointer to the array of ids
     /// \param size number of entries in the given array
@@ -244,6 +266,26 @@ public:
     /// \return changed container ids
     virtual std::unique_ptr<ChangedContainers> removeObjects(const std::unique_ptr<std::unordered_set<int>>& list, bool all = false) = 0;
 
+    /// \brief Store modification time, size and inode of an object only
+    ///
+    /// For containers of the file system the size is the number of directory entries.
+    virtual void storeFingerprint(const std::shared_ptr<CdsObject>& obj) = 0;
+
+    /// \brief Remove all references to an object, keeping the object itself
+    /// \param objectID the object id of the referenced object
+    /// \return changed container ids - nullptr if there were no references
+    virtual std::unique_ptr<ChangedContainers> removeReferences(int objectID) = 0;
+
+    /// \brief Move a file or directory object and everything below it to a new location
+    ///
+    /// Object ids are kept, only location, parent and a title derived from
+    /// the file name change.
+    /// \param objectID the object id of the moved file or directory
+    /// \param newPath new location on disk
+    /// \param parentID container of the new parent directory
+    /// \return ids of the moved items
+    virtual std::vector<int> moveObject(int objectID, const fs::path& newPath, int parentID) = 0;
+
     /// \brief Loads an object given by the online service ID.
     virtual std::shared_ptr<CdsObject> loadObjectByServiceID(const std::string& serviceID) = 0;
 
@@ -292,6 +334,12 @@ public:
     /// \brief clears the given flag in all objects in the DB
     virtual void clearFlagInDB(int flag) = 0;
 
+    /// \brief clears the given flag in the given objects
+    virtual void clearFlagInDB(const std::vector<int>& objectIDs, int flag) = 0;
+
+    /// \brief Get all objects that have the given flag set
+    virtual std::vector<int> getObjectsWithFlag(int flag) = 0;
+
     virtual std::string getFsRootName() = 0;
 
     virtual void threadCleanup() = 0;
@@ -33,90 +33,91 @@
 
 #ifndef __MYSQL_CREATE_SQL_H__
 #define __MYSQL_CREATE_SQL_H__
-#define MS_CREATE_SQL_INFLATED_SIZE 4479
-#define MS_CREATE_SQL_DEFLATED_SIZE 1159
+#define MS_CREATE_SQL_INFLATED_SIZE 4671
+#define MS_CREATE_SQL_DEFLATED_SIZE 1183
 
 /* begin binary data: */
-const unsigned char mysql_create_sql[] = /* 1159 */
-{0x78,0x9C,0xC5,0x58,0xDF,0x8F,0x9B,0x38,0x10,0x7E,0xDF,0xBF,0xC2,0xF7,0x04
-,0xA9,0xE8,0x6D,0x58,0x6D,0x4F,0xAD,0xAA,0x95,0x96,0x4B,0xDC,0x36,0x2A,0x4B
-,0xB6,0x40,0xEE,0xAE,0xF7,0xE2,0x38,0xE0,0x24,0xBE,0x25,0x10,0x81,0x89,0x9A
-,0xFF,0xFE,0xC6,0x10,0xC2,0x2F,0x27,0x9B,0x48,0xA7,0xEB,0xCB,0x2E,0x19,0x3E
-,0x8F,0xC7,0xDF,0x8C,0x3F,0x7B,0xB8,0x7D,0xF3,0xCB,0xFD,0xD0,0x1C,0x9A,0xC8
-,0xC3,0x3E,0x7A,0x9C,0xDA,0x63,0x32,0xFA,0x62,0xB9,0xD6,0xC8,0xC7,0x2E,0x01
-,0x13,0x19,0xD9,0x13,0xEC,0xF8,0x0F,0x8F,0x8F,0x2A,0x33,0x7A,0x73,0xFB,0xF1
-,0xE6,0xF6,0x15,0x0F,0x2E,0xF6,0x66,0xB6,0xEF,0xF5,0x5C,0x1C,0xEC,0xA7,0x7C
-,0x4C,0x6D,0xDB,0xF2,0x27,0x53,0x07,0x9E,0x1C,0x07,0x8F,0xE4,0xA3,0x74,0xA1
-,0x30,0xF7,0x3D,0x38,0xD6,0x13,0xF6,0x50,0x2E,0x96,0xEF,0xEB,0x77,0x43,0xF3
-,0xBE,0xF6,0x3E,0x73,0x26,0xDF,0x66,0x18,0x02,0xC5,0xA3,0xAF,0x32,0xB2,0xD6
-,0x6F,0x03,0xB5,0x5F,0x0F,0x4F,0x38,0xF9,0x34,0x75,0xF1,0xE4,0xB3,0x43,0xBE
-,0xE2,0xEF,0xB5,0xA7,0xBE,0xD1,0x40,0x0A,0xE0,0xF0,0xC4,0xB2,0xBD,0x6F,0x36
-,0x79,0x9A,0x8E,0x31,0x78,0xAA,0x1E,0x0D,0x74,0x34,0x6A,0xCE,0x94,0x58,0x33
-,0x7F,0x4A,0xFE,0xB0,0x6C,0x88,0x0F,0x58,0xF8,0x1B,0xBB,0x53,0xAD,0xE1,0xCB
-,0xEC,0xF8,0x72,0xA6,0x3E,0xF6,0x0E,0xCE,0x8A,0xE7,0xD2,0x5B,0x69,0x2E,0x83
-,0x18,0xB9,0xD8,0xF2,0x31,0xF2,0xAD,0xDF,0x6D,0x8C,0xE6,0x1B,0x41,0x82,0x30
-,0x23,0xC9,0xE2,0x1F,0x16,0x88,0x39,0xD2,0x6F,0x10,0x9A,0xF3,0x70,0x8E,0x78
-,0x2C,0x74,0xD3,0x1C,0x20,0x18,0x89,0x9C,0x99,0x6D,0x23,0x9A,0x8B,0x84,0xF0
-,0x38,0x48,0xD9,0x86,0xC5,0xC2,0x90,0xB8,0x94,0x2D,0x49,0x13,0x1B,0xB2,0x25
-,0xCD,0x23,0x51,0xE0,0x0B,0xC0,0x96,0xA6,0x80,0x25,0x4A,0x7F,0x15,0x58,0x1B
-,0x6A,0x05,0xB6,0x8C,0x80,0x88,0xFD,0x96,0xCD,0x91,0xE0,0xF1,0x5E,0x8E,0xB8
-,0x1F,0xA0,0x3C,0xCE,0xF8,0x2A,0x66,0xE1,0x71,0x64,0x81,0xCE,0xB7,0xF1,0x96
-,0x04,0x11,0xCD,0xB2,0x39,0xDA,0xD1,0x34,0x58,0xD3,0x54,0x7F,0x3F,0x54,0x84
-,0x10,0x06,0x44,0x70,0x11,0xB1,0x1A,0x76,0xF7,0xEE,0x9D,0x02,0x17,0x25,0x01
-,0x15,0x3C,0x89,0xE7,0x68,0x11,0x25,0x8B,0x96,0x89,0xAC,0x69,0xB6,0xAE,0x57
-,0x70,0x0C,0xA8,0xE7,0x63,0xC3,0x04,0x0D,0xA9,0xA0,0x0D,0x1F,0x34,0xFF,0xD1
-,0xB1,0xA4,0x2C,0x4B,0xF2,0x34,0x60,0x59,0xC3,0x96,0x6F,0x01,0xC4,0x2E,0xE3
-,0x69,0xC3,0x37,0xEC,0xC0,0x52,0xB5,0xA2,0x7B,0xD5,0xC2,0x97,0x11,0x5D,0x65
-,0x8A,0xA8,0xFB,0x8E,0xCD,0xD2,0xB1,0x48,0x69,0xF0,0x42,0xE2,0x7C,0xB3,0x60
-,0xE9,0x99,0x9C,0x66,0x2C,0xDD,0xF1,0xA0,0x0C,0xF6,0x2C,0xA5,0xCF,0xEE,0xE4
-,0xC9,0x72,0xBF,0x23,0xD8,0x05,0x08,0xE9,0xB2,0xA8,0x06,0xD2,0x2C,0x7F,0xCE
-,0xEB,0x92,0x23,0x55,0x11,0xE9,0x55,0x39,0x29,0x51,0x8D,0x4A,0xD2,0x1B,0x65
-,0x65,0xB4,0xCA,0xC6,0xA8,0xB3,0xAD,0x74,0xD2,0x2A,0x31,0xBD,0x35,0xB4,0xC6
-,0x1F,0xB3,0x5E,0xCE,0x22,0x81,0xED,0x42,0x30,0x1A,0xF3,0x2B,0xA7,0x69,0x13
-,0xA9,0xB7,0x89,0x55,0x8E,0x68,0x72,0xAA,0x37,0x19,0x2E,0xD0,0xA0,0x7C,0x9E
-,0xEF,0x5A,0x13,0xD0,0xDF,0xF6,0x76,0x25,0x7C,0xB1,0x7C,0x21,0xE6,0xBC,0x12
-,0x9C,0xC2,0x6F,0xCD,0x23,0x72,0xF1,0x27,0xEC,0x62,0x67,0x04,0xDA,0xD8,0xDB
-,0xE7,0x45,0x3E,0x10,0x88,0xE9,0x18,0xDB,0x18,0xE4,0x60,0x64,0x79,0x23,0x6B
-,0x8C,0xA5,0x65,0xF6,0x3C,0xB6,0x6A,0xCB,0x05,0x11,0xDC,0x75,0x23,0x68,0x10
-,0xF4,0xDF,0x04,0x71,0x33,0x40,0xD8,0xF9,0x3C,0x71,0xF0,0xC3,0xD3,0x7E,0xE2
-,0x59,0x4F,0x48,0x1E,0x2D,0x20,0x7C,0x0F,0x52,0xF3,0x3F,0xDE,0x4C,0x1C,0x0F
-,0xBB,0x3E,0x82,0xF8,0xA6,0xBD,0x49,0x0A,0xE9,0xF4,0x90,0xFE,0xD6,0x34,0x8A
-,0xCA,0x84,0xFF,0xC3,0xF2,0xE9,0xFC,0x9F,0x03,0xE8,0x43,0x6D,0x1A,0x5C,0x36
-,0xD1,0xF0,0x38,0x8F,0x69,0x68,0xE5,0xCB,0x5F,0x83,0x24,0x16,0x94,0xC7,0x2C
-,0xD5,0x0C,0xCD,0x4D,0x12,0xA1,0x5D,0x39,0xEF,0x81,0x8D,0xEE,0x94,0x52,0xFA
-,0x25,0x87,0x0F,0x20,0x0E,0xE8,0xCF,0x2F,0xC0,0xF3,0xE1,0xA7,0xA9,0x5D,0x16
-,0xAB,0x59,0xCD,0xA9,0x0E,0xF5,0x79,0x84,0xC6,0x3C,0x05,0x6B,0x92,0xEE,0xAF
-,0x0D,0x59,0x79,0xCC,0xD0,0x40,0xF0,0x1D,0x54,0xB6,0x60,0x9B,0x33,0x67,0x4D
-,0xA9,0x9C,0x41,0x29,0xC7,0x2D,0x8D,0x69,0x21,0x32,0x01,0xA2,0x79,0x06,0x70
-,0x42,0x80,0x14,0xC5,0xDC,0x08,0xEB,0xC4,0x9E,0xFA,0xDF,0x4A,0xB9,0x47,0x1B
-,0x90,0xC3,0xD2,0x98,0x46,0x20,0x12,0x02,0x8E,0xC5,0xD5,0x81,0xB7,0x17,0xB6
-,0x6F,0x1F,0x00,0x2D,0x6A,0x76,0x34,0xCA,0xAF,0xA0,0x46,0x3A,0x1B,0x5C,0xB9
-,0xC7,0xFA,0x71,0x55,0x45,0xA5,0x85,0x0B,0xB2,0x63,0x69,0x06,0xE9,0x83,0x1A
-,0xFA,0x4D,0x53,0x15,0x83,0xBC,0x4D,0x64,0x01,0x8D,0xAF,0xBC,0x71,0x00,0xDD
-,0xE7,0x6F,0x1C,0xD2,0x27,0x89,0xD8,0x8E,0x45,0x73,0xC4,0x40,0x72,0x75,0x6D
-,0x41,0x33,0x1E,0x40,0x1C,0xCB,0x3C,0x8A,0xB4,0x6E,0x05,0x49,0xF4,0x26,0x09
-,0x59,0x05,0x16,0x70,0xB8,0x86,0x00,0xE6,0x71,0x22,0xF8,0x72,0xDF,0xC5,0xC3
-,0x56,0xC8,0x61,0x5D,0xBB,0x4B,0x6E,0x28,0x6B,0x1E,0x86,0x2C,0xBE,0x00,0x58
-,0x10,0x09,0x09,0xBB,0xE4,0x86,0x01,0x17,0x1E,0x21,0x03,0xE6,0x4B,0xCE,0x80
-,0x86,0x05,0x5F,0xC9,0x31,0x77,0xC3,0x73,0x63,0xB6,0x32,0x15,0x99,0x28,0xCE
-,0xB2,0x73,0xC1,0xF4,0x6E,0x1A,0x8A,0x2B,0xD1,0x96,0x8A,0x35,0x24,0xA0,0x79
-,0x77,0x11,0x49,0x1E,0xAC,0x65,0x30,0x97,0xF9,0x2E,0x2F,0x1B,0xCD,0xFA,0x9B
-,0x97,0xA7,0x5E,0xB5,0x3D,0xCB,0xBB,0x78,0xF9,0xA6,0x51,0x28,0xA4,0x4A,0xBD
-,0x5E,0x15,0x81,0x6A,0x33,0x1F,0xD1,0xEA,0x5D,0x5C,0x8D,0xFC,0x39,0x3B,0xB9
-,0xBE,0x1E,0x5E,0x55,0xF3,0xA5,0x2A,0x9D,0x92,0xC9,0x6D,0x9A,0x40,0x82,0xC5
-,0x9E,0xC4,0x74,0x73,0x6E,0xC7,0xD7,0xC0,0x83,0x36,0x08,0xF6,0x43,0x9C,0xD4
-,0x84,0x4E,0x4E,0xCA,0x64,0x1C,0xC2,0x27,0xC7,0x80,0xF4,0x63,0x6C,0xAA,0x5C
-,0xD4,0xF8,0x70,0xF9,0xD2,0x17,0xD4,0x6A,0xE4,0x4F,0xC8,0xC5,0x2A,0x5D,0x10
-,0x38,0xE6,0x96,0x7C,0x55,0x91,0xA1,0x57,0x44,0x77,0x18,0xDC,0xA6,0x7C,0x43
-,0xD3,0x3D,0x02,0x81,0x34,0x7A,0xAA,0xDB,0xE7,0xB8,0x58,0xD4,0x6B,0xDA,0x5B
-,0x9C,0x5B,0x79,0xA3,0x6F,0xB9,0x6B,0xA8,0xF7,0x00,0x00,0x17,0x2C,0x64,0xE2
-,0x8C,0xF1,0x5F,0xA8,0xBB,0x8E,0x22,0x33,0x92,0x9B,0xEE,0x0B,0x5D,0xBE,0x18
-,0x74,0xFA,0xCF,0xBA,0xF5,0x6C,0x36,0xA2,0xFD,0xDE,0x57,0xD5,0xF6,0xAA,0xDB
-,0xE1,0xFE,0xD8,0x4E,0xDF,0xDD,0x6B,0xC5,0xFB,0x5D,0xB1,0xFA,0x6B,0xC4,0xA9
-,0xEF,0x14,0xAF,0x8D,0x3F,0x7E,0x8B,0x38,0xF9,0x99,0x42,0xE1,0x41,0xF9,0x25
-,0xE2,0xD4,0x37,0x8A,0x7E,0x2F,0xDE,0x68,0xC3,0x5B,0x5D,0x79,0x81,0xFC,0x17
-,0x47,0x90,0x4C,0x7E};
-/* end binary data. size = 1159 bytes */
+const unsigned char mysql_create_sql[] = /* 1183 */
+{0x78,0x9C,0xC5,0x58,0x5D,0x93,0x9B,0x36,0x14,0x7D,0xDF,0x5F,0xA1,0x3E,0x81
+,0x33,0x34,0x6B,0x76,0x36,0xD3,0x74,0x32,0x3B,0xB3,0xD4,0x56,0x12,0x4F,0x58
+,0xBC,0x01,0xDC,0x34,0x7D,0x11,0x32,0xC8,0xB6,0xBA,0x7C,0x78,0x40,0x78,0xE2
+,0xFE,0xFA,0x4A,0x60,0xCC,0x97,0xF0,0xB2,0x4D,0xA7,0x79,0xD9,0xC5,0x97,0xA3
+,0xCB,0xD1,0xBD,0x57,0xE7,0x4A,0xBA,0x7E,0xF5,0xD3,0xED,0x54,0x9F,0xEA,0xC0
+,0x81,0x2E,0xB8,0x5F,0x9A,0x73,0x34,0xFB,0x68,0xD8,0xC6,0xCC,0x85,0x36,0xE2
+,0x26,0x34,0x33,0x17,0xD0,0x72,0xEF,0xEE,0xEF,0x65,0x66,0xF0,0xEA,0xFA,0xDD
+,0xD5,0xF5,0x33,0x1E,0x6C,0xE8,0xAC,0x4C,0xD7,0xE9,0xB9,0x38,0xD9,0x87,0x7C
+,0x2C,0x4D,0xD3,0x70,0x17,0x4B,0x8B,0x3F,0x59,0x16,0x9C,0x89,0x47,0xE1,0x42
+,0x62,0xEE,0x7B,0xB0,0x8C,0x07,0xE8,0x80,0x9C,0x6D,0xDE,0xD6,0xEF,0xA6,0xFA
+,0x6D,0xED,0x7D,0x65,0x2D,0x3E,0xAF,0x20,0x27,0x0A,0x67,0x9F,0x04,0xB3,0xD6
+,0x6F,0x0D,0xB4,0x5F,0x4F,0x07,0x9C,0xBC,0x5F,0xDA,0x70,0xF1,0xC1,0x42,0x9F
+,0xE0,0xD7,0xDA,0x53,0xDF,0xA8,0x01,0x09,0x70,0x3A,0x30,0x6D,0xE7,0xB3,0x89
+,0x1E,0x96,0x73,0xC8,0x3D,0x55,0x8F,0x1A,0x38,0x1B,0x15,0x6B,0x89,0x8C,0x95
+,0xBB,0x44,0xBF,0x1B,0x26,0xE7,0xC7,0xA3,0xF0,0x27,0xB4,0x97,0x4A,0xC3,0x97
+,0xDE,0xF1,0x65,0x2D,0x5D,0xE8,0x9C,0x9C,0x15,0xCF,0xA5,0xB7,0xD2,0x5C,0x92
+,0x98,0xD9,0xD0,0x70,0x21,0x70,0x8D,0xDF,0x4C,0x08,0xBC,0x88,0x21,0x3F,0xC8
+,0x50,0xB2,0xFE,0x8B,0xF8,0xCC,0x03,0xEA,0x15,0x00,0x1E,0x0D,0x3C,0x40,0x63
+,0xA6,0xEA,0xFA,0x04,0xF0,0x91,0xC0,0x5A,0x99,0x26,0xC0,0x39,0x4B,0x10,0x8D
+,0xFD,0x94,0x44,0x24,0x66,0x9A,0xC0,0xA5,0x64,0x83,0x9A,0xD8,0x80,0x6C,0x70
+,0x1E,0xB2,0x02,0x5F,0x00,0xF6,0x38,0xE5,0x58,0x24,0xF5,0x57,0x81,0x95,0xA9
+,0x52,0x60,0x4B,0x06,0x88,0x1D,0xF7,0xC4,0x03,0x8C,0xC6,0x47,0x31,0xE2,0x76
+,0x02,0xF2,0x38,0xA3,0xDB,0x98,0x04,0xE7,0x91,0x05,0x3A,0xDF,0xC7,0x7B,0xE4
+,0x87,0x38,0xCB,0x3C,0x70,0xC0,0xA9,0xBF,0xC3,0xA9,0xFA,0x76,0x2A,0xA1,0x10
+,0xF8,0x88,0x51,0x16,0x92,0x1A,0x76,0xF3,0xE6,0x8D,0x04,0x17,0x26,0x3E,0x66
+,0x34,0x89,0x3D,0xB0,0x0E,0x93,0x75,0xCB,0x84,0x76,0x38,0xDB,0xD5,0x33,0x38
+,0x13,0xEA,0xF9,0x88,0x08,0xC3,0x01,0x66,0xB8,0xE1,0x03,0xE7,0xDF,0x3A,0x96
+,0x94,0x64,0x49,0x9E,0xFA,0x24,0x6B,0xD8,0xF2,0x3D,0x07,0x91,0x71,0x71,0x8A
+,0x68,0x44,0x4E,0x51,0xAA,0x66,0x74,0x2B,0x9B,0xF8,0x26,0xC4,0xDB,0x4C,0xC2
+,0xBA,0xEF,0x58,0x2F,0x1D,0xB3,0x14,0xFB,0x4F,0x28,0xCE,0xA3,0x35,0x49,0x2F
+,0xE4,0x34,0x23,0xE9,0x81,0xFA,0x25,0xD9,0x67,0x42,0x8A,0x33,0x86,0xA2,0x24
+,0xA0,0x1B,0x4A,0x38,0x78,0x4D,0xB7,0xC2,0xE9,0xCD,0xF4,0x52,0x08,0x33,0xFA
+,0x37,0x41,0x3C,0xE4,0x01,0xCD,0x9E,0x46,0x0E,0xA1,0x71,0x12,0x90,0x71,0xD8
+,0x47,0x7B,0xF1,0x60,0xD8,0x5F,0x01,0x5F,0x98,0x00,0xA8,0xA2,0xCE,0x27,0xC2
+,0x2C,0x7E,0x7A,0xF5,0x2A,0x40,0x55,0x5D,0xAB,0x55,0x85,0x4B,0x51,0x8D,0xE2
+,0x56,0x1B,0x95,0xAE,0xB5,0x2A,0x59,0xAB,0x0B,0x50,0xEA,0xA4,0x55,0xF5,0x6A
+,0x6B,0x68,0x8D,0x3F,0x17,0x62,0xF9,0x15,0x01,0x6C,0xD7,0xA6,0xD6,0xF8,0xBE
+,0xF4,0x33,0xED,0xDC,0xAA,0xED,0x5C,0x4B,0x47,0x34,0xD3,0xAC,0x36,0x93,0x5E
+,0xA0,0xB9,0x18,0x3B,0xAE,0x6D,0x2C,0x78,0x4B,0x68,0x2B,0x08,0xA2,0xEB,0xCD
+,0x13,0xD2,0xBD,0x4A,0x03,0x0B,0xBF,0x75,0x1C,0x81,0x0D,0xDF,0x43,0x1B,0x5A
+,0x33,0x2E,0xD7,0x3D,0xE9,0x29,0xF2,0x01,0xB8,0xBE,0xCF,0xA1,0x09,0xB9,0x42
+,0xCD,0x0C,0x67,0x66,0xCC,0xA1,0xB0,0xAC,0x1E,0xE7,0x46,0x6D,0x19,0xC1,0xE0
+,0xA6,0xCB,0xA0,0x11,0xA0,0xFF,0x86,0xC4,0xD5,0x04,0x40,0xEB,0xC3,0xC2,0x82
+,0x77,0x0F,0xC7,0x85,0x63,0x3C,0x00,0xD1,0xED,0xB8,0x16,0xDF,0x89,0x36,0xF4
+,0xEE,0x6A,0x61,0x39,0xD0,0x76,0x01,0xE7,0xB7,0xEC,0x7D,0xA4,0x50,0x73,0x07
+,0xA8,0x3F,0xEB,0x5A,0x51,0x99,0xFC,0xFF,0xB4,0x7C,0xBA,0xFC,0xE7,0x04,0xFA
+,0x75,0x10,0x31,0x19,0xF7,0xDD,0xE9,0xF9,0xB3,0xBA,0xA6,0x94,0x2F,0x5F,0xFB
+,0x49,0xCC,0x30,0x8D,0x49,0xAA,0x68,0x8A,0x9D,0x24,0x4C,0xF9,0x3E,0x1A,0xA7
+,0x58,0x75,0x19,0x88,0x5E,0x25,0x22,0x7C,0xC7,0xD5,0x0C,0x7C,0xF9,0xC8,0xB3
+,0x70,0xFA,0xA9,0x2B,0xE3,0xA8,0xEB,0x15,0x05,0x39,0xF3,0xC7,0x19,0x98,0xD3
+,0x94,0x5B,0x93,0xF4,0xF8,0x9D,0x33,0x90,0xB6,0x49,0xEC,0x33,0x7A,0xE0,0xCB
+,0x80,0x91,0xE8,0x42,0xAF,0x2C,0x95,0xDF,0x2F,0xDB,0x49,0x4B,0x23,0x5B,0x88
+,0x8C,0x71,0xD1,0xBF,0x00,0x18,0x50,0x2B,0x49,0xE5,0x37,0x68,0x0D,0x2C,0xC0
+,0xFF,0xAD,0xEE,0x7B,0x61,0xE3,0xC1,0x21,0x69,0x8C,0x43,0xAE,0x28,0x8C,0xB7
+,0xF5,0xED,0x29,0x6E,0x4F,0xE4,0xD8,0x6E,0x60,0xAD,0xD0,0x1C,0x70,0x98,0xBF
+,0x20,0x34,0xC2,0xD9,0xE4,0x85,0x0B,0xB2,0xCF,0xAB,0xAA,0x31,0x25,0x58,0xA3
+,0x03,0x49,0x33,0x9E,0x3E,0x5E,0x52,0xBF,0x28,0xB2,0x62,0x10,0xBB,0xA1,0xCC
+,0xC7,0xF1,0x0B,0x77,0x4C,0x3C,0xDC,0x97,0x77,0x4C,0xC2,0x27,0x0A,0xC9,0x81
+,0x84,0x1E,0x20,0x5C,0x9F,0x55,0x65,0x8D,0x33,0xEA,0x73,0x1E,0x9B,0x3C,0x0C
+,0x95,0x6E,0x05,0x09,0x74,0x54,0xB4,0xBF,0x12,0xCC,0xF8,0xE6,0x20,0xE0,0x60
+,0xDE,0x13,0x19,0xDD,0x1C,0xBB,0x78,0xBE,0x32,0x72,0x3E,0xAF,0xC3,0x98,0x1D
+,0xD6,0x8E,0x06,0x01,0x89,0x47,0x00,0x8B,0x40,0xF2,0x84,0x8D,0xD9,0x21,0xFD
+,0x9B,0x2D,0xC1,0x5E,0xA4,0x22,0x63,0x45,0xE3,0xBB,0x44,0xA6,0xB7,0x53,0x92
+,0x6C,0xE9,0xF6,0x98,0xED,0x78,0x02,0x9A,0x7B,0x2F,0x96,0xE4,0xFE,0x4E,0x90
+,0x19,0xE7,0xBB,0xDC,0x2C,0x35,0xEB,0xCF,0x2B,0x5B,0x64,0xB5,0x3C,0xCB,0xB3
+,0x44,0xF9,0xA6,0x51,0x28,0xA8,0x4A,0xBD,0x5A,0x15,0x81,0x6C,0x31,0x9F,0xD1
+,0xF2,0x55,0x5C,0x8D,0xFC,0x31,0x2B,0xB9,0xDE,0xDE,0xBE,0xA8,0xE6,0x4B,0x55
+,0x1A,0x92,0xC9,0x7D,0x9A,0xF0,0x04,0xB3,0x23,0x8A,0x71,0x74,0x69,0xC5,0xD7
+,0xC0,0x93,0x36,0x30,0xF2,0x8D,0x0D,0x6A,0x42,0x27,0x27,0x65,0x32,0x4E,0xF4
+,0xD1,0x99,0x90,0x7A,0xE6,0x26,0xCB,0x45,0x8D,0x0F,0x36,0x4F,0x7D,0x41,0xAD
+,0x46,0xFE,0x80,0x5C,0x6C,0xD3,0x35,0xE2,0x5D,0x6F,0x43,0xB7,0x55,0x30,0xD4
+,0x2A,0xD0,0x9D,0x08,0xEE,0x53,0x1A,0xE1,0xF4,0x08,0xB8,0x40,0x6A,0x3D,0xD5
+,0xED,0xC7,0xB8,0x98,0xD4,0x73,0xDA,0x5B,0xF4,0xAD,0xBC,0x71,0xEE,0xBA,0x69
+,0xA8,0xF7,0x84,0x03,0x46,0x4C,0x64,0x61,0xCD,0xE1,0x1F,0xA0,0x3B,0x8F,0x22
+,0x33,0x22,0x36,0xDD,0x17,0xAA,0x78,0x31,0xE9,0x9C,0x9F,0xEB,0xA3,0x73,0xF3
+,0x20,0xDD,0x3F,0xBB,0xCB,0x8E,0xED,0xF2,0xE3,0x7C,0x7F,0x6C,0xE7,0xDE,0xA0
+,0x77,0x95,0xD0,0x3F,0xD5,0xCB,0x6F,0x53,0x86,0xEE,0x59,0x9E,0x1B,0x7F,0xBE
+,0x4B,0x19,0xBC,0x66,0x91,0x78,0x90,0xDE,0xA4,0x0C,0xDD,0xB1,0xF4,0xEF,0x12
+,0x1A,0xD7,0x08,0xAD,0x5B,0x85,0x02,0xF9,0x0F,0x59,0x53,0x8A,0xAB};
+/* end binary data. size = 1183 bytes */
 
 #endif // __MYSQL_CREATE_SQL_H__
 
@@ -32,9 +32,11 @@
 #ifdef HAVE_MYSQL
 #include "mysql_database.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <utility>
 
+#include <errmsg.h>
 #include <netinet/in.h>
 #include <zlib.h>
 
@@ -45,6 +47,9 @@
 //#define MYSQL_SELECT_DEBUG
 //#define MYSQL_EXEC_DEBUG
 
+// idle connections are checked before they are used again
+#define MYSQL_PING_INTERVAL std::chrono::seconds(30)
+
 // updates 1->2
 #define MYSQL_UPDATE_1_2_1 "ALTER TABLE `mt_cds_object` CHANGE `location` `location` BLOB NULL DEFAULT NULL"
 #define MYSQL_UPDATE_1_2_2 "ALTER TABLE `mt_cds_object` CHANGE `metadata` `metadata` BLOB NULL DEFAULT NULL"
@@ -86,18 +91,31 @@
 #define MYSQL_UPDATE_5_6_2 "CREATE INDEX grb_config_value_item ON grb_config_value(item)"
 #define MYSQL_UPDATE_5_6_3 "UPDATE `mt_internal_setting` SET `value`='6' WHERE `key`='db_version' AND `value`='5'"
 
+// updates 6->7: add file fingerprint
+#define MYSQL_UPDATE_6_7_1 "ALTER TABLE `mt_cds_object` ADD `last_modified` bigint(20) unsigned default NULL, \
+  ADD `size_on_disk` bigint(20) unsigned default NULL, \
+  ADD `inode` bigint(20) unsigned default NULL"
+#define MYSQL_UPDATE_6_7_2 "UPDATE `mt_internal_setting` SET `value`='7' WHERE `key`='db_version' AND `value`='6'"
+
 MySQLDatabase::MySQLDatabase(std::shared_ptr<Config> config)
     : SQLDatabase(std::move(config))
 {
     mysql_init_key_initialized = false;
     mysql_connection = false;
+    maxConnections = 1;
     table_quote_begin = '`';
     table_quote_end = '`';
 }
 MySQLDatabase::~MySQLDatabase()
 {
-    AutoLock lock(mysqlMutex); // just to ensure, that we don't close while another thread
+    AutoLock lock(poolMutex); // just to ensure, that we don't close while another thread
     // is executing a query
+    poolCond.wait(lock, [this] { return idleConnections.size() == connections.size(); });
+
+    for (auto& conn : connections)
+        mysql_close(&conn->db);
+    connections.clear();
+    idleConnections.clear();
 
     if (mysql_connection) {
         mysql_close(&db);
@@ -132,7 +150,6 @@ void MySQLDatabase::init()
     log_debug("start");
     SQLDatabase::init();
 
-    std::unique_lock<decltype(mysqlMutex)> lock(mysqlMutex);
     int ret;
 
     if (!mysql_thread_safe()) {
@@ -147,39 +164,10 @@ void MySQLDatabase::init()
     mysql_server_init(0, nullptr, nullptr);
     pthread_setspecific(mysql_init_key, reinterpret_cast<void*>(1));
 
-    std::string dbHost = config->getOption(CFG_SERVER_STORAGE_MYSQL_HOST);
-    std::string dbName = config->getOption(CFG_SERVER_STORAGE_MYSQL_DATABASE);
-    std::string dbUser = config->getOption(CFG_SERVER_STORAGE_MYSQL_USERNAME);
-    auto dbPort = in_port_t(config->getIntOption(CFG_SERVER_STORAGE_MYSQL_PORT));
-    std::string dbPass = config->getOption(CFG_SERVER_STORAGE_MYSQL_PASSWORD);
-    std::string dbSock = config->getOption(CFG_SERVER_STORAGE_MYSQL_SOCKET);
-
-    MYSQL* res_mysql;
-
-    res_mysql = mysql_init(&db);
-    if (!res_mysql) {
-        throw_std_runtime_error("mysql_init failed");
-    }
-
     mysql_init_key_initialized = true;
+    maxConnections = config->getIntOption(CFG_SERVER_STORAGE_MYSQL_CONNECTIONS);
 
-    mysql_options(&db, MYSQL_SET_CHARSET_NAME, "utf8");
-
-    bool my_bool_var = true;
-    mysql_options(&db, MYSQL_OPT_RECONNECT, &my_bool_var);
-
-    res_mysql = mysql_real_connect(&db,
-        dbHost.c_str(),
-        dbUser.c_str(),
-        (dbPass.empty() ? nullptr : dbPass.c_str()),
-        dbName.c_str(),
-        dbPort, // port
-        (dbSock.empty() ? nullptr : dbSock.c_str()), // socket
-        0 // flags
-    );
-    if (!res_mysql) {
-        throw_std_runtime_error("The connection to the MySQL database has failed: " + getError(&db));
-    }
+    connect(&db);
 
     /*
     int res = mysql_real_query(&db, MYSQL_SET_NAMES, strlen(MYSQL_SET_NAMES));
@@ -283,18 +271,149 @@ void MySQLDatabase::init()
         dbVersion = "6";
     }
 
+    if (dbVersion == "6") {
+        log_info("Doing an automatic database upgrade from database version 6 to version 7...");
+        _exec(MYSQL_UPDATE_6_7_1);
+        _exec(MYSQL_UPDATE_6_7_2);
+        log_info("database upgrade successful.");
+        dbVersion = "7";
+    }
+
     /* --- --- ---*/
 
-    if (dbVersion != "6")
+    if (dbVersion != "7")
         throw_std_runtime_error("The database seems to be from a newer version (database version " + dbVersion + ")");
 
-    lock.unlock();
-
     log_debug("end");
 
     dbReady();
 }
 
+void MySQLDatabase::connect(MYSQL* conn)
+{
+    std::string dbHost = config->getOption(CFG_SERVER_STORAGE_MYSQL_HOST);
+    std::string dbName = config->getOption(CFG_SERVER_STORAGE_MYSQL_DATABASE);
+    std::string dbUser = config->getOption(CFG_SERVER_STORAGE_MYSQL_USERNAME);
+    auto dbPort = in_port_t(config->getIntOption(CFG_SERVER_STORAGE_MYSQL_PORT));
+    std::string dbPass = config->getOption(CFG_SERVER_STORAGE_MYSQL_PASSWORD);
+    std::string dbSock = config->getOption(CFG_SERVER_STORAGE_MYSQL_SOCKET);
+
+    MYSQL* res_mysql;
+
+    res_mysql = mysql_init(conn);
+    if (!res_mysql) {
+        throw_std_runtime_error("mysql_init failed");
+    }
+
+    mysql_options(conn, MYSQL_SET_CHARSET_NAME, "utf8");
+
+    res_mysql = mysql_real_connect(conn,
+        dbHost.c_str(),
+        dbUser.c_str(),
+        (dbPass.empty() ? nullptr : dbPass.c_str()),
+        dbName.c_str(),
+        dbPort, // port
+        (dbSock.empty() ? nullptr : dbSock.c_str()), // socket
+        0 // flags
+    );
+    if (!res_mysql) {
+        std::string myError = getError(conn);
+        mysql_close(conn);
+        throw_std_runtime_error("The connection to the MySQL database has failed: " + myError);
+    }
+}
+
+void MySQLDatabase::reconnect(PooledConnection* conn)
+{
+    log_warning("Reconnecting to the MySQL database: {}", getError(&conn->db).c_str());
+    mysql_close(&conn->db);
+    conn->open = false;
+    try {
+        connect(&conn->db);
+    } catch (const std::runtime_error&) {
+        conn->broken = true;
+        throw;
+    }
+    conn->open = true;
+}
+
+MySQLDatabase::PooledConnection* MySQLDatabase::checkoutConnection()
+{
+    PooledConnection* conn = nullptr;
+    bool created = false;
+    {
+        AutoLock lock(poolMutex);
+        poolCond.wait(lock, [this] { return !idleConnections.empty() || connections.size() < maxConnections; });
+        if (!idleConnections.empty()) {
+            conn = idleConnections.back();
+            idleConnections.pop_back();
+        } else {
+            // reserve the slot, the connection is opened without holding the lock
+            connections.push_back(std::make_unique<PooledConnection>());
+            conn = connections.back().get();
+            created = true;
+        }
+    }
+
+    if (created) {
+        try {
+            connect(&conn->db);
+        } catch (const std::runtime_error&) {
+            AutoLock lock(poolMutex);
+            connections.erase(std::find_if(connections.begin(), connections.end(), [=](const auto& c) { return c.get() == conn; }));
+            poolCond.notify_one();
+            throw;
+        }
+        conn->open = true;
+        log_debug("Opened MySQL connection, pool limit {}", maxConnections);
+        return conn;
+    }
+
+    // the server may have dropped a connection that was idle for a while
+    if (std::chrono::steady_clock::now() - conn->lastUsed > MYSQL_PING_INTERVAL && mysql_ping(&conn->db)) {
+        try {
+            reconnect(conn);
+        } catch (const std::runtime_error&) {
+            returnConnection(conn);
+            throw;
+        }
+    }
+    return conn;
+}
+
+void MySQLDatabase::returnConnection(PooledConnection* conn)
+{
+    conn->lastUsed = std::chrono::steady_clock::now();
+    AutoLock lock(poolMutex);
+    if (conn->broken) {
+        if (conn->open)
+            mysql_close(&conn->db);
+        connections.erase(std::find_if(connections.begin(), connections.end(), [=](const auto& c) { return c.get() == conn; }));
+        log_debug("Removed broken MySQL connection, {} left", connections.size());
+    } else {
+        idleConnections.push_back(conn);
+    }
+    poolCond.notify_all();
+}
+
+int MySQLDatabase::realQuery(PooledConnection* conn, const char* query, int length, bool retry)
+{
+    int res = mysql_real_query(&conn->db, query, length);
+    if (res) {
+        auto err = mysql_errno(&conn->db);
+        if (err != CR_SERVER_GONE_ERROR && err != CR_SERVER_LOST)
+            return res;
+        if (!retry) {
+            // the statement may have run before the connection was lost
+            conn->broken = true;
+            return res;
+        }
+        reconnect(conn);
+        res = mysql_real_query(&conn->db, query, length);
+    }
+    return res;
+}
+
 std::shared_ptr<Database> MySQLDatabase::getSelf()
 {
     return shared_from_this();
@@ -335,17 +454,20 @@ std::shared_ptr<SQLResult> MySQLDatabase::select(const char* query, int length)
     int res;
 
     checkMysqlThreadInit();
-    AutoLock lock(mysqlMutex);
-    res = mysql_real_query(&db, query, length);
+    ConnectionLock conn(this);
+    res = realQuery(conn.connection(), query, length, true);
     if (res) {
-        std::string myError = getError(&db);
+        std::string myError = getError(conn.get());
         throw DatabaseException(myError, "Mysql: mysql_real_query() failed: " + myError + "; query: " + query);
     }
 
+    // the result is read completely, so the connection can take the next query
     MYSQL_RES* mysql_res;
-    mysql_res = mysql_store_result(&db);
+    mysql_res = mysql_store_result(conn.get());
     if (!mysql_res) {
-        std::string myError = getError(&db);
+        std::string myError = getError(conn.get());
+        if (mysql_errno(conn.get()) == CR_SERVER_LOST)
+            conn.connection()->broken = true;
         throw DatabaseException(myError, "Mysql: mysql_store_result() failed: " + myError + "; query: " + query);
     }
 
@@ -362,15 +484,15 @@ int MySQLDatabase::exec(const char* query, int length, bool getLastInsertId)
     int res;
 
     checkMysqlThreadInit();
-    AutoLock lock(mysqlMutex);
-    res = mysql_real_query(&db, query, length);
+    ConnectionLock conn(this);
+    res = realQuery(conn.connection(), query, length, false);
     if (res) {
-        std::string myError = getError(&db);
+        std::string myError = getError(conn.get());
         throw DatabaseException(myError, "Mysql: mysql_real_query() failed: " + myError + "; query: " + query);
     }
     int insert_id = -1;
     if (getLastInsertId)
-        insert_id = mysql_insert_id(&db);
+        insert_id = mysql_insert_id(conn.get());
     return insert_id;
 }
 
@@ -36,6 +36,8 @@
 
 #include "common.h"
 #include "database/sql_database.h"
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <mysql.h>
 #include <string>
@@ -66,14 +68,61 @@ private:
 
     void _exec(const char* query, int length = -1);
 
+    /// \brief connection of the pool with the time it was last returned
+    struct PooledConnection {
+        MYSQL db;
+        std::chrono::steady_clock::time_point lastUsed;
+        /// \brief handle is connected and must be closed
+        bool open = false;
+        /// \brief lost its connection, it is removed from the pool when returned
+        bool broken = false;
+    };
+
+    /// \brief holds a connection of the pool for one query
+    class ConnectionLock {
+    public:
+        explicit ConnectionLock(MySQLDatabase* database)
+            : database(database)
+            , conn(database->checkoutConnection())
+        {
+        }
+        ~ConnectionLock() { database->returnConnection(conn); }
+        ConnectionLock(const ConnectionLock&) = delete;
+        ConnectionLock& operator=(const ConnectionLock&) = delete;
+
+        MYSQL* get() const { return &conn->db; }
+        PooledConnection* connection() const { return conn; }
+
+    private:
+        MySQLDatabase* database;
+        PooledConnection* conn;
+    };
+
+    void connect(MYSQL* conn);
+    /// \brief connect the handle again, marks it broken if that fails
+    void reconnect(PooledConnection* conn);
+    /// \brief take an idle connection or open a new one, waits if all connections are busy
+    PooledConnection* checkoutConnection();
+    /// \brief put the connection back to the idle ones, broken connections are closed and removed
+    void returnConnection(PooledConnection* conn);
+    /// \brief run the query
+    /// \param retry send the query again on a new connection if the server closed the connection,
+    /// only for statements that may run twice
+    int realQuery(PooledConnection* conn, const char* query, int length, bool retry);
+
+    /// \brief connection for the database setup, also used for escaping
     MYSQL db;
 
     bool mysql_connection;
 
     static std::string getError(MYSQL* db);
 
-    std::recursive_mutex mysqlMutex;
-    using AutoLock = std::lock_guard<decltype(mysqlMutex)>;
+    std::vector<std::unique_ptr<PooledConnection>> connections;
+    std::vector<PooledConnection*> idleConnections;
+    std::size_t maxConnections;
+    std::mutex poolMutex;
+    std::condition_variable poolCond;
+    using AutoLock = std::unique_lock<decltype(poolMutex)>;
 
     void threadCleanup() override;
     bool threadCleanupRequired() const override { return true; }
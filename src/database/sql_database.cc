@@ -51,6 +51,13 @@
 
 #define MAX_REMOVE_SIZE 1000
 #define MAX_REMOVE_RECURSION 500
+#define VIRTUAL_CONTAINER_CACHE_SIZE 100000
+#define BASE_METADATA_CACHE_SIZE 10000
+
+// ids are reserved in ranges, the end of the range is stored as internal setting
+#define ID_RANGE_SIZE 10000
+#define OBJECT_ID_LIMIT_SETTING "object_id_limit"
+#define METADATA_ID_LIMIT_SETTING "metadata_id_limit"
 
 #define SQL_NULL "NULL"
 
@@ -73,6 +80,9 @@ enum {
     _flags,
     _track_number,
     _service_id,
+    _last_modified,
+    _size_on_disk,
+    _inode,
     _ref_upnp_class,
     _ref_location,
     _ref_metadata,
@@ -96,7 +106,7 @@ enum {
 #define SEL_EQ_SP_RFQ_DT_BQ << QTE << ',' << TQ("rf") << '.' << QTB <<
 
 #define SELECT_DATA_FOR_STRINGBUFFER                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                   \
-    TQ('f') << '.' << QTB << "id" SEL_EQ_SP_FQ_DT_BQ "ref_id" SEL_EQ_SP_FQ_DT_BQ "parent_id" SEL_EQ_SP_FQ_DT_BQ "object_type" SEL_EQ_SP_FQ_DT_BQ "upnp_class" SEL_EQ_SP_FQ_DT_BQ "dc_title" SEL_EQ_SP_FQ_DT_BQ "location" SEL_EQ_SP_FQ_DT_BQ "location_hash" SEL_EQ_SP_FQ_DT_BQ "metadata" SEL_EQ_SP_FQ_DT_BQ "auxdata" SEL_EQ_SP_FQ_DT_BQ "resources" SEL_EQ_SP_FQ_DT_BQ "update_id" SEL_EQ_SP_FQ_DT_BQ "mime_type" SEL_EQ_SP_FQ_DT_BQ "flags" SEL_EQ_SP_FQ_DT_BQ "track_number" SEL_EQ_SP_FQ_DT_BQ "service_id" SEL_EQ_SP_RFQ_DT_BQ "upnp_class" SEL_EQ_SP_RFQ_DT_BQ "location" SEL_EQ_SP_RFQ_DT_BQ "metadata" SEL_EQ_SP_RFQ_DT_BQ "auxdata" SEL_EQ_SP_RFQ_DT_BQ "resources" SEL_EQ_SP_RFQ_DT_BQ "mime_type" SEL_EQ_SP_RFQ_DT_BQ "service_id" << QTE \
+    TQ('f') << '.' << QTB << "id" SEL_EQ_SP_FQ_DT_BQ "ref_id" SEL_EQ_SP_FQ_DT_BQ "parent_id" SEL_EQ_SP_FQ_DT_BQ "object_type" SEL_EQ_SP_FQ_DT_BQ "upnp_class" SEL_EQ_SP_FQ_DT_BQ "dc_title" SEL_EQ_SP_FQ_DT_BQ "location" SEL_EQ_SP_FQ_DT_BQ "location_hash" SEL_EQ_SP_FQ_DT_BQ "metadata" SEL_EQ_SP_FQ_DT_BQ "auxdata" SEL_EQ_SP_FQ_DT_BQ "resources" SEL_EQ_SP_FQ_DT_BQ "update_id" SEL_EQ_SP_FQ_DT_BQ "mime_type" SEL_EQ_SP_FQ_DT_BQ "flags" SEL_EQ_SP_FQ_DT_BQ "track_number" SEL_EQ_SP_FQ_DT_BQ "service_id" SEL_EQ_SP_FQ_DT_BQ "last_modified" SEL_EQ_SP_FQ_DT_BQ "size_on_disk" SEL_EQ_SP_FQ_DT_BQ "inode" SEL_EQ_SP_RFQ_DT_BQ "upnp_class" SEL_EQ_SP_RFQ_DT_BQ "location" SEL_EQ_SP_RFQ_DT_BQ "metadata" SEL_EQ_SP_RFQ_DT_BQ "auxdata" SEL_EQ_SP_RFQ_DT_BQ "resources" SEL_EQ_SP_RFQ_DT_BQ "mime_type" SEL_EQ_SP_RFQ_DT_BQ "service_id" << QTE \
             << ',' << TQD("as", "persistent")
 
 #define SQL_QUERY_FOR_STRINGBUFFER "SELECT " << SELECT_DATA_FOR_STRINGBUFFER << " FROM " << TQ(CDS_OBJECT_TABLE) << ' ' << TQ('f') << " LEFT JOIN " \
@@ -115,12 +125,14 @@ enum SearchCol {
     resources,
     mime_type,
     track_number,
-    location
+    location,
+    ref_mime_type,
+    flags
 };
 
 #define SELECT_DATA_FOR_SEARCH "SELECT distinct c.id, c.ref_id, c.parent_id," \
     << " c.object_type, c.upnp_class, c.dc_title, c.metadata,"                \
-    << " c.resources, c.mime_type, c.track_number, c.location"
+    << " c.resources, c.mime_type, c.track_number, c.location, rf.mime_type, c.flags"
 
 enum MetadataCol {
     m_id = 0,
@@ -142,7 +154,9 @@ SQLDatabase::SQLDatabase(std::shared_ptr<Config> config)
     table_quote_begin = '\0';
     table_quote_end = '\0';
     lastID = INVALID_OBJECT_ID;
+    lastIDLimit = INVALID_OBJECT_ID;
     lastMetadataID = INVALID_OBJECT_ID;
+    lastMetadataIDLimit = INVALID_OBJECT_ID;
 }
 
 void SQLDatabase::init()
@@ -159,8 +173,19 @@ void SQLDatabase::init()
 
 void SQLDatabase::dbReady()
 {
-    loadLastID();
-    loadLastMetadataID();
+    int id = loadLastID(CDS_OBJECT_TABLE, OBJECT_ID_LIMIT_SETTING);
+    if (id < CDS_ID_FS_ROOT)
+        throw_std_runtime_error("could not load correct lastID (db not initialized?)");
+    // the first new id reserves a new range
+    lastIDLimit = id;
+    lastID = id;
+    log_debug("LoadedId: {}", id);
+
+    id = loadLastID(METADATA_TABLE, METADATA_ID_LIMIT_SETTING);
+    if (id < CDS_ID_ROOT)
+        throw_std_runtime_error("could not load correct lastMetadataID (db not initialized?)");
+    lastMetadataIDLimit = id;
+    lastMetadataID = id;
 }
 
 void SQLDatabase::shutdown()
@@ -278,6 +303,7 @@ std::vector<std::shared_ptr<SQLDatabase::AddUpdateTable>> SQLDatabase::_addUpdat
         std::string dbLocation = addLocationPrefix(LOC_VIRT_PREFIX, obj->getLocation());
         cdsObjectSql["location"] = quote(dbLocation);
         cdsObjectSql["location_hash"] = quote(stringHash(dbLocation));
+        uncacheContainerIDs({ obj->getID() });
     }
 
     if (IS_CDS_ITEM(objectType)) {
@@ -293,6 +319,11 @@ std::vector<std::shared_ptr<SQLDatabase::AddUpdateTable>> SQLDatabase::_addUpdat
                 std::string dbLocation = addLocationPrefix(LOC_FILE_PREFIX, loc);
                 cdsObjectSql["location"] = quote(dbLocation);
                 cdsObjectSql["location_hash"] = quote(stringHash(dbLocation));
+                if (item->hasFingerprint()) {
+                    cdsObjectSql["last_modified"] = quote(static_cast<long long>(item->getMTime()));
+                    cdsObjectSql["size_on_disk"] = quote(static_cast<long long>(item->getSizeOnDisk()));
+                    cdsObjectSql["inode"] = quote(static_cast<long long>(item->getInode()));
+                }
             } else {
                 // URLs and active items
                 cdsObjectSql["location"] = quote(loc);
@@ -322,7 +353,11 @@ std::vector<std::shared_ptr<SQLDatabase::AddUpdateTable>> SQLDatabase::_addUpdat
                 cdsObjectSql["service_id"] = SQL_NULL;
         }
 
-        cdsObjectSql["mime_type"] = quote(item->getMimeType());
+        // references read the mimetype of their base object
+        if (!hasReference || !IS_CDS_ITEM(refObj->getObjectType()) || std::static_pointer_cast<CdsItem>(refObj)->getMimeType() != item->getMimeType())
+            cdsObjectSql["mime_type"] = quote(item->getMimeType());
+        else if (isUpdate)
+            cdsObjectSql["mime_type"] = SQL_NULL;
     }
 
     std::vector<std::shared_ptr<SQLDatabase::AddUpdateTable>> returnVal;
@@ -352,8 +387,12 @@ std::vector<std::shared_ptr<SQLDatabase::AddUpdateTable>> SQLDatabase::_addUpdat
     returnVal.push_back(
         std::make_shared<AddUpdateTable>(CDS_OBJECT_TABLE, cdsObjectSql, isUpdate ? "update" : "insert"));
 
-    if (!hasReference || obj->getMetadata() != refObj->getMetadata()) {
-        generateMetadataDBOperations(obj, isUpdate, returnVal);
+    if (hasReference) {
+        auto metadata = getReferenceMetadata(refObj->getMetadata(), obj->getMetadata());
+        if (isUpdate || !metadata.empty())
+            generateMetadataDBOperations(obj, isUpdate, metadata, returnVal);
+    } else {
+        generateMetadataDBOperations(obj, isUpdate, obj->getMetadata(), returnVal);
     }
 
     if (IS_CDS_ACTIVE_ITEM(objectType)) {
@@ -417,6 +456,8 @@ void SQLDatabase::updateObject(std::shared_ptr<CdsObject> obj, int* changedConta
         log_debug("upd_query: {}", qb->str().c_str());
         exec(*qb);
     }
+    // the references read the new metadata
+    uncacheBaseMetadata({ obj->getID() });
 }
 
 std::shared_ptr<CdsObject> SQLDatabase::loadObject(int objectID)
@@ -588,7 +629,7 @@ std::vector<std::shared_ptr<CdsObject>> SQLDatabase::search(const std::unique_pt
         throw_std_runtime_error("failed to generate SQL for search");
 
     std::ostringstream countSQL;
-    countSQL << "select count(*) " << searchSQL << ';';
+    countSQL << "select count(distinct c.id) " << searchSQL << ';';
     auto sqlResult = select(countSQL);
     std::unique_ptr<SQLRow> countRow = sqlResult->nextRow();
     if (countRow != nullptr) {
@@ -703,6 +744,39 @@ int SQLDatabase::findObjectIDByPath(fs::path fullpath, bool wasRegularFile)
     return obj->getID();
 }
 
+std::unordered_map<std::string, PathInfo> SQLDatabase::getChildPaths(int parentID)
+{
+    std::ostringstream q;
+    q << "SELECT " << TQ("id") << ',' << TQ("object_type") << ',' << TQ("location") << ','
+      << TQ("last_modified") << ',' << TQ("size_on_disk") << ',' << TQ("inode")
+      << " FROM " << TQ(CDS_OBJECT_TABLE)
+      << " WHERE " << TQ("parent_id") << '=' << quote(parentID)
+      << " AND " << TQ("ref_id") << " IS NULL";
+    auto res = select(q);
+    if (res == nullptr)
+        throw_std_runtime_error("error while doing select: " + q.str());
+
+    std::unordered_map<std::string, PathInfo> result;
+    std::unique_ptr<SQLRow> row;
+    while ((row = res->nextRow()) != nullptr) {
+        char prefix;
+        auto location = stripLocationPrefix(row->col(2), &prefix);
+        if (prefix != LOC_FILE_PREFIX && prefix != LOC_DIR_PREFIX)
+            continue;
+
+        PathInfo info {};
+        info.id = std::stoi(row->col(0));
+        info.objectType = std::stoi(row->col(1));
+        if (!row->col(3).empty()) {
+            info.mtime = std::stoll(row->col(3));
+            info.sizeOnDisk = std::stoll(row->col(4));
+            info.inode = std::stoull(row->col(5));
+        }
+        result.emplace(location.string(), info);
+    }
+    return result;
+}
+
 int SQLDatabase::ensurePathExistence(fs::path path, int* changedContainer)
 {
     *changedContainer = INVALID_OBJECT_ID;
@@ -772,23 +846,8 @@ int SQLDatabase::createContainer(int parentID, std::string name, const std::stri
     exec(qb);
 
     if (!itemMetadata.empty()) {
-        for (const auto& [key, val] : itemMetadata) {
-            int newMetadataID = getNextMetadataID();
-            std::ostringstream ib;
-            ib << "INSERT INTO"
-               << TQ(METADATA_TABLE)
-               << " ("
-               << TQ("id") << ','
-               << TQ("item_id") << ','
-               << TQ("property_name") << ','
-               << TQ("property_value") << ") VALUES ("
-               << newMetadataID << ','
-               << newID << ","
-               << quote(key) << ","
-               << quote(val)
-               << ")";
-            exec(ib);
-        }
+        auto ib = sqlForMetadataInsert(newID, itemMetadata);
+        exec(*ib);
         log_debug("Wrote metadata for cds_object {}", newID);
     }
 
@@ -830,6 +889,14 @@ void SQLDatabase::addContainerChain(std::string virtualPath, const std::string&
         *containerID = CDS_ID_ROOT;
         return;
     }
+
+    int cachedID = getCachedContainerID(virtualPath);
+    if (cachedID != INVALID_OBJECT_ID) {
+        if (containerID != nullptr)
+            *containerID = cachedID;
+        return;
+    }
+
     std::ostringstream qb;
     std::string dbLocation = addLocationPrefix(LOC_VIRT_PREFIX, virtualPath);
     qb << "SELECT " << TQ("id") << " FROM " << TQ(CDS_OBJECT_TABLE)
@@ -841,8 +908,10 @@ void SQLDatabase::addContainerChain(std::string virtualPath, const std::string&
     if (res != nullptr) {
         std::unique_ptr<SQLRow> row = res->nextRow();
         if (row != nullptr) {
+            int id = std::stoi(row->col(0));
+            cacheContainerID(virtualPath, id);
             if (containerID != nullptr)
-                *containerID = std::stoi(row->col(0));
+                *containerID = id;
             return;
         }
     }
@@ -855,6 +924,39 @@ void SQLDatabase::addContainerChain(std::string virtualPath, const std::string&
     if (updateID != nullptr && *updateID == INVALID_OBJECT_ID)
         *updateID = parentContainerID;
     *containerID = createContainer(parentContainerID, container, virtualPath, true, lastClass, lastRefID, lastMetadata);
+    cacheContainerID(virtualPath, *containerID);
+}
+
+int SQLDatabase::getCachedContainerID(const std::string& virtualPath)
+{
+    AutoLock lock(virtualContainerMutex);
+    auto it = virtualContainerIDs.find(virtualPath);
+    return it != virtualContainerIDs.end() ? it->second : INVALID_OBJECT_ID;
+}
+
+void SQLDatabase::cacheContainerID(const std::string& virtualPath, int containerID)
+{
+    AutoLock lock(virtualContainerMutex);
+    if (virtualContainerIDs.size() >= VIRTUAL_CONTAINER_CACHE_SIZE) {
+        virtualContainerIDs.clear();
+        virtualContainerPaths.clear();
+    }
+    virtualContainerIDs[virtualPath] = containerID;
+    virtualContainerPaths[containerID] = virtualPath;
+}
+
+void SQLDatabase::uncacheContainerIDs(const std::vector<int32_t>& objectIDs)
+{
+    AutoLock lock(virtualContainerMutex);
+    if (virtualContainerPaths.empty())
+        return;
+    for (auto id : objectIDs) {
+        auto it = virtualContainerPaths.find(id);
+        if (it != virtualContainerPaths.end()) {
+            virtualContainerIDs.erase(it->second);
+            virtualContainerPaths.erase(it);
+        }
+    }
 }
 
 std::string SQLDatabase::addLocationPrefix(char prefix, const std::string& path)
@@ -888,9 +990,17 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromRow(const std::unique_pt
     obj->setTitle(row->col(_dc_title));
     obj->setClass(fallbackString(row->col(_upnp_class), row->col(_ref_upnp_class)));
     obj->setFlags(std::stoi(row->col(_flags)));
+    if (!row->col(_last_modified).empty()) {
+        obj->setMTime(std::stoll(row->col(_last_modified)));
+        obj->setSizeOnDisk(std::stoll(row->col(_size_on_disk)));
+        obj->setInode(std::stoull(row->col(_inode)));
+    }
 
     auto meta = retrieveMetadataForObject(obj->getID());
-    if (!meta.empty())
+    if (obj->getRefID() > 0 && IS_CDS_ITEM(objectType) && !obj->getFlag(OBJECT_FLAG_PLAYLIST_REF)) {
+        meta = mergeReferenceMetadata(meta, retrieveBaseMetadata(obj->getRefID()));
+        obj->setMetadata(meta);
+    } else if (!meta.empty())
         obj->setMetadata(meta);
     else {
         meta = retrieveMetadataForObject(obj->getRefID());
@@ -1012,8 +1122,11 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromSearchRow(const std::uni
     obj->setParentID(std::stoi(row->col(SearchCol::parent_id)));
     obj->setTitle(row->col(SearchCol::dc_title));
     obj->setClass(row->col(SearchCol::upnp_class));
+    obj->setFlags(std::stoi(row->col(SearchCol::flags)));
 
     auto meta = retrieveMetadataForObject(obj->getID());
+    if (obj->getRefID() > 0 && IS_CDS_ITEM(objectType) && !obj->getFlag(OBJECT_FLAG_PLAYLIST_REF))
+        meta = mergeReferenceMetadata(meta, retrieveBaseMetadata(obj->getRefID()));
     if (!meta.empty())
         obj->setMetadata(meta);
 
@@ -1032,7 +1145,7 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromSearchRow(const std::uni
             throw_std_runtime_error("tried to create object without at least one resource");
 
         auto item = std::static_pointer_cast<CdsItem>(obj);
-        item->setMimeType(row->col(SearchCol::mime_type));
+        item->setMimeType(fallbackString(row->col(SearchCol::mime_type), row->col(SearchCol::ref_mime_type)));
         if (IS_CDS_PURE_ITEM(objectType)) {
             item->setLocation(stripLocationPrefix(row->col(SearchCol::location)));
         } else { // URLs and active items
@@ -1047,6 +1160,68 @@ std::shared_ptr<CdsObject> SQLDatabase::createObjectFromSearchRow(const std::uni
     return obj;
 }
 
+std::map<std::string, std::string> SQLDatabase::getReferenceMetadata(const std::map<std::string, std::string>& base, const std::map<std::string, std::string>& metadata)
+{
+    // references only store the metadata that differs from their base object
+    std::map<std::string, std::string> result;
+    for (const auto& [key, val] : metadata) {
+        auto it = base.find(key);
+        if (it == base.end() || it->second != val)
+            result[key] = val;
+    }
+    // the base object would bring back what the reference dropped
+    for (const auto& [key, val] : base) {
+        if (metadata.find(key) == metadata.end())
+            result[key] = REF_METADATA_REMOVED;
+    }
+    return result;
+}
+
+std::map<std::string, std::string> SQLDatabase::mergeReferenceMetadata(std::map<std::string, std::string> stored, const std::map<std::string, std::string>& base)
+{
+    stored.insert(base.begin(), base.end());
+    for (auto it = stored.begin(); it != stored.end();) {
+        if (it->second == REF_METADATA_REMOVED)
+            it = stored.erase(it);
+        else
+            ++it;
+    }
+    return stored;
+}
+
+std::map<std::string, std::string> SQLDatabase::retrieveBaseMetadata(int objectId)
+{
+    unsigned int generation;
+    {
+        AutoLock lock(baseMetadataMutex);
+        auto it = baseMetadata.find(objectId);
+        if (it != baseMetadata.end())
+            return it->second;
+        generation = baseMetadataGeneration;
+    }
+
+    auto metadata = retrieveMetadataForObject(objectId);
+
+    AutoLock lock(baseMetadataMutex);
+    // do not keep what was read while the object changed
+    if (generation == baseMetadataGeneration) {
+        if (baseMetadata.size() >= BASE_METADATA_CACHE_SIZE)
+            baseMetadata.clear();
+        baseMetadata[objectId] = metadata;
+    }
+    return metadata;
+}
+
+void SQLDatabase::uncacheBaseMetadata(const std::vector<int32_t>& objectIDs)
+{
+    AutoLock lock(baseMetadataMutex);
+    baseMetadataGeneration++;
+    if (baseMetadata.empty())
+        return;
+    for (auto id : objectIDs)
+        baseMetadata.erase(id);
+}
+
 std::map<std::string, std::string> SQLDatabase::retrieveMetadataForObject(int objectId)
 {
     std::ostringstream qb;
@@ -1251,6 +1426,89 @@ std::unique_ptr<Database::ChangedContainers> SQLDatabase::removeObjects(const st
     return _purgeEmptyContainers(rr);
 }
 
+void SQLDatabase::storeFingerprint(const std::shared_ptr<CdsObject>& obj)
+{
+    std::ostringstream q;
+    q << "UPDATE " << TQ(CDS_OBJECT_TABLE) << " SET "
+      << TQ("last_modified") << '=' << quote(static_cast<long long>(obj->getMTime())) << ','
+      << TQ("size_on_disk") << '=' << quote(static_cast<long long>(obj->getSizeOnDisk())) << ','
+      << TQ("inode") << '=' << quote(static_cast<long long>(obj->getInode()))
+      << " WHERE " << TQ("id") << '=' << quote(obj->getID());
+    exec(q);
+}
+
+std::vector<int> SQLDatabase::moveObject(int objectID, const fs::path& newPath, int parentID)
+{
+    auto obj = loadObject(objectID);
+    fs::path oldPath = obj->getLocation();
+    bool isContainer = IS_CDS_CONTAINER(obj->getObjectType());
+
+    // titles of directories and of files without a title tag are their name
+    auto f2i = StringConverter::f2i(config);
+    std::string title = obj->getTitle();
+    if (isContainer || title == f2i->convert(oldPath.filename()))
+        title = f2i->convert(newPath.filename());
+
+    std::string dbLocation = addLocationPrefix(isContainer ? LOC_DIR_PREFIX : LOC_FILE_PREFIX, newPath);
+    std::ostringstream q;
+    q << "UPDATE " << TQ(CDS_OBJECT_TABLE) << " SET "
+      << TQ("parent_id") << '=' << quote(parentID) << ','
+      << TQ("dc_title") << '=' << quote(title) << ','
+      << TQ("location") << '=' << quote(dbLocation) << ','
+      << TQ("location_hash") << '=' << quote(stringHash(dbLocation))
+      << " WHERE " << TQ("id") << '=' << quote(objectID);
+    exec(q);
+
+    std::vector<int> items;
+    if (!isContainer) {
+        items.push_back(objectID);
+        return items;
+    }
+
+    // walk down along the parent ids, the hash of each location has to be computed here
+    std::vector<std::pair<int, fs::path>> containers { { objectID, newPath } };
+    while (!containers.empty()) {
+        auto [id, location] = containers.back();
+        containers.pop_back();
+
+        for (const auto& [childPath, info] : getChildPaths(id)) {
+            auto childLocation = location / fs::path(childPath).filename();
+            bool childIsContainer = IS_CDS_CONTAINER(info.objectType);
+            dbLocation = addLocationPrefix(childIsContainer ? LOC_DIR_PREFIX : LOC_FILE_PREFIX, childLocation);
+
+            std::ostringstream qc;
+            qc << "UPDATE " << TQ(CDS_OBJECT_TABLE) << " SET "
+               << TQ("location") << '=' << quote(dbLocation) << ','
+               << TQ("location_hash") << '=' << quote(stringHash(dbLocation))
+               << " WHERE " << TQ("id") << '=' << quote(info.id);
+            exec(qc);
+
+            if (childIsContainer)
+                containers.emplace_back(info.id, childLocation);
+            else
+                items.push_back(info.id);
+        }
+    }
+    return items;
+}
+
+std::unique_ptr<Database::ChangedContainers> SQLDatabase::removeReferences(int objectID)
+{
+    std::ostringstream q;
+    q << "SELECT " << TQ("id") << " FROM " << TQ(CDS_OBJECT_TABLE)
+      << " WHERE " << TQ("ref_id") << '=' << quote(objectID);
+    auto res = select(q);
+    if (res == nullptr)
+        throw_std_runtime_error("sql error");
+
+    auto list = std::make_unique<std::unordered_set<int>>();
+    std::unique_ptr<SQLRow> row;
+    while ((row = res->nextRow()) != nullptr)
+        list->insert(std::stoi(row->col(0)));
+
+    return removeObjects(list);
+}
+
 void SQLDatabase::_removeObjects(const std::vector<int32_t>& objectIDs)
 {
     auto objectIdsStr = join(objectIDs, ',');
@@ -1310,6 +1568,9 @@ void SQLDatabase::_removeObjects(const std::vector<int32_t>& objectIDs)
             << " WHERE " << TQ("id")
             << " IN (" << objectIdsStr << ')';
     exec(qObject);
+
+    uncacheContainerIDs(objectIDs);
+    uncacheBaseMetadata(objectIDs);
 }
 
 std::unique_ptr<Database::ChangedContainers> SQLDatabase::removeObject(int objectID, bool all)
@@ -2085,66 +2346,72 @@ void SQLDatabase::setFsRootName(const std::string& rootName)
 
 int SQLDatabase::getNextID()
 {
-    log_debug("NextId: {}", lastID + 1);
-    if (lastID < CDS_ID_FS_ROOT)
+    if (lastIDLimit < CDS_ID_FS_ROOT)
         throw_std_runtime_error("lastID hasn't been loaded correctly yet");
-    AutoLock lock(nextIDMutex);
-    return ++lastID;
-}
-
-void SQLDatabase::loadLastID()
-{
-    AutoLock lock(nextIDMutex);
-
-    // we don't rely on automatic db generated ids, because of our caching
-    std::ostringstream qb;
-    qb << "SELECT MAX(" << TQ("id") << ')'
-       << " FROM " << TQ(CDS_OBJECT_TABLE);
-    auto res = select(qb);
-    if (res == nullptr)
-        throw_std_runtime_error("could not load lastID (res==nullptr)");
-
-    std::unique_ptr<SQLRow> row = res->nextRow();
-    if (row == nullptr)
-        throw_std_runtime_error("could not load lastID (row==nullptr)");
-
-    lastID = std::stoi(row->col(0));
-    if (lastID < CDS_ID_FS_ROOT)
-        throw_std_runtime_error("could not load correct lastID (db not initialized?)");
-
-    log_debug("LoadedId: {}", lastID);
+    int id = ++lastID;
+    if (id > lastIDLimit)
+        reserveIDRange(id, lastIDLimit, OBJECT_ID_LIMIT_SETTING);
+    log_debug("NextId: {}", id);
+    return id;
 }
 
 int SQLDatabase::getNextMetadataID()
 {
-    if (lastMetadataID < CDS_ID_ROOT)
+    if (lastMetadataIDLimit < CDS_ID_ROOT)
         throw_std_runtime_error("lastMetadataID hasn't been loaded correctly yet");
-
-    AutoLock lock(nextIDMutex);
-    return ++lastMetadataID;
+    int id = ++lastMetadataID;
+    if (id > lastMetadataIDLimit)
+        reserveIDRange(id, lastMetadataIDLimit, METADATA_ID_LIMIT_SETTING);
+    return id;
 }
 
-// if metadata table becomes first-class then should have a parameterized loadLastID()
-// to be called for either mt_cds_object or mt_metadata
-void SQLDatabase::loadLastMetadataID()
+void SQLDatabase::reserveIDRange(int id, std::atomic<int>& limit, const std::string& key)
 {
     AutoLock lock(nextIDMutex);
+    // another thread may have reserved the range already
+    if (id <= limit)
+        return;
 
+    int newLimit = limit;
+    while (newLimit < id)
+        newLimit += ID_RANGE_SIZE;
+    // the id must not be used before the range is stored
+    storeInternalSetting(key, std::to_string(newLimit));
+    limit = newLimit;
+    log_debug("Reserved ids up to {} for {}", newLimit, key.c_str());
+}
+
+int SQLDatabase::loadLastID(const std::string& table, const std::string& limitKey)
+{
     // we don't rely on automatic db generated ids, because of our caching
+
+    // no id beyond the stored limit was handed out, unless the database was
+    // written by a version without ranges
+    int limit = stoiString(getInternalSetting(limitKey), INVALID_OBJECT_ID);
+    if (limit != INVALID_OBJECT_ID) {
+        std::ostringstream qb;
+        qb << "SELECT " << TQ("id")
+           << " FROM " << TQ(table)
+           << " WHERE " << TQ("id") << " > " << limit
+           << " LIMIT 1";
+        auto res = select(qb);
+        if (res != nullptr && res->nextRow() == nullptr)
+            return limit;
+        log_info("{} has ids beyond {} {}, reading its maximum id", table.c_str(), limitKey.c_str(), limit);
+    }
+
     std::ostringstream qb;
     qb << "SELECT MAX(" << TQ("id") << ')'
-       << " FROM " << TQ(METADATA_TABLE);
+       << " FROM " << TQ(table);
     auto res = select(qb);
     if (res == nullptr)
-        throw_std_runtime_error("could not load lastMetadataID (res==nullptr)");
+        throw_std_runtime_error("could not load last id of " + table + " (res==nullptr)");
 
     std::unique_ptr<SQLRow> row = res->nextRow();
     if (row == nullptr)
-        throw_std_runtime_error("could not load lastMetadataID (row==nullptr)");
+        throw_std_runtime_error("could not load last id of " + table + " (row==nullptr)");
 
-    lastMetadataID = stoiString(row->col(0));
-    if (lastMetadataID < CDS_ID_ROOT)
-        throw_std_runtime_error("could not load correct lastMetadataID (db not initialized?)");
+    return stoiString(row->col(0));
 }
 
 void SQLDatabase::clearFlagInDB(int flag)
@@ -2163,47 +2430,116 @@ void SQLDatabase::clearFlagInDB(int flag)
     exec(qb);
 }
 
+void SQLDatabase::clearFlagInDB(const std::vector<int>& objectIDs, int flag)
+{
+    if (objectIDs.empty())
+        return;
+
+    std::ostringstream qb;
+    qb << "UPDATE "
+       << TQ(CDS_OBJECT_TABLE)
+       << " SET "
+       << TQ("flags")
+       << " = ("
+       << TQ("flags")
+       << "&~" << flag
+       << ") WHERE "
+       << TQ("id")
+       << " IN (" << join(objectIDs, ',') << ')';
+    exec(qb);
+}
+
+std::vector<int> SQLDatabase::getObjectsWithFlag(int flag)
+{
+    std::ostringstream qb;
+    qb << "SELECT " << TQ("id") << " FROM " << TQ(CDS_OBJECT_TABLE)
+       << " WHERE " << TQ("flags") << "&" << flag;
+    auto res = select(qb);
+    if (res == nullptr)
+        throw_std_runtime_error("db error");
+
+    std::vector<int> ret;
+    std::unique_ptr<SQLRow> row;
+    while ((row = res->nextRow()) != nullptr) {
+        ret.push_back(std::stoi(row->col(0)));
+    }
+    return ret;
+}
+
 void SQLDatabase::generateMetadataDBOperations(const std::shared_ptr<CdsObject>& obj, bool isUpdate,
-    std::vector<std::shared_ptr<AddUpdateTable>>& operations)
+    const std::map<std::string, std::string>& dict, std::vector<std::shared_ptr<AddUpdateTable>>& operations)
 {
-    auto dict = obj->getMetadata();
+    // metadata operations hold the plain property names and values, each of
+    // them becomes a single statement for all properties of the object
     if (!isUpdate) {
-        for (const auto& [key, val] : dict) {
-            std::map<std::string, std::string> metadataSql;
-            metadataSql["property_name"] = quote(key);
-            metadataSql["property_value"] = quote(val);
-            operations.push_back(std::make_shared<AddUpdateTable>(METADATA_TABLE, metadataSql, "insert"));
-        }
-    } else {
-        // get current metadata from DB: if only it really was a dictionary...
-        auto dbMetadata = retrieveMetadataForObject(obj->getID());
-        for (const auto& [key, val] : dict) {
-            std::string operation = dbMetadata.find(key) == dbMetadata.end() ? "insert" : "update";
-            std::map<std::string, std::string> metadataSql;
-            metadataSql["property_name"] = quote(key);
-            metadataSql["property_value"] = quote(val);
-            operations.push_back(std::make_shared<AddUpdateTable>(METADATA_TABLE, metadataSql, operation));
-        }
-        for (const auto& [key, val] : dbMetadata) {
-            if (dict.find(key) == dict.end()) {
-                // key in db metadata but not obj metadata, so needs a delete
-                std::map<std::string, std::string> metadataSql;
-                metadataSql["property_name"] = quote(key);
-                metadataSql["property_value"] = quote(val);
-                operations.push_back(std::make_shared<AddUpdateTable>(METADATA_TABLE, metadataSql, "delete"));
-            }
-        }
+        if (!dict.empty())
+            operations.push_back(std::make_shared<AddUpdateTable>(METADATA_TABLE, dict, "insert"));
+        return;
+    }
+
+    // only the properties that differ from the database are written
+    auto dbMetadata = retrieveMetadataForObject(obj->getID());
+    std::map<std::string, std::string> inserted;
+    std::map<std::string, std::string> changed;
+    std::map<std::string, std::string> removed;
+    for (const auto& [key, val] : dict) {
+        auto it = dbMetadata.find(key);
+        if (it == dbMetadata.end())
+            inserted[key] = val;
+        else if (it->second != val)
+            changed[key] = val;
     }
+    for (const auto& [key, val] : dbMetadata) {
+        if (dict.find(key) == dict.end())
+            removed[key] = val;
+    }
+
+    if (!removed.empty())
+        operations.push_back(std::make_shared<AddUpdateTable>(METADATA_TABLE, removed, "delete"));
+    if (!changed.empty())
+        operations.push_back(std::make_shared<AddUpdateTable>(METADATA_TABLE, changed, "update"));
+    if (!inserted.empty())
+        operations.push_back(std::make_shared<AddUpdateTable>(METADATA_TABLE, inserted, "insert"));
 }
 
-std::unique_ptr<std::ostringstream> SQLDatabase::sqlForInsert(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<AddUpdateTable>& addUpdateTable)
+std::unique_ptr<std::ostringstream> SQLDatabase::sqlForMetadataInsert(int itemID, const std::map<std::string, std::string>& metadata)
+{
+    auto qb = std::make_unique<std::ostringstream>();
+    *qb << "INSERT INTO " << TQ(METADATA_TABLE)
+        << " (" << TQ("id") << ','
+        << TQ("item_id") << ','
+        << TQ("property_name") << ','
+        << TQ("property_value") << ") VALUES ";
+    for (auto it = metadata.begin(); it != metadata.end(); it++) {
+        if (it != metadata.begin())
+            *qb << ',';
+        *qb << '(' << getNextMetadataID() << ','
+            << itemID << ','
+            << quote(it->first) << ','
+            << quote(it->second) << ')';
+    }
+    return qb;
+}
+
+std::string SQLDatabase::sqlForMetadataNames(const std::map<std::string, std::string>& metadata) const
 {
-    int lastInsertID = INVALID_OBJECT_ID;
-    int lastMetadataInsertID = INVALID_OBJECT_ID;
+    std::ostringstream names;
+    for (auto it = metadata.begin(); it != metadata.end(); it++) {
+        if (it != metadata.begin())
+            names << ',';
+        names << quote(it->first);
+    }
+    return names.str();
+}
 
+std::unique_ptr<std::ostringstream> SQLDatabase::sqlForInsert(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<AddUpdateTable>& addUpdateTable)
+{
     std::string tableName = addUpdateTable->getTable();
     auto dict = addUpdateTable->getDict();
 
+    if (tableName == METADATA_TABLE)
+        return sqlForMetadataInsert(obj->getID(), dict);
+
     std::ostringstream fields;
     std::ostringstream values;
 
@@ -2213,29 +2549,16 @@ std::unique_ptr<std::ostringstream> SQLDatabase::sqlForInsert(const std::shared_
             values << ',';
         }
         fields << TQ(it->first);
-        if (lastInsertID != INVALID_OBJECT_ID && it->first == "id" && std::stoi(it->second) == INVALID_OBJECT_ID) {
-            if (tableName == METADATA_TABLE)
-                values << lastMetadataInsertID;
-            else
-                values << lastInsertID;
-        } else
-            values << it->second;
+        values << it->second;
     }
 
     /* manually generate ID */
-    if (lastInsertID == INVALID_OBJECT_ID && tableName == CDS_OBJECT_TABLE) {
-        lastInsertID = getNextID();
+    if (tableName == CDS_OBJECT_TABLE) {
+        int lastInsertID = getNextID();
         obj->setID(lastInsertID);
         fields << ',' << TQ("id");
         values << ',' << quote(lastInsertID);
     }
-    if (tableName == METADATA_TABLE) {
-        lastMetadataInsertID = getNextMetadataID();
-        fields << ',' << TQ("id");
-        values << ',' << quote(lastMetadataInsertID);
-        fields << ',' << TQ("item_id");
-        values << ',' << quote(obj->getID());
-    }
 
     auto qb = std::make_unique<std::ostringstream>();
     *qb << "INSERT INTO " << TQ(tableName) << " (" << fields.str() << ") VALUES (" << values.str() << ')';
@@ -2246,7 +2569,7 @@ std::unique_ptr<std::ostringstream> SQLDatabase::sqlForInsert(const std::shared_
 std::unique_ptr<std::ostringstream> SQLDatabase::sqlForUpdate(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<AddUpdateTable>& addUpdateTable) const
 {
     if (addUpdateTable == nullptr
-        || (addUpdateTable->getTable() == METADATA_TABLE && addUpdateTable->getDict().size() != 2))
+        || (addUpdateTable->getTable() == METADATA_TABLE && addUpdateTable->getDict().empty()))
         throw_std_runtime_error("sqlForUpdate called with invalid arguments");
 
     std::string tableName = addUpdateTable->getTable();
@@ -2254,6 +2577,17 @@ std::unique_ptr<std::ostringstream> SQLDatabase::sqlForUpdate(const std::shared_
 
     auto qb = std::make_unique<std::ostringstream>();
     *qb << "UPDATE " << TQ(tableName) << " SET ";
+
+    if (tableName == METADATA_TABLE) {
+        // all changed properties of the item at once
+        *qb << TQ("property_value") << " = CASE " << TQ("property_name");
+        for (const auto& [key, val] : dict)
+            *qb << " WHEN " << quote(key) << " THEN " << quote(val);
+        *qb << " END WHERE " << TQ("item_id") << " = " << obj->getID()
+            << " AND " << TQ("property_name") << " IN (" << sqlForMetadataNames(dict) << ')';
+        return qb;
+    }
+
     for (auto it = dict.begin(); it != dict.end(); it++) {
         if (it != dict.begin())
             *qb << ',';
@@ -2262,29 +2596,24 @@ std::unique_ptr<std::ostringstream> SQLDatabase::sqlForUpdate(const std::shared_
     }
     *qb << " WHERE " << TQ("id") << " = " << obj->getID();
 
-    // relying on only one element when table is mt_metadata
-    if (tableName == METADATA_TABLE)
-        *qb << " AND " << TQ("property_name") << " = " << dict.begin()->first;
-
     return qb;
 }
 
 std::unique_ptr<std::ostringstream> SQLDatabase::sqlForDelete(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<AddUpdateTable>& addUpdateTable) const
 {
     if (addUpdateTable == nullptr
-        || (addUpdateTable->getTable() == METADATA_TABLE && addUpdateTable->getDict().size() != 2))
+        || (addUpdateTable->getTable() == METADATA_TABLE && addUpdateTable->getDict().empty()))
         throw_std_runtime_error("sqlForDelete called with invalid arguments");
 
     std::string tableName = addUpdateTable->getTable();
-    auto dict = addUpdateTable->getDict();
 
     auto qb = std::make_unique<std::ostringstream>();
-    *qb << "DELETE FROM " << TQ(tableName)
-        << " WHERE " << TQ("id") << " = " << obj->getID();
-
-    // relying on only one element when table is mt_metadata
+    *qb << "DELETE FROM " << TQ(tableName);
     if (tableName == METADATA_TABLE)
-        *qb << " AND " << TQ("property_name") << " = " << dict.begin()->first;
+        *qb << " WHERE " << TQ("item_id") << " = " << obj->getID()
+            << " AND " << TQ("property_name") << " IN (" << sqlForMetadataNames(addUpdateTable->getDict()) << ')';
+    else
+        *qb << " WHERE " << TQ("id") << " = " << obj->getID();
 
     return qb;
 }
@@ -2341,28 +2670,8 @@ void SQLDatabase::migrateMetadata(const std::shared_ptr<CdsObject>& object)
     auto dict = object->getMetadata();
     if (!dict.empty()) {
         log_debug("Migrating metadata for cds object {}", object->getID());
-        std::map<std::string, std::string> metadataSQLVals;
-        for (const auto& [key, val] : dict) {
-            metadataSQLVals[quote(key)] = quote(val);
-        }
-
-        for (const auto& [key, val] : metadataSQLVals) {
-            std::ostringstream fields, values;
-            fields << TQ("id") << ','
-                   << TQ("item_id") << ','
-                   << TQ("property_name") << ','
-                   << TQ("property_value");
-            values << getNextMetadataID() << ','
-                   << object->getID() << ','
-                   << key << ','
-                   << val;
-            std::ostringstream qb;
-            qb << "INSERT INTO " << TQ(METADATA_TABLE)
-               << " (" << fields.str()
-               << ") VALUES (" << values.str() << ')';
-
-            exec(qb);
-        }
+        auto qb = sqlForMetadataInsert(object->getID(), dict);
+        exec(*qb);
     } else {
         log_debug("Skipping migration - no metadata for cds object {}", object->getID());
     }
@@ -32,8 +32,10 @@
 #ifndef __SQL_STORAGE_H__
 #define __SQL_STORAGE_H__
 
+#include <atomic>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "database.h"
@@ -52,6 +54,9 @@ class SQLEmitter;
 #define METADATA_TABLE "mt_metadata"
 #define CONFIG_VALUE_TABLE "grb_config_value"
 
+// value stored for a property that a reference removes from its base object
+#define REF_METADATA_REMOVED "\x1f"
+
 class SQLRow {
 public:
     //SQLRow() { }
@@ -119,6 +124,10 @@ public:
 
     std::unique_ptr<ChangedContainers> removeObject(int objectID, bool all) override;
     std::unique_ptr<ChangedContainers> removeObjects(const std::unique_ptr<std::unordered_set<int>>& list, bool all = false) override;
+    std::unique_ptr<ChangedContainers> removeReferences(int objectID) override;
+    std::unordered_map<std::string, PathInfo> getChildPaths(int parentID) override;
+    void storeFingerprint(const std::shared_ptr<CdsObject>& obj) override;
+    std::vector<int> moveObject(int objectID, const fs::path& newPath, int parentID) override;
 
     std::shared_ptr<CdsObject> loadObjectByServiceID(const std::string& serviceID) override;
     std::unique_ptr<std::vector<int>> getServiceObjectIDs(char servicePrefix) override;
@@ -167,6 +176,13 @@ public:
     std::string getFsRootName() override;
 
     void clearFlagInDB(int flag) override;
+    void clearFlagInDB(const std::vector<int>& objectIDs, int flag) override;
+    std::vector<int> getObjectsWithFlag(int flag) override;
+
+    /// \brief metadata stored for a reference: the properties that differ from its base object and markers for removed ones
+    static std::map<std::string, std::string> getReferenceMetadata(const std::map<std::string, std::string>& base, const std::map<std::string, std::string>& metadata);
+    /// \brief metadata of a reference, restored from what getReferenceMetadata stored
+    static std::map<std::string, std::string> mergeReferenceMetadata(std::map<std::string, std::string> stored, const std::map<std::string, std::string>& base);
 
 protected:
     explicit SQLDatabase(std::shared_ptr<Config> config);
@@ -188,6 +204,8 @@ private:
     std::shared_ptr<CdsObject> createObjectFromRow(const std::unique_ptr<SQLRow>& row);
     std::shared_ptr<CdsObject> createObjectFromSearchRow(const std::unique_ptr<SQLRow>& row);
     std::map<std::string, std::string> retrieveMetadataForObject(int objectId);
+    /// \brief metadata of an object that references point to, served from baseMetadata
+    std::map<std::string, std::string> retrieveBaseMetadata(int objectId);
 
     /* helper class and helper function for addObject and updateObject */
     class AddUpdateTable {
@@ -210,12 +228,17 @@ private:
     std::vector<std::shared_ptr<AddUpdateTable>> _addUpdateObject(const std::shared_ptr<CdsObject>& obj, bool isUpdate, int* changedContainer);
 
     void generateMetadataDBOperations(const std::shared_ptr<CdsObject>& obj, bool isUpdate,
-        std::vector<std::shared_ptr<AddUpdateTable>>& operations);
+        const std::map<std::string, std::string>& dict, std::vector<std::shared_ptr<AddUpdateTable>>& operations);
 
     std::unique_ptr<std::ostringstream> sqlForInsert(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<AddUpdateTable>& addUpdateTable);
     std::unique_ptr<std::ostringstream> sqlForUpdate(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<AddUpdateTable>& addUpdateTable) const;
     std::unique_ptr<std::ostringstream> sqlForDelete(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<AddUpdateTable>& addUpdateTable) const;
 
+    /// \brief one multi-row insert for all properties of an item
+    std::unique_ptr<std::ostringstream> sqlForMetadataInsert(int itemID, const std::map<std::string, std::string>& metadata);
+    /// \brief quoted property names for an IN list
+    std::string sqlForMetadataNames(const std::map<std::string, std::string>& metadata) const;
+
     /* helper for removeObject(s) */
     void _removeObjects(const std::vector<int32_t>& objectIDs);
 
@@ -250,20 +273,44 @@ private:
 
     std::string fsRootName;
 
-    int lastID;
+    /// \brief last id handed out, ids up to lastIDLimit are reserved in the database
+    std::atomic<int> lastID;
+    std::atomic<int> lastIDLimit;
 
     int getNextID();
-    void loadLastID();
 
-    int lastMetadataID;
+    std::atomic<int> lastMetadataID;
+    std::atomic<int> lastMetadataIDLimit;
 
     int getNextMetadataID();
-    void loadLastMetadataID();
+
+    /// \brief store the end of the next id range before id is used
+    void reserveIDRange(int id, std::atomic<int>& limit, const std::string& key);
+    /// \brief last id of the table, read from the stored range if possible
+    int loadLastID(const std::string& table, const std::string& limitKey);
 
     std::shared_ptr<SQLEmitter> sqlEmitter;
 
     std::mutex nextIDMutex;
     using AutoLock = std::lock_guard<std::mutex>;
+
+    /// \brief ids of the virtual containers resolved by addContainerChain, by their location
+    std::unordered_map<std::string, int> virtualContainerIDs;
+    /// \brief locations by id to drop removed containers
+    std::unordered_map<int, std::string> virtualContainerPaths;
+    std::mutex virtualContainerMutex;
+
+    int getCachedContainerID(const std::string& virtualPath);
+    void cacheContainerID(const std::string& virtualPath, int containerID);
+    void uncacheContainerIDs(const std::vector<int32_t>& objectIDs);
+
+    /// \brief metadata of base objects by id, shared by all their references
+    std::unordered_map<int, std::map<std::string, std::string>> baseMetadata;
+    /// \brief counts the changes to drop reads that raced with them
+    unsigned int baseMetadataGeneration = 0;
+    std::mutex baseMetadataMutex;
+
+    void uncacheBaseMetadata(const std::vector<int32_t>& objectIDs);
 };
 
 #endif // __SQL_STORAGE_H__
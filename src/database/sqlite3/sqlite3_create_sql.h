@@ -31,12 +31,12 @@
 
 #ifndef __SQLITE3_CREATE_SQL_H__
 #define __SQLITE3_CREATE_SQL_H__
-#define SL3_CREATE_SQL_INFLATED_SIZE 3517
-#define SL3_CREATE_SQL_DEFLATED_SIZE 856
+#define SL3_CREATE_SQL_INFLATED_SIZE 3709
+#define SL3_CREATE_SQL_DEFLATED_SIZE 879
 
 /* begin binary data: */
-const unsigned char sqlite3_create_sql[] = /* 856 */
-    { 0x78, 0x9C, 0xB5, 0x56, 0x5B, 0x6F, 0xDA, 0x30, 0x14, 0x7E, 0xE7, 0x57, 0x58, 0x79, 0x49, 0x2A, 0xB1, 0x09, 0xAA, 0x75, 0xDA, 0xC4, 0x53, 0x0A, 0x6E, 0x15, 0x8D, 0x86, 0x0E, 0xC2, 0xB4, 0x3D, 0x59, 0x26, 0x31, 0xE0, 0x91, 0x9B, 0x1C, 0x07, 0x95, 0x7F, 0x3F, 0x3B, 0xF7, 0x1B, 0x21, 0x9A, 0x5A, 0x09, 0x21, 0x38, 0xD7, 0xEF, 0x7C, 0x3E, 0xE7, 0xD8, 0x8F, 0xF0, 0xD9, 0x30, 0x81, 0xB5, 0xD6, 0xCD, 0x8D, 0x3E, 0xB7, 0x8C, 0x95, 0x39, 0x1B, 0xCD, 0xD7, 0x50, 0xB7, 0x20, 0xB0, 0xF4, 0xC7, 0x25, 0x04, 0x8A, 0xC7, 0x91, 0xED, 0x44, 0x28, 0xD8, 0xFD, 0x25, 0x36, 0x57, 0x80, 0x36, 0x02, 0x40, 0xA1, 0x8E, 0x02, 0xA8, 0xCF, 0xC9, 0x81, 0x30, 0x10, 0x32, 0xEA, 0x61, 0x76, 0x01, 0x27, 0x72, 0x19, 0x4B, 0x1D, 0x23, 0x7B, 0x54, 0xD5, 0x3B, 0x64, 0x8F, 0x63, 0x97, 0x03, 0x73, 0xBB, 0x5C, 0x26, 0x06, 0x21, 0x66, 0xC4, 0xE7, 0x35, 0x1B, 0x73, 0x65, 0x25, 0xFA, 0xC2, 0x78, 0x92, 0x58, 0xA6, 0x39, 0x11, 0xBF, 0x84, 0x44, 0x01, 0x9C, 0xFA, 0x17, 0x61, 0x0F, 0x62, 0x3F, 0xA2, 0x07, 0x9F, 0x38, 0x85, 0x53, 0x62, 0x1A, 0x87, 0x7E, 0x88, 0x6C, 0x17, 0x47, 0x91, 0x02, 0xCE, 0x98, 0xD9, 0x47, 0xCC, 0xB4, 0x6F, 0x93, 0xBB, 0x76, 0x76, 0xC7, 0x46, 0x9C, 0x72, 0x97, 0x94, 0x66, 0xF7, 0x0F, 0x0F, 0x1D, 0x76, 0x6E, 0x60, 0x63, 0x4E, 0x03, 0x5F, 0x24, 0x26, 0x6F, 0xFC, 0xBA, 0x1E, 0x1D, 0x71, 0x74, 0x2C, 0x2B, 0x29, 0xD0, 0xB5, 0x1C, 0x3C, 0xC2, 0xB1, 0x83, 0x39, 0xBE, 0x16, 0x10, 0xC7, 0x6F, 0x7D, 0x6A, 0x46, 0xA2, 0x20, 0x66, 0x36, 0x89, 0xAE, 0x19, 0xC4, 0xA1, 0x70, 0x27, 0x43, 0x68, 0xF5, 0xA8, 0x47, 0x32, 0x52, 0x73, 0x0E, 0xBE, 0x74, 0x51, 0xB5, 0x77, 0xF1, 0x21, 0xEA, 0x28, 0xAD, 0x15, 0x76, 0x9A, 0x98, 0x73, 0x86, 0xED, 0x13, 0xF2, 0x63, 0x6F, 0x47, 0x58, 0xCF, 0xF1, 0x47, 0x84, 0x9D, 0xA9, 0x9D, 0x02, 0xED, 0x3D, 0x82, 0xF9, 0xCA, 0xDC, 0x88, 0xBE, 0x34, 0x4C, 0x0B, 0x28, 0x65, 0x07, 0x22, 0xBA, 0xDB, 0x9F, 0xD0, 0x54, 0x01, 0x4F, 0xAB, 0x35, 0x34, 0x9E, 0x4D, 0xF0, 0x03, 0xFE, 0x01, 0x5A, 0xDE, 0x75, 0x77, 0x60, 0x0D, 0x9F, 0xE0, 0x1A, 0x9A, 0x73, 0xB8, 0x69, 0xB7, 0xAE, 0x92, 0x58, 0xAC, 0x4C, 0xB0, 0x80, 0x4B, 0x28, 0x3A, 0x7C, 0xAE, 0x6F, 0xE6, 0xFA, 0x02, 0x4A, 0xC9, 0xF6, 0x75, 0xA1, 0x97, 0x92, 0x5B, 0xE9, 0xEF, 0x9B, 0xE9, 0xCB, 0x9E, 0x7E, 0x27, 0x04, 0xA3, 0xBB, 0xD9, 0xC8, 0x30, 0x37, 0x70, 0x6D, 0x01, 0x81, 0x60, 0xD5, 0x8A, 0xF4, 0x4B, 0x5F, 0x6E, 0xE1, 0x46, 0xFB, 0x34, 0x1D, 0xA7, 0x7C, 0x01, 0xF9, 0x6B, 0x92, 0xFF, 0x19, 0xF2, 0x5D, 0x18, 0x7F, 0xAF, 0xCA, 0x87, 0xA5, 0x9D, 0x54, 0xB3, 0x8A, 0x8F, 0x9A, 0xEA, 0x3F, 0xDB, 0x81, 0xCF, 0x31, 0xF5, 0x09, 0x53, 0x85, 0x6C, 0x1D, 0x04, 0x5C, 0xFD, 0x48, 0x14, 0xD3, 0x4A, 0x90, 0x6B, 0x20, 0x5E, 0xE7, 0x60, 0x41, 0x99, 0x10, 0x07, 0xEC, 0xF2, 0xFF, 0x60, 0x3A, 0x37, 0x22, 0xB6, 0x39, 0x3D, 0x8B, 0x3E, 0xE6, 0xC4, 0x1B, 0xB0, 0x16, 0xA5, 0xB5, 0xDC, 0x26, 0xB5, 0x96, 0xAF, 0xAD, 0xB0, 0x88, 0x8B, 0xF9, 0xED, 0x31, 0xA8, 0x36, 0x64, 0x1B, 0xC2, 0x95, 0xB9, 0x78, 0xDF, 0x8E, 0x6C, 0xF1, 0x20, 0xAB, 0x65, 0x3E, 0x76, 0x51, 0x44, 0xB8, 0x58, 0xD0, 0x87, 0x8C, 0x08, 0x51, 0x74, 0x7D, 0xB7, 0x54, 0xD8, 0xA8, 0x17, 0x7D, 0xC6, 0x6E, 0x7C, 0xAD, 0xE8, 0xAE, 0x19, 0x68, 0x27, 0xCC, 0x9A, 0x41, 0x75, 0x76, 0xE8, 0x4C, 0x58, 0x24, 0x48, 0x96, 0xE7, 0xFE, 0x55, 0xED, 0x82, 0x8B, 0x63, 0x1E, 0x44, 0x36, 0xF6, 0x07, 0x9C, 0x97, 0x20, 0xA8, 0xFF, 0x1A, 0x93, 0x71, 0x90, 0x4B, 0xCE, 0xC4, 0x2D, 0xE1, 0x4F, 0x27, 0xCD, 0x33, 0x95, 0x46, 0x5E, 0xE0, 0x90, 0x1E, 0x1B, 0xD1, 0x9D, 0xB1, 0xC0, 0x7D, 0xBE, 0x79, 0xC7, 0x1D, 0xA9, 0xE3, 0x10, 0xFF, 0x96, 0x55, 0xC2, 0x90, 0xA0, 0x75, 0xC8, 0x9D, 0x24, 0xEE, 0x4B, 0x2E, 0xE1, 0xD1, 0x3D, 0x25, 0xCE, 0x10, 0x87, 0x50, 0x32, 0x1C, 0x71, 0xB1, 0xEB, 0x7A, 0x60, 0x14, 0x6E, 0xEA, 0x44, 0x1D, 0x74, 0x97, 0x86, 0x98, 0x1F, 0x05, 0xD9, 0x57, 0xAF, 0x36, 0x1E, 0xC4, 0xF6, 0x51, 0x02, 0x1C, 0x90, 0x72, 0xAA, 0x76, 0xCC, 0x4A, 0x7E, 0xEE, 0xC9, 0x89, 0xD6, 0x07, 0x24, 0x3B, 0xE7, 0x8F, 0x1C, 0x92, 0xF2, 0xE6, 0xBF, 0xD9, 0x75, 0xE9, 0x24, 0x77, 0x5C, 0xE1, 0x29, 0x4F, 0x2C, 0x10, 0x07, 0xC0, 0x2F, 0xC8, 0xC7, 0x5E, 0xDF, 0xA6, 0x28, 0x0D, 0xB3, 0xF1, 0x4A, 0x68, 0xED, 0xD9, 0x25, 0x39, 0x42, 0x91, 0x7A, 0x7F, 0x6A, 0xEF, 0x90, 0x0C, 0xD4, 0x87, 0x71, 0x74, 0x60, 0x3B, 0x24, 0xB6, 0xF6, 0x9E, 0x1E, 0x72, 0xC0, 0x5A, 0x4E, 0x46, 0xA3, 0xCA, 0x26, 0x5F, 0xB5, 0x45, 0xD3, 0xE6, 0x21, 0x41, 0xDE, 0xB7, 0x62, 0x8A, 0xC5, 0x1B, 0x57, 0xDE, 0x8D, 0xF7, 0x95, 0x09, 0x2D, 0xB1, 0x1A, 0xE6, 0x02, 0xFE, 0x06, 0xB5, 0xAA, 0x51, 0xFA, 0xEA, 0x90, 0x25, 0xD6, 0xE4, 0x5A, 0x2A, 0xEF, 0xF7, 0x2D, 0x9E, 0x0C, 0x6D, 0xF7, 0x42, 0x35, 0xAE, 0xBC, 0x80, 0xC7, 0xF9, 0xCB, 0xB5, 0x23, 0x6C, 0xC5, 0xAC, 0x1D, 0xAD, 0xA2, 0xEC, 0x70, 0x2D, 0xDE, 0xB1, 0x69, 0xD2, 0xB6, 0x7B, 0xED, 0xA1, 0x3B, 0x2E, 0xA0, 0x75, 0x84, 0xAA, 0x3E, 0x00, 0xDB, 0x71, 0xAA, 0xDA, 0x0E, 0xE7, 0xE6, 0x62, 0x47, 0xF2, 0xAA, 0x48, 0x83, 0x34, 0x55, 0x9A, 0x50, 0x95, 0x11, 0xB6, 0xA6, 0xF1, 0x73, 0x5B, 0x09, 0x54, 0xCC, 0x7A, 0x3A, 0xD9, 0x59, 0x8C, 0x5C, 0xAA, 0xA5, 0xD2, 0xFE, 0xA3, 0x29, 0x9F, 0xA8, 0xED, 0x32, 0x4A, 0x5D, 0x47, 0x8C, 0x72, 0x8E, 0xD2, 0x91, 0xC9, 0xDC, 0x73, 0xB1, 0x96, 0x89, 0x9B, 0x9E, 0xCD, 0xFE, 0x4F, 0xDC, 0xA5, 0x6F, 0x53, 0x91, 0x04, 0x90, 0xDE, 0xAB, 0x97, 0x17, 0xC3, 0x9A, 0x8D, 0xFE, 0x01, 0xD7, 0x0A, 0x46, 0xF5 };
-/* end binary data. size = 856 bytes */
+const unsigned char sqlite3_create_sql[] = /* 879 */
+    { 0x78, 0xDA, 0xBD, 0x56, 0xDB, 0x8E, 0xDA, 0x30, 0x10, 0x7D, 0xE7, 0x2B, 0xAC, 0xBC, 0x24, 0x2B, 0xD1, 0x0A, 0x56, 0x5D, 0xB5, 0xD5, 0x3E, 0x65, 0xC1, 0xBB, 0x8A, 0xCA, 0x86, 0x2D, 0x84, 0xAA, 0x7D, 0xB2, 0x4C, 0x62, 0xC0, 0x25, 0x17, 0x64, 0x3B, 0x68, 0xE9, 0xD7, 0xD7, 0xB9, 0xDF, 0x43, 0x2A, 0xED, 0x56, 0x42, 0x08, 0x66, 0xCE, 0x8C, 0x8F, 0x8F, 0x3D, 0xE3, 0x79, 0x80, 0x4F, 0x86, 0x09, 0xAC, 0x95, 0x6E, 0xAE, 0xF5, 0x99, 0x65, 0x2C, 0xCD, 0xFB, 0xD1, 0x6C, 0x05, 0x75, 0x0B, 0x02, 0x4B, 0x7F, 0x58, 0x40, 0xA0, 0x78, 0x02, 0xD9, 0x0E, 0x47, 0xC1, 0xF6, 0x37, 0xB1, 0x85, 0x02, 0xB4, 0x11, 0x00, 0x0A, 0x75, 0x14, 0x40, 0x7D, 0x41, 0xF6, 0x84, 0x81, 0x13, 0xA3, 0x1E, 0x66, 0x17, 0x70, 0x24, 0x97, 0x71, 0xE4, 0x63, 0x64, 0x87, 0xCA, 0x7E, 0x87, 0xEC, 0x70, 0xE8, 0x0A, 0x60, 0x6E, 0x16, 0x8B, 0x18, 0x70, 0xC2, 0x8C, 0xF8, 0xA2, 0x82, 0x31, 0x97, 0x56, 0xEC, 0xCF, 0xC1, 0x93, 0x18, 0x99, 0xAC, 0x89, 0xC4, 0xE5, 0x44, 0x14, 0x20, 0xA8, 0x7F, 0x91, 0x78, 0x10, 0xFA, 0x9C, 0xEE, 0x7D, 0xE2, 0xE4, 0x41, 0x31, 0x34, 0x3C, 0xF9, 0x27, 0x64, 0xBB, 0x98, 0x73, 0x05, 0x9C, 0x31, 0xB3, 0x0F, 0x98, 0x69, 0x5F, 0x26, 0x37, 0xCD, 0xD5, 0x1D, 0x1B, 0x09, 0x2A, 0x5C, 0x52, 0xC0, 0x6E, 0xEF, 0xEE, 0x5A, 0x70, 0x6E, 0x60, 0x63, 0x41, 0x03, 0x5F, 0x2E, 0x4C, 0x5E, 0x45, 0xB7, 0x1F, 0x1D, 0x30, 0x3F, 0x14, 0x3B, 0xC9, 0xD9, 0x35, 0x02, 0x3C, 0x22, 0xB0, 0x83, 0x05, 0xEE, 0x4A, 0x88, 0xC3, 0xD7, 0x3E, 0x37, 0x23, 0x3C, 0x08, 0x99, 0x4D, 0x78, 0x17, 0x20, 0x3C, 0xC9, 0x70, 0x32, 0x44, 0x56, 0x8F, 0x7A, 0x24, 0x15, 0x35, 0xD3, 0xE0, 0x53, 0x9B, 0x54, 0x3B, 0x17, 0xEF, 0x79, 0xCB, 0xD6, 0x1A, 0x69, 0xA7, 0x31, 0x5C, 0x30, 0x6C, 0x1F, 0x91, 0x1F, 0x7A, 0x5B, 0xC2, 0x7A, 0x8E, 0x9F, 0x13, 0x76, 0xA6, 0x76, 0x42, 0xF4, 0xCA, 0x11, 0x60, 0x2E, 0x90, 0x17, 0x38, 0x74, 0x47, 0x89, 0x33, 0x44, 0x62, 0x4E, 0xFF, 0x10, 0x24, 0x8F, 0xC4, 0xA1, 0xFC, 0x38, 0x04, 0x4F, 0xFD, 0xC0, 0x21, 0x03, 0x80, 0xB3, 0xA5, 0xB9, 0x96, 0x15, 0x62, 0x98, 0x16, 0x50, 0x8A, 0x5A, 0x40, 0x74, 0xBB, 0x3B, 0xA2, 0xA9, 0x02, 0x1E, 0x97, 0x2B, 0x68, 0x3C, 0x99, 0xE0, 0x1B, 0xFC, 0x05, 0xB4, 0xEC, 0xFE, 0xDF, 0x80, 0x15, 0x7C, 0x84, 0x2B, 0x68, 0xCE, 0xE0, 0xBA, 0x59, 0x44, 0x4A, 0x8C, 0x58, 0x9A, 0x60, 0x0E, 0x17, 0x50, 0xD6, 0xDA, 0x4C, 0x5F, 0xCF, 0xF4, 0x39, 0x8C, 0x2C, 0x9B, 0x97, 0xB9, 0x5E, 0x58, 0xAE, 0x2D, 0x7F, 0x5B, 0x5F, 0xBE, 0xA8, 0xAE, 0x37, 0x62, 0x30, 0xBA, 0xB9, 0x1F, 0x19, 0xE6, 0x1A, 0xAE, 0x2C, 0x20, 0x19, 0x2C, 0x1B, 0x99, 0x7E, 0xE8, 0x8B, 0x0D, 0x5C, 0x6B, 0x1F, 0xA6, 0xE3, 0x44, 0x2F, 0x10, 0xFD, 0x9A, 0x64, 0x7F, 0x86, 0x7C, 0xE7, 0xE0, 0xAF, 0xFD, 0xC8, 0x61, 0x44, 0x26, 0x65, 0x1E, 0xF2, 0xA3, 0x26, 0xFE, 0x8F, 0x76, 0xE0, 0x0B, 0x4C, 0x7D, 0xC2, 0x54, 0x69, 0x5B, 0x05, 0x81, 0x50, 0xFF, 0x2F, 0xAF, 0x69, 0x29, 0x6D, 0x17, 0xAD, 0x97, 0x19, 0x98, 0x53, 0x26, 0xCD, 0x01, 0xBB, 0xBC, 0x25, 0xBD, 0xD6, 0x8E, 0x8E, 0x6D, 0x41, 0xCF, 0xB2, 0x0E, 0x05, 0xF1, 0x06, 0xB4, 0xF5, 0x08, 0x1D, 0x75, 0xC3, 0x4A, 0xC9, 0x56, 0x5A, 0x30, 0x17, 0xB2, 0xFF, 0xF4, 0x00, 0xCA, 0xD7, 0xB8, 0x49, 0xA1, 0xA3, 0x9A, 0xDE, 0xF6, 0x1E, 0x37, 0x74, 0x88, 0x76, 0xCB, 0x7C, 0xEC, 0x22, 0x4E, 0x84, 0x7C, 0x60, 0xF6, 0xA9, 0x10, 0x72, 0xD3, 0xD5, 0xDE, 0x58, 0x52, 0xA3, 0xBA, 0xE9, 0x33, 0x76, 0xC3, 0xAE, 0x4D, 0xB7, 0x55, 0x4E, 0x73, 0xC1, 0xF4, 0x7A, 0xA8, 0xCE, 0x16, 0x9D, 0x09, 0xE3, 0x52, 0xE4, 0xE8, 0x26, 0x7C, 0x56, 0xDB, 0xE8, 0xE2, 0x50, 0x04, 0xDC, 0xC6, 0xFE, 0x80, 0xF3, 0x92, 0x02, 0xF5, 0x3F, 0xC3, 0x51, 0x1E, 0xE4, 0x92, 0x33, 0x71, 0x0B, 0xFA, 0xD3, 0x49, 0xFD, 0x4C, 0x23, 0x90, 0x17, 0x77, 0xC9, 0x4E, 0x8C, 0xBC, 0xAF, 0xA1, 0xE4, 0x7D, 0xBE, 0xFA, 0x46, 0x1F, 0xA8, 0xE3, 0x10, 0xFF, 0x1A, 0x2A, 0x56, 0x48, 0xCA, 0x3A, 0xA4, 0x81, 0xFF, 0xF3, 0x0B, 0x71, 0x8A, 0x14, 0xE6, 0x42, 0x76, 0xC8, 0x1E, 0x1A, 0x79, 0x98, 0x3A, 0x51, 0x07, 0xCD, 0x02, 0x27, 0x2C, 0x0E, 0x52, 0xEC, 0xCE, 0xA7, 0x59, 0x04, 0xA1, 0x7D, 0x88, 0x08, 0x0E, 0x58, 0x72, 0xAA, 0xB6, 0xD4, 0x4A, 0x76, 0xEE, 0xF1, 0x89, 0x56, 0x0B, 0x24, 0x3D, 0xE7, 0xF7, 0x2C, 0x92, 0x62, 0x72, 0xB9, 0x7A, 0xEB, 0x92, 0x4A, 0x6E, 0x19, 0x41, 0x12, 0x9D, 0x58, 0x20, 0x0F, 0x40, 0x5C, 0x90, 0x8F, 0xBD, 0xBE, 0x4E, 0x51, 0x00, 0xD3, 0xF2, 0x8A, 0x65, 0xED, 0xE9, 0x25, 0x19, 0x43, 0xB9, 0xF4, 0xEE, 0xD8, 0xEC, 0x21, 0x29, 0xA9, 0x77, 0xD3, 0x68, 0xCF, 0xB6, 0x48, 0xF6, 0xF1, 0x1D, 0xDD, 0x67, 0x84, 0xB5, 0x4C, 0x8C, 0xDA, 0x2E, 0xEB, 0x7A, 0x55, 0x1A, 0x4D, 0x53, 0x87, 0x98, 0x79, 0x5F, 0x8B, 0xC9, 0x1B, 0x6F, 0x58, 0x9A, 0x7B, 0x6F, 0x4B, 0x15, 0x5A, 0x70, 0x35, 0xCC, 0x39, 0xFC, 0x09, 0x2A, 0xBB, 0x46, 0xC9, 0xAC, 0x12, 0x6D, 0xB1, 0x62, 0xD7, 0x12, 0x7B, 0x7F, 0x6C, 0x3E, 0x68, 0x34, 0xC3, 0x73, 0xD7, 0xB8, 0x34, 0xC1, 0x8F, 0xB3, 0xC9, 0xBB, 0x25, 0x6D, 0x09, 0xD6, 0xCC, 0x56, 0x72, 0xB6, 0x84, 0xE6, 0x73, 0x78, 0xB2, 0x68, 0x33, 0xBC, 0x32, 0xA8, 0x8F, 0x73, 0x6A, 0x2D, 0xA9, 0xCA, 0x03, 0x6C, 0x33, 0x4F, 0xD9, 0xDB, 0x12, 0x5C, 0x6F, 0xEC, 0x28, 0x7A, 0x2A, 0x92, 0x24, 0x75, 0x97, 0x26, 0x5D, 0x45, 0x86, 0x8D, 0x69, 0x7C, 0xDF, 0x94, 0x12, 0xE5, 0xB5, 0x9E, 0x54, 0x76, 0x9A, 0x23, 0xB3, 0x6A, 0x89, 0xB5, 0xFF, 0x68, 0x8A, 0x11, 0xBB, 0xB9, 0x8D, 0xC2, 0xD7, 0x92, 0xA3, 0xA8, 0xA3, 0xA4, 0x64, 0xD2, 0xF0, 0xCC, 0xAC, 0xA5, 0xE6, 0x7A, 0x64, 0xFD, 0xFE, 0xC7, 0xE1, 0x51, 0x6C, 0xDD, 0x11, 0x27, 0x88, 0xA2, 0x97, 0xCF, 0xCF, 0x86, 0x75, 0x3F, 0xFA, 0x0B, 0x18, 0xAB, 0x84, 0x08 };
+/* end binary data. size = 879 bytes */
 
 #endif // __SQLITE3_CREATE_SQL_H__
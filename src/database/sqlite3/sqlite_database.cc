@@ -107,6 +107,12 @@ PRAGMA foreign_keys = ON;"
 #define SQLITE3_UPDATE_5_6_2 "CREATE INDEX grb_config_value_item ON grb_config_value(item)"
 #define SQLITE3_UPDATE_5_6_3 "UPDATE \"mt_internal_setting\" SET \"value\"='6' WHERE \"key\"='db_version' AND \"value\"='5'"
 
+// updates 6->7: add file fingerprint
+#define SQLITE3_UPDATE_6_7_1 "ALTER TABLE \"mt_cds_object\" ADD COLUMN \"last_modified\" integer unsigned default NULL"
+#define SQLITE3_UPDATE_6_7_2 "ALTER TABLE \"mt_cds_object\" ADD COLUMN \"size_on_disk\" integer unsigned default NULL"
+#define SQLITE3_UPDATE_6_7_3 "ALTER TABLE \"mt_cds_object\" ADD COLUMN \"inode\" integer unsigned default NULL"
+#define SQLITE3_UPDATE_6_7_4 "UPDATE \"mt_internal_setting\" SET \"value\"='7' WHERE \"key\"='db_version' AND \"value\"='6'"
+
 #define SL3_INITITAL_QUEUE_SIZE 20
 
 Sqlite3Database::Sqlite3Database(std::shared_ptr<Config> config, std::shared_ptr<Timer> timer)
@@ -260,7 +266,17 @@ void Sqlite3Database::init()
             dbVersion = "6";
         }
 
-        if (dbVersion != "6")
+        if (dbVersion == "6") {
+            log_info("Running an automatic database upgrade from database version 6 to version 7...");
+            _exec(SQLITE3_UPDATE_6_7_1);
+            _exec(SQLITE3_UPDATE_6_7_2);
+            _exec(SQLITE3_UPDATE_6_7_3);
+            _exec(SQLITE3_UPDATE_6_7_4);
+            log_info("Database upgrade successful.");
+            dbVersion = "7";
+        }
+
+        if (dbVersion != "7")
             throw_std_runtime_error("The database seems to be from a newer version");
 
         // add timer for backups
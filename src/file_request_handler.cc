@@ -173,7 +173,7 @@ void FileRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
             }
         }
 
-        auto h = MetadataHandler::createHandler(config, res_handler);
+        auto h = MetadataHandler::createHandler(config, content, res_handler);
         if (mimeType.empty())
             mimeType = h->getMimeType();
 
@@ -404,7 +404,7 @@ std::unique_ptr<IOHandler> FileRequestHandler::open(const char* filename,
             }
         }
 
-        auto h = MetadataHandler::createHandler(config, res_handler);
+        auto h = MetadataHandler::createHandler(config, content, res_handler);
         if (mimeType.empty())
             mimeType = h->getMimeType();
 
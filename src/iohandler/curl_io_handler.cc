@@ -32,11 +32,17 @@
 #ifdef HAVE_CURL
 #include "curl_io_handler.h" // API
 
+#include <utility>
+
 #include "config/config_manager.h"
+#include "util/curl_engine.h"
 #include "util/tools.h"
 
-CurlIOHandler::CurlIOHandler(const std::string& URL, CURL* curl_handle, size_t bufSize, size_t initialFillSize)
+CurlIOHandler::CurlIOHandler(std::shared_ptr<CurlEngine> engine, const std::string& URL, size_t bufSize, size_t initialFillSize)
     : IOHandlerBufferHelper(bufSize, initialFillSize)
+    , engine(std::move(engine))
+    , curl_handle(nullptr)
+    , paused(false)
 {
     if (URL.empty())
         throw_std_runtime_error("URL has not been set correctly");
@@ -44,24 +50,21 @@ CurlIOHandler::CurlIOHandler(const std::string& URL, CURL* curl_handle, size_t b
         throw_std_runtime_error(fmt::format("bufSize must be at least CURL_MAX_WRITE_SIZE({})", CURL_MAX_WRITE_SIZE));
 
     this->URL = URL;
-    this->external_curl_handle = (curl_handle != nullptr);
-    this->curl_handle = curl_handle;
-    //bytesCurl = 0;
-    signalAfterEveryRead = true;
-
-    // still todo:
-    // * optimize seek if data already in buffer
     seekEnabled = true;
 }
 
+CurlIOHandler::~CurlIOHandler() noexcept
+{
+    // the base class would stop a buffer thread we never started
+    if (isOpen)
+        close();
+}
+
 void CurlIOHandler::open(enum UpnpOpenFileMode mode)
 {
-    if (curl_handle == nullptr) {
-        curl_handle = curl_easy_init();
-        if (curl_handle == nullptr)
-            throw_std_runtime_error("failed to init curl");
-    } else
-        curl_easy_reset(curl_handle);
+    curl_handle = curl_easy_init();
+    if (curl_handle == nullptr)
+        throw_std_runtime_error("failed to init curl");
 
     IOHandlerBufferHelper::open(mode);
 }
@@ -70,19 +73,18 @@ void CurlIOHandler::close()
 {
     IOHandlerBufferHelper::close();
 
-    if (external_curl_handle && curl_handle != nullptr)
+    if (curl_handle != nullptr) {
         curl_easy_cleanup(curl_handle);
+        curl_handle = nullptr;
+    }
 }
 
-void CurlIOHandler::threadProc()
+void CurlIOHandler::startBufferThread()
 {
-    CURLcode res;
     assert(curl_handle != nullptr);
     assert(!URL.empty());
 
-    //char error_buffer[CURL_ERROR_SIZE] = {'\0'};
-    //curl_easy_setopt(curl_handle, CURLOPT_ERRORBUFFER, error_buffer);
-
+    curl_easy_reset(curl_handle);
     curl_easy_setopt(curl_handle, CURLOPT_URL, URL.c_str());
     curl_easy_setopt(curl_handle, CURLOPT_NOSIGNAL, 1);
     curl_easy_setopt(curl_handle, CURLOPT_FOLLOWLOCATION, 1);
@@ -97,48 +99,103 @@ void CurlIOHandler::threadProc()
     if (logEnabled)
         curl_easy_setopt(curl_handle, CURLOPT_VERBOSE, 1);
 
-    //curl_easy_setopt(curl_handle, CURLOPT_CONNECTTIMEOUT,
-
-    //proxy..
+    if (posRead > 0)
+        curl_easy_setopt(curl_handle, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(posRead));
 
     curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, CurlIOHandler::curlCallback);
     curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, (void*)this);
 
-    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
-    do {
-        lock.lock();
-        if (doSeek) {
-            log_debug("SEEK: %lld {}", seekOffset, seekWhence);
-
-            if (seekWhence == SEEK_SET) {
-                posRead = seekOffset;
-                curl_easy_setopt(curl_handle, CURLOPT_RESUME_FROM_LARGE, seekOffset);
-            } else if (seekWhence == SEEK_CUR) {
-                posRead += seekOffset;
-                curl_easy_setopt(curl_handle, CURLOPT_RESUME_FROM_LARGE, posRead);
-            } else {
-                log_error("CurlIOHandler currently does not support SEEK_END");
-                static_assert(true);
-            }
+    engine->start(curl_handle, [this](CURLcode res) { transferDone(res); });
+}
 
-            /// \todo should we do that?
-            waitForInitialFillSize = (initialFillSize > 0);
+void CurlIOHandler::stopBufferThread()
+{
+    engine->cancel(curl_handle);
 
-            doSeek = false;
-            cond.notify_one();
-        }
-        lock.unlock();
-        res = curl_easy_perform(curl_handle);
-    } while (doSeek);
+    std::lock_guard<std::mutex> lock(mutex);
+    threadShutdown = true;
+    cond.notify_one();
+}
 
-    if (res != CURLE_OK)
+void CurlIOHandler::transferDone(CURLcode res)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (res != CURLE_OK) {
+        log_debug("transfer of {} failed: {}", URL, curl_easy_strerror(res));
         readError = true;
-    else
+    } else
         eof = true;
 
     cond.notify_one();
 }
 
+size_t CurlIOHandler::read(char* buf, size_t length)
+{
+    size_t ret = IOHandlerBufferHelper::read(buf, length);
+
+    bool resume;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        resume = paused;
+        paused = false;
+    }
+    if (resume)
+        engine->resume(curl_handle);
+
+    return ret;
+}
+
+void CurlIOHandler::seek(off_t offset, int whence)
+{
+    log_debug("SEEK: {} {}", offset, whence);
+    assert(isOpen);
+
+    if (whence == SEEK_END)
+        throw_std_runtime_error("CurlIOHandler currently does not support SEEK_END");
+    if (whence == SEEK_CUR && offset == 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    off_t target = (whence == SEEK_SET) ? offset : posRead + offset;
+
+    if (!empty && target >= posRead) {
+        size_t currentFillSize = (b > a) ? b - a : b + bufSize - a;
+        size_t relSeek = target - posRead;
+        if (relSeek <= currentFillSize) { // we have everything we need in the buffer already
+            a += relSeek;
+            if (a >= bufSize)
+                a -= bufSize;
+            if (a == b) {
+                empty = true;
+                a = b = 0;
+            }
+            posRead = target;
+            bool resume = paused;
+            paused = false;
+            lock.unlock();
+            if (resume)
+                engine->resume(curl_handle);
+            return;
+        }
+    }
+    lock.unlock();
+
+    // a new request is needed after the seek
+    engine->cancel(curl_handle);
+
+    lock.lock();
+    a = b = 0;
+    empty = true;
+    posRead = target;
+    eof = false;
+    readError = false;
+    paused = false;
+    waitForInitialFillSize = (initialFillSize > 0);
+    lock.unlock();
+
+    startBufferThread();
+}
+
 size_t CurlIOHandler::curlCallback(void* ptr, size_t size, size_t nmemb, void* data)
 {
     auto ego = static_cast<CurlIOHandler*>(data);
@@ -146,68 +203,26 @@ size_t CurlIOHandler::curlCallback(void* ptr, size_t size, size_t nmemb, void* d
 
     assert(wantWrite <= ego->bufSize);
 
-    //log_debug("URL: {}; size: {}; nmemb: {}; wantWrite: {}", ego->URL.c_str(), size, nmemb, wantWrite);
-
+    // called on the engine thread, which must never wait for the reader
     std::unique_lock<std::mutex> lock(ego->mutex);
 
-    bool first = true;
-
-    int bufFree = 0;
-    do {
-        if (ego->doSeek && !ego->empty && (ego->seekWhence == SEEK_SET || (ego->seekWhence == SEEK_CUR && ego->seekOffset > 0))) {
-            int currentFillSize = ego->b - ego->a;
-            if (currentFillSize <= 0)
-                currentFillSize += ego->bufSize;
-
-            int relSeek = ego->seekOffset;
-            if (ego->seekWhence == SEEK_SET)
-                relSeek -= ego->posRead;
-
-            if (relSeek <= currentFillSize) { // we have everything we need in the buffer already
-                ego->a += relSeek;
-                ego->posRead += relSeek;
-                if (ego->a >= ego->bufSize)
-                    ego->a -= ego->bufSize;
-                if (ego->a == ego->b) {
-                    ego->empty = true;
-                    ego->a = ego->b = 0;
-                }
-                /// \todo do we need to wait for initialFillSize again?
-
-                ego->doSeek = false;
-                ego->cond.notify_one();
-            }
-        }
-
-        // note: seeking could be optimized some more (backward seeking)
-        // but this should suffice for now
-
-        if (ego->doSeek) { // seek not been processed yet
-            ego->a = ego->b = 0;
-            ego->empty = true;
+    if (ego->threadShutdown)
+        return 0;
 
-            // terminate this request, because we need a new request
-            // after the seek
-            return 0;
-        }
+    size_t bufFree;
+    if (ego->empty) {
+        ego->a = ego->b = 0;
+        bufFree = ego->bufSize;
+    } else {
+        bufFree = (ego->a > ego->b) ? ego->a - ego->b : ego->a + ego->bufSize - ego->b;
+        if (ego->a == ego->b)
+            bufFree = 0;
+    }
 
-        if (!first) {
-            ego->cond.wait(lock);
-        } else
-            first = false;
-
-        if (ego->threadShutdown)
-            return 0;
-
-        if (ego->empty) {
-            ego->a = ego->b = 0;
-            bufFree = ego->bufSize;
-        } else {
-            bufFree = ego->a - ego->b;
-            if (bufFree < 0)
-                bufFree += ego->bufSize;
-        }
-    } while (static_cast<size_t>(bufFree) < wantWrite);
+    if (bufFree < wantWrite) {
+        ego->paused = true;
+        return CURL_WRITEFUNC_PAUSE;
+    }
 
     size_t maxWrite = (ego->empty ? ego->bufSize : (ego->a < ego->b ? ego->bufSize - ego->b : ego->a - ego->b));
     size_t write1 = (wantWrite > maxWrite ? maxWrite : wantWrite);
@@ -223,7 +238,6 @@ size_t CurlIOHandler::curlCallback(void* ptr, size_t size, size_t nmemb, void* d
 
     lock.lock();
 
-    //ego->bytesCurl += wantWrite;
     ego->b += wantWrite;
     if (ego->b >= ego->bufSize)
         ego->b -= ego->bufSize;
@@ -232,10 +246,8 @@ size_t CurlIOHandler::curlCallback(void* ptr, size_t size, size_t nmemb, void* d
         ego->cond.notify_one();
     }
     if (ego->waitForInitialFillSize) {
-        int currentFillSize = ego->b - ego->a;
-        if (currentFillSize <= 0)
-            currentFillSize += ego->bufSize;
-        if (static_cast<size_t>(currentFillSize) >= ego->initialFillSize) {
+        size_t currentFillSize = (ego->b > ego->a) ? ego->b - ego->a : ego->b + ego->bufSize - ego->a;
+        if (currentFillSize >= ego->initialFillSize) {
             log_debug("buffer: initial fillsize reached");
             ego->waitForInitialFillSize = false;
             ego->cond.notify_one();
@@ -35,26 +35,39 @@
 #define __CURL_IO_HANDLER_H__
 
 #include <curl/curl.h>
+#include <memory>
 #include <upnp.h>
 
 #include "common.h"
 #include "io_handler_buffer_helper.h"
 
+class CurlEngine;
+
+/// \brief Reads an URL through the shared CurlEngine
+///
+/// No thread is started per stream, the transfer writes into the buffer
+/// from the engine thread and is paused while the buffer is full.
 class CurlIOHandler : public IOHandlerBufferHelper {
 public:
-    CurlIOHandler(const std::string& URL, CURL* curl_handle, size_t bufSize, size_t initialFillSize);
+    CurlIOHandler(std::shared_ptr<CurlEngine> engine, const std::string& URL, size_t bufSize, size_t initialFillSize);
+    ~CurlIOHandler() noexcept override;
 
     void open(enum UpnpOpenFileMode mode) override;
+    size_t read(char* buf, size_t length) override;
+    void seek(off_t offset, int whence) override;
     void close() override;
 
 private:
+    std::shared_ptr<CurlEngine> engine;
     CURL* curl_handle;
-    bool external_curl_handle;
     std::string URL;
-    //off_t bytesCurl;
+    bool paused;
 
     static size_t curlCallback(void* ptr, size_t size, size_t nmemb, void* data);
-    void threadProc() override;
+    void startBufferThread() override;
+    void stopBufferThread() override;
+    void threadProc() override { }
+    void transferDone(CURLcode res);
 };
 
 #endif // __CURL_IO_HANDLER_H__
@@ -84,8 +84,9 @@ protected:
     int seekWhence;
 
     // thread stuff..
-    void startBufferThread();
-    void stopBufferThread();
+    /// \brief starts filling the buffer, subclasses without own thread override both
+    virtual void startBufferThread();
+    virtual void stopBufferThread();
     static void* staticThreadProc(void* arg);
     virtual void threadProc() = 0;
 
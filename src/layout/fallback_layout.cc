@@ -422,6 +422,20 @@ void FallbackLayout::processCdsObject(std::shared_ptr<CdsObject> obj, fs::path r
 #endif
 }
 
+bool FallbackLayout::dependsOnLocation(const std::shared_ptr<CdsObject>& obj)
+{
+    if (!IS_CDS_ITEM(obj->getObjectType()) || obj->getFlag(OBJECT_FLAG_ONLINE_SERVICE))
+        return false;
+
+    // only video and images are sorted into directory containers
+    std::string mimetype = std::static_pointer_cast<CdsItem>(obj)->getMimeType();
+    if (startswith(mimetype, "video") || startswith(mimetype, "image"))
+        return true;
+
+    auto mappings = config->getDictionaryOption(CFG_IMPORT_MAPPINGS_MIMETYPE_TO_CONTENTTYPE_LIST);
+    return getValueOrDefault(mappings, mimetype) == CONTENT_TYPE_OGG && obj->getFlag(OBJECT_FLAG_OGG_THEORA);
+}
+
 #ifdef ENABLE_PROFILING
 FallbackLayout::~FallbackLayout()
 {
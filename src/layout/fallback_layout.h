@@ -52,6 +52,7 @@ public:
         std::shared_ptr<Database> database,
         std::shared_ptr<ContentManager> content);
     void processCdsObject(std::shared_ptr<CdsObject> obj, fs::path rootpath) override;
+    bool dependsOnLocation(const std::shared_ptr<CdsObject>& obj) override;
 #ifdef ENABLE_PROFILING
     virtual ~FallbackLayout();
 #endif
@@ -60,7 +61,7 @@ protected:
     static std::string esc(std::string str);
     void addVideo(const std::shared_ptr<CdsObject>& obj, const fs::path& rootpath);
     void addImage(const std::shared_ptr<CdsObject>& obj, const fs::path& rootpath);
-    void addAudio(const std::shared_ptr<CdsObject>& obj);
+    virtual void addAudio(const std::shared_ptr<CdsObject>& obj);
 #ifdef SOPCAST
     void addSopCast(const std::shared_ptr<CdsObject>& obj);
 #endif
@@ -32,6 +32,7 @@
 #ifdef HAVE_JS
 #include "js_layout.h" // API
 
+#include "config/config_manager.h"
 #include "scripting/import_script.h"
 #include "scripting/runtime.h"
 
@@ -39,18 +40,55 @@ JSLayout::JSLayout(const std::shared_ptr<Config>& config,
     const std::shared_ptr<Database>& database,
     const std::shared_ptr<ContentManager>& content,
     const std::shared_ptr<Runtime>& runtime)
-    : import_script(std::make_unique<ImportScript>(config, database, content, runtime))
+    : config(config)
+    , runtime(runtime)
 {
+    // the heaps only share the lock for writing to the database with the
+    // shared runtime: the playlist script holds that runtime while it adds
+    // items, and these items are laid out on the heaps
+    int count = config->getIntOption(CFG_IMPORT_SCRIPTING_IMPORT_SCRIPT_HEAPS);
+    for (int i = 0; i < count; i++) {
+        auto heapRuntime = std::make_shared<Runtime>(runtime->getWriteMutex());
+        auto script = std::make_unique<ImportScript>(config, database, content, heapRuntime);
+        idle.push_back(script.get());
+        heaps.push_back(Heap { heapRuntime, std::move(script) });
+    }
+    log_debug("Import script loaded into {} heaps", heaps.size());
 }
 
 JSLayout::~JSLayout() = default;
 
+ImportScript* JSLayout::acquireScript()
+{
+    AutoLockU lock(mutex);
+    cond.wait(lock, [this] { return !idle.empty(); });
+    auto script = idle.back();
+    idle.pop_back();
+    return script;
+}
+
+void JSLayout::releaseScript(ImportScript* script)
+{
+    {
+        AutoLock lock(mutex);
+        idle.push_back(script);
+    }
+    cond.notify_one();
+}
+
 void JSLayout::processCdsObject(std::shared_ptr<CdsObject> obj, fs::path rootpath)
 {
-    if (import_script == nullptr)
+    if (heaps.empty())
         return;
 
-    import_script->processCdsObject(obj, rootpath);
+    auto script = acquireScript();
+    try {
+        script->processCdsObject(obj, rootpath);
+    } catch (...) {
+        releaseScript(script);
+        throw;
+    }
+    releaseScript(script);
 }
 
 #endif // HAVE_JS
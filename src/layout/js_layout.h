@@ -32,7 +32,10 @@
 #ifndef __JS_LAYOUT_H__
 #define __JS_LAYOUT_H__
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "layout.h"
 
@@ -43,12 +46,30 @@ class ImportScript;
 class Runtime;
 class Database;
 
+/// \brief Layout created by the import script
+///
+/// The script is loaded into several independent javascript heaps, so
+/// objects imported by different threads are laid out at the same time.
 class JSLayout : public Layout {
 protected:
     std::shared_ptr<Config> config;
     std::shared_ptr<Runtime> runtime;
 
-    std::unique_ptr<ImportScript> import_script;
+    struct Heap {
+        std::shared_ptr<Runtime> runtime;
+        std::unique_ptr<ImportScript> import_script;
+    };
+    std::vector<Heap> heaps;
+
+    /// \brief import scripts that are not running
+    std::vector<ImportScript*> idle;
+    std::mutex mutex;
+    std::condition_variable cond;
+    using AutoLock = std::lock_guard<std::mutex>;
+    using AutoLockU = std::unique_lock<std::mutex>;
+
+    ImportScript* acquireScript();
+    void releaseScript(ImportScript* script);
 
 public:
     JSLayout(const std::shared_ptr<Config>& config,
@@ -43,6 +43,11 @@ class Layout {
 public:
     virtual ~Layout() = default;
     virtual void processCdsObject(std::shared_ptr<CdsObject> obj, fs::path rootpath) = 0;
+
+    /// \brief whether the virtual containers of an object are derived from its location
+    ///
+    /// Objects that are moved on disk only need to be processed again if so.
+    virtual bool dependsOnLocation(const std::shared_ptr<CdsObject>& obj) { return true; }
 };
 
 #endif // __LAYOUT_H__
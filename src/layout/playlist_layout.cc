@@ -0,0 +1,226 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    playlist_layout.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file playlist_layout.cc
+
+#include "playlist_layout.h" // API
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "cds_objects.h"
+#include "config/config_manager.h"
+#include "config/directory_tweak.h"
+#include "content_manager.h"
+#include "database/database.h"
+#include "metadata/metadata_handler.h"
+#include "util/generic_task.h"
+#include "util/string_converter.h"
+#include "util/tools.h"
+
+// the playlist formats do not tell the mimetype of streams
+#define PLAYLIST_URL_MIMETYPE "audio/mpeg"
+
+PlaylistLayout::PlaylistLayout(std::shared_ptr<Config> config,
+    std::shared_ptr<Database> database,
+    std::shared_ptr<ContentManager> content)
+    : config(std::move(config))
+    , database(std::move(database))
+    , content(std::move(content))
+{
+}
+
+std::string PlaylistLayout::esc(std::string str)
+{
+    return escape(std::move(str), VIRTUAL_CONTAINER_ESCAPE, VIRTUAL_CONTAINER_SEPARATOR);
+}
+
+void PlaylistLayout::processPlaylistObject(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<GenericTask>& task)
+{
+    if (!IS_CDS_PURE_ITEM(obj->getObjectType()))
+        throw_std_runtime_error("only allowed for pure items");
+
+    auto type = PlaylistParser::getType(std::static_pointer_cast<CdsItem>(obj)->getMimeType());
+    if (type == PlaylistParser::Type::None) {
+        log_warning("Unknown playlist mimetype: '{}' of playlist '{}'", std::static_pointer_cast<CdsItem>(obj)->getMimeType().c_str(), obj->getLocation().c_str());
+        return;
+    }
+
+    log_debug("Processing playlist: {}", obj->getLocation().c_str());
+    auto entries = PlaylistParser::parseFile(type, obj->getLocation());
+    if (entries.empty())
+        return;
+
+    auto ids = resolveEntries(entries, obj, task);
+    if ((task != nullptr) && !task->isValid())
+        return;
+
+    std::string title = obj->getTitle();
+    auto dot = title.rfind('.');
+    if (dot != std::string::npos && dot > 1)
+        title = title.substr(0, dot);
+
+    std::vector<std::string> chains = { "/Playlists/All Playlists/" + esc(title) };
+    auto lastPath = getLastPath(obj->getLocation());
+    if (!lastPath.empty() && lastPath != "/") {
+        auto f2i = StringConverter::f2i(config);
+        chains.push_back("/Playlists/Directories/" + esc(f2i->convert(lastPath)) + "/" + esc(title));
+    }
+
+    // every entry is loaded once for all containers
+    std::unordered_map<int, std::shared_ptr<CdsObject>> baseObjects;
+    for (int id : ids) {
+        if (id == INVALID_OBJECT_ID || baseObjects.find(id) != baseObjects.end())
+            continue;
+        try {
+            baseObjects[id] = database->loadObject(id);
+        } catch (const std::runtime_error& e) {
+            log_warning("Skipping playlist entry {}: {}", id, e.what());
+            baseObjects[id] = nullptr;
+        }
+    }
+
+    bool linkObjects = config->getBoolOption(CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_LINK_OBJECTS);
+    std::vector<std::shared_ptr<CdsObject>> references;
+    references.reserve(entries.size() * chains.size());
+    for (const auto& chain : chains) {
+        int containerID = linkObjects
+            ? content->addContainerChain(chain, UPNP_DEFAULT_CLASS_PLAYLIST_CONTAINER, obj->getID())
+            : content->addContainerChain(chain, UPNP_DEFAULT_CLASS_PLAYLIST_CONTAINER, INVALID_OBJECT_ID, obj->getMetadata());
+
+        for (std::size_t i = 0; i < entries.size(); i++) {
+            std::shared_ptr<CdsObject> ref;
+            if (PlaylistParser::isURL(entries[i].location))
+                ref = createURLItem(entries[i], obj, linkObjects);
+            else if (ids[i] != INVALID_OBJECT_ID && baseObjects[ids[i]] != nullptr)
+                ref = createReference(entries[i], baseObjects[ids[i]]);
+
+            if (ref != nullptr) {
+                ref->setParentID(containerID);
+                references.push_back(ref);
+            }
+        }
+    }
+
+    log_debug("Adding {} entries of playlist {}", references.size(), obj->getLocation().c_str());
+    content->addObjects(references);
+}
+
+std::vector<int> PlaylistLayout::resolveEntries(const std::vector<PlaylistParser::Entry>& entries, const std::shared_ptr<CdsObject>& playlist, const std::shared_ptr<GenericTask>& task)
+{
+    std::vector<int> ids(entries.size(), INVALID_OBJECT_ID);
+
+    // local entries grouped by directory, each directory is read from the database at once
+    std::map<fs::path, std::vector<std::size_t>> directories;
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        if (!PlaylistParser::isURL(entries[i].location) && entries[i].location != playlist->getLocation())
+            directories[fs::path(entries[i].location).parent_path()].push_back(i);
+    }
+
+    AutoScanSetting asSetting;
+    asSetting.followSymlinks = config->getBoolOption(CFG_IMPORT_FOLLOW_SYMLINKS);
+    asSetting.recursive = false;
+    asSetting.hidden = config->getBoolOption(CFG_IMPORT_HIDDEN_FILES);
+    asSetting.rescanResource = false;
+
+    for (const auto& [directory, indices] : directories) {
+        if ((task != nullptr) && !task->isValid())
+            break;
+
+        int directoryID = database->findObjectIDByPath(directory);
+        auto children = directoryID > 0 ? database->getChildPaths(directoryID) : std::unordered_map<std::string, PathInfo>();
+
+        for (auto i : indices) {
+            const auto& location = entries[i].location;
+            auto child = children.find(location);
+            if (child != children.end()) {
+                if (IS_CDS_ITEM(child->second.objectType))
+                    ids[i] = child->second.id;
+                continue;
+            }
+
+            // the file is not imported yet
+            std::error_code ec;
+            if (!isRegularFile(location, ec)) {
+                log_debug("Skipping playlist entry: {}", location.c_str());
+                continue;
+            }
+            try {
+                auto settings = asSetting;
+                settings.mergeOptions(config, location);
+                ids[i] = content->addFile(location, settings, false);
+            } catch (const std::runtime_error& e) {
+                log_warning("Skipping playlist entry {}: {}", location.c_str(), e.what());
+                continue;
+            }
+            if (ids[i] != INVALID_OBJECT_ID)
+                children[location] = PathInfo { ids[i], OBJECT_TYPE_ITEM, 0, 0, 0 };
+        }
+    }
+    return ids;
+}
+
+std::shared_ptr<CdsObject> PlaylistLayout::createURLItem(const PlaylistParser::Entry& entry, const std::shared_ptr<CdsObject>& playlist, bool linkObjects)
+{
+    auto p2i = StringConverter::p2i(config);
+    auto item = std::make_shared<CdsItemExternalURL>(database);
+    item->setURL(entry.location);
+    item->setTitle(entry.title.empty() ? entry.location : p2i->convert(entry.title));
+    item->setMimeType(PLAYLIST_URL_MIMETYPE);
+    item->setClass(UPNP_DEFAULT_CLASS_MUSIC_TRACK);
+    item->setMetadata(M_DESCRIPTION, "Song from " + playlist->getTitle());
+    item->setTrackNumber(entry.order);
+    item->setRestricted(true);
+
+    auto resource = std::make_shared<CdsResource>(CH_DEFAULT);
+    resource->addAttribute(R_PROTOCOLINFO, renderProtocolInfo(PLAYLIST_URL_MIMETYPE, PROTOCOL));
+    item->addResource(resource);
+
+    if (linkObjects) {
+        item->setFlag(OBJECT_FLAG_PLAYLIST_REF);
+        item->setRefID(playlist->getID());
+    }
+    return item;
+}
+
+std::shared_ptr<CdsObject> PlaylistLayout::createReference(const PlaylistParser::Entry& entry, const std::shared_ptr<CdsObject>& base)
+{
+    if (!IS_CDS_ITEM(base->getObjectType()))
+        return nullptr;
+
+    auto ref = CdsObject::createObject(database, base->getObjectType());
+    base->copyTo(ref);
+
+    std::string title = base->getMetadata(M_TITLE);
+    if (!title.empty())
+        ref->setTitle(title);
+    std::static_pointer_cast<CdsItem>(ref)->setTrackNumber(entry.order);
+
+    if (IS_CDS_ACTIVE_ITEM(ref->getObjectType()))
+        ref->setFlag(OBJECT_FLAG_PLAYLIST_REF);
+    ref->setRefID(base->getID());
+    ref->setFlag(OBJECT_FLAG_USE_RESOURCE_REF);
+    ref->setID(INVALID_OBJECT_ID);
+    return ref;
+}
@@ -0,0 +1,70 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    playlist_layout.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file playlist_layout.h
+/// \brief Definition of the PlaylistLayout class.
+
+#ifndef __PLAYLIST_LAYOUT_H__
+#define __PLAYLIST_LAYOUT_H__
+
+#include <memory>
+#include <vector>
+
+#include "util/playlist_parser.h"
+
+// forward declaration
+class CdsObject;
+class Config;
+class ContentManager;
+class Database;
+class GenericTask;
+
+/// \brief Adds the entries of M3U and PLS playlists to the virtual layout
+///
+/// Creates the same containers as the default playlist script. Local
+/// entries are looked up per directory instead of one by one, only files
+/// that are not imported yet are added on the way. The references are
+/// added at once when the playlist is complete.
+class PlaylistLayout {
+public:
+    PlaylistLayout(std::shared_ptr<Config> config,
+        std::shared_ptr<Database> database,
+        std::shared_ptr<ContentManager> content);
+
+    void processPlaylistObject(const std::shared_ptr<CdsObject>& obj, const std::shared_ptr<GenericTask>& task);
+
+protected:
+    /// \brief object ids of the local entries, INVALID_OBJECT_ID for URLs and skipped files
+    std::vector<int> resolveEntries(const std::vector<PlaylistParser::Entry>& entries, const std::shared_ptr<CdsObject>& playlist, const std::shared_ptr<GenericTask>& task);
+
+    std::shared_ptr<CdsObject> createURLItem(const PlaylistParser::Entry& entry, const std::shared_ptr<CdsObject>& playlist, bool linkObjects);
+    std::shared_ptr<CdsObject> createReference(const PlaylistParser::Entry& entry, const std::shared_ptr<CdsObject>& base);
+
+    static std::string esc(std::string str);
+
+    std::shared_ptr<Config> config;
+    std::shared_ptr<Database> database;
+    std::shared_ptr<ContentManager> content;
+};
+
+#endif // __PLAYLIST_LAYOUT_H__
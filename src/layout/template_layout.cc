@@ -0,0 +1,271 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    template_layout.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file template_layout.cc
+
+#include "template_layout.h" // API
+
+#include <algorithm>
+#include <utility>
+
+#include "cds_objects.h"
+#include "config/config_manager.h"
+#include "content_manager.h"
+#include "metadata/metadata_handler.h"
+
+namespace {
+struct KeyInfo {
+    const char* name;
+    metadata_fields_t field;
+    /// \brief replacement in container paths if the value is missing
+    const char* fallback;
+};
+
+// same order as TemplateLayout::Key
+constexpr std::array<KeyInfo, TemplateLayout::KEY_COUNT> keyInfo { {
+    { "title", M_TITLE, "Unknown" },
+    { "artist", M_ARTIST, "Unknown" },
+    { "album", M_ALBUM, "Unknown" },
+    { "albumartist", M_ALBUMARTIST, "Unknown" },
+    { "genre", M_GENRE, "Unknown" },
+    { "year", M_DATE, "Unknown" },
+    { "composer", M_COMPOSER, "None" },
+    { "conductor", M_CONDUCTOR, "None" },
+    { "orchestra", M_ORCHESTRA, "None" },
+    { "track", M_TRACKNUMBER, "Unknown" },
+} };
+
+void appendEscaped(std::string_view value, std::string& out)
+{
+    for (char c : value) {
+        if (c == VIRTUAL_CONTAINER_ESCAPE || c == VIRTUAL_CONTAINER_SEPARATOR)
+            out += VIRTUAL_CONTAINER_ESCAPE;
+        out += c;
+    }
+}
+} // namespace
+
+TemplateLayout::Template::Template(const std::string& text)
+{
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        auto percent = text.find('%', pos);
+        std::string literal = text.substr(pos, percent - pos);
+        Key key = Key::Literal;
+        if (percent != std::string::npos) {
+            auto end = text.find('%', percent + 1);
+            if (end == std::string::npos)
+                throw_std_runtime_error("Unterminated key in layout template " + text);
+            auto name = text.substr(percent + 1, end - percent - 1);
+            if (name.empty()) {
+                literal += '%';
+            } else {
+                auto info = std::find_if(keyInfo.begin(), keyInfo.end(), [&](const auto& k) { return name == k.name; });
+                if (info == keyInfo.end())
+                    throw_std_runtime_error("Unknown key %" + name + "% in layout template " + text);
+                key = static_cast<Key>(std::distance(keyInfo.begin(), info));
+            }
+            pos = end + 1;
+        } else {
+            pos = text.size();
+        }
+
+        if (!literal.empty()) {
+            if (!segments.empty() && segments.back().key == Key::Literal)
+                segments.back().literal += literal;
+            else
+                segments.push_back(Segment { Key::Literal, std::move(literal) });
+        }
+        if (key != Key::Literal)
+            segments.push_back(Segment { key, "" });
+    }
+}
+
+void TemplateLayout::Template::expand(const Values& values, bool path, std::string& out) const
+{
+    bool skipLiteral = false;
+    for (const auto& segment : segments) {
+        if (segment.key == Key::Literal) {
+            if (!skipLiteral)
+                out += segment.literal;
+            skipLiteral = false;
+            continue;
+        }
+
+        auto value = values[static_cast<std::size_t>(segment.key)];
+        if (path)
+            appendEscaped(value.empty() ? keyInfo[static_cast<std::size_t>(segment.key)].fallback : value, out);
+        else
+            out += value;
+        skipLiteral = !path && value.empty();
+    }
+}
+
+TemplateLayout::Key TemplateLayout::Template::singleKey() const
+{
+    return segments.size() == 1 ? segments.front().key : Key::Literal;
+}
+
+TemplateLayout::Rule::Rule(const std::string& path, const std::string& title)
+    : path(path)
+    , title(title.empty() ? "%title%" : title)
+    , isAlbum(false)
+{
+    if (path.size() < 2 || path.front() != VIRTUAL_CONTAINER_SEPARATOR || path.back() == VIRTUAL_CONTAINER_SEPARATOR)
+        throw_std_runtime_error("Invalid container path in layout template " + path);
+
+    // the class of the last container follows from its key like in the import script
+    switch (Template(path.substr(path.rfind(VIRTUAL_CONTAINER_SEPARATOR) + 1)).singleKey()) {
+    case Key::Album:
+        upnpClass = UPNP_DEFAULT_CLASS_MUSIC_ALBUM;
+        isAlbum = true;
+        break;
+    case Key::Artist:
+    case Key::AlbumArtist:
+        upnpClass = UPNP_DEFAULT_CLASS_MUSIC_ARTIST;
+        break;
+    case Key::Genre:
+        upnpClass = UPNP_DEFAULT_CLASS_MUSIC_GENRE;
+        break;
+    case Key::Composer:
+        upnpClass = UPNP_DEFAULT_CLASS_MUSIC_COMPOSER;
+        break;
+    case Key::Conductor:
+        upnpClass = UPNP_DEFAULT_CLASS_MUSIC_CONDUCTOR;
+        break;
+    case Key::Orchestra:
+        upnpClass = UPNP_DEFAULT_CLASS_MUSIC_ORCHESTRA;
+        break;
+    default:
+        break;
+    }
+}
+
+const std::vector<std::pair<std::string, std::string>>& TemplateLayout::getDefaultRules()
+{
+    static const std::vector<std::pair<std::string, std::string>> defaultRules {
+        { "/Audio/All Audio", "%title%" },
+        { "/Audio/Artists/%artist%/All Songs", "%title%" },
+        { "/Audio/All - full name", "%artist% - %album% - %title%" },
+        { "/Audio/Artists/%artist%/All - full name", "%artist% - %album% - %title%" },
+        { "/Audio/Artists/%artist%/%album%", "%title%" },
+        { "/Audio/Albums/%album%", "%title%" },
+        { "/Audio/Genres/%genre%", "%title%" },
+        { "/Audio/Year/%year%", "%title%" },
+        { "/Audio/Composers/%composer%", "%title%" },
+    };
+    return defaultRules;
+}
+
+TemplateLayout::TemplateLayout(std::shared_ptr<Config> config,
+    std::shared_ptr<Database> database,
+    std::shared_ptr<ContentManager> content)
+    : FallbackLayout(std::move(config), std::move(database), std::move(content))
+{
+    // the first rule adds the original object of references, so the config order is kept
+    auto templates = this->config->getOrderedDictionaryOption(CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_AUDIO);
+    if (templates.empty())
+        templates = getDefaultRules();
+
+    rules.reserve(templates.size());
+    for (const auto& [path, title] : templates)
+        rules.emplace_back(path, title);
+    log_debug("Compiled {} audio layout templates", rules.size());
+}
+
+TemplateLayout::Values TemplateLayout::getValues(const std::map<std::string, std::string>& meta, const std::string& objTitle)
+{
+    static const auto fieldNames = [] {
+        std::array<std::string, KEY_COUNT> names;
+        for (std::size_t i = 0; i < KEY_COUNT; i++)
+            names[i] = MetadataHandler::getMetaFieldName(keyInfo[i].field);
+        return names;
+    }();
+
+    Values values;
+    for (std::size_t i = 0; i < KEY_COUNT; i++) {
+        auto it = meta.find(fieldNames[i]);
+        if (it != meta.end())
+            values[i] = it->second;
+    }
+
+    auto& title = values[static_cast<std::size_t>(Key::Title)];
+    if (title.empty())
+        title = objTitle;
+    auto& year = values[static_cast<std::size_t>(Key::Year)];
+    year = year.substr(0, year.find('-'));
+    return values;
+}
+
+void TemplateLayout::addAudio(const std::shared_ptr<CdsObject>& obj)
+{
+    auto meta = obj->getMetadata();
+    // getTitle returns a copy, the values must not point into it
+    auto objTitle = obj->getTitle();
+    auto values = getValues(meta, objTitle);
+
+    const auto& year = values[static_cast<std::size_t>(Key::Year)];
+    if (!year.empty())
+        obj->setMetadata(M_UPNP_DATE, std::string(year));
+
+    if (getValueOrDefault(meta, MetadataHandler::getMetaFieldName(M_DESCRIPTION)).empty()) {
+        std::string desc;
+        for (auto key : { Key::Artist, Key::Album, Key::Title, Key::Year, Key::Genre }) {
+            const auto& value = values[static_cast<std::size_t>(key)];
+            if (value.empty())
+                continue;
+            if (!desc.empty())
+                desc += ", ";
+            desc += value;
+        }
+        obj->setMetadata(M_DESCRIPTION, desc);
+    }
+
+    // the references point to the original object, an object from a playlist
+    // that is not in the database yet becomes the original one when it is added
+    bool refSet = obj->getID() != INVALID_OBJECT_ID;
+    if (refSet)
+        obj->setRefID(obj->getID());
+
+    std::string chain;
+    std::string title;
+    for (const auto& rule : rules) {
+        chain.clear();
+        rule.path.expand(values, true, chain);
+        title.clear();
+        rule.title.expand(values, false, title);
+
+        int id;
+        if (rule.isAlbum)
+            id = content->addContainerChain(chain, rule.upnpClass, obj->getRefID(), obj->getMetadata());
+        else
+            id = content->addContainerChain(chain, rule.upnpClass);
+
+        obj->setTitle(title);
+        add(obj, id);
+        if (!refSet) {
+            obj->setRefID(obj->getID());
+            refSet = true;
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    template_layout.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file template_layout.h
+/// \brief Definition of the TemplateLayout class.
+
+#ifndef __TEMPLATE_LAYOUT_H__
+#define __TEMPLATE_LAYOUT_H__
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "fallback_layout.h"
+
+/// \brief Builds the audio layout from container path templates
+///
+/// The templates are compiled once when the layout is created, each object
+/// only resolves its metadata values and appends them to the chains. Video,
+/// images and online content are handled like the builtin layout.
+class TemplateLayout : public FallbackLayout {
+public:
+    /// \brief metadata values that can be used as %key% in templates
+    enum class Key {
+        Title,
+        Artist,
+        Album,
+        AlbumArtist,
+        Genre,
+        Year,
+        Composer,
+        Conductor,
+        Orchestra,
+        Track,
+        Literal,
+    };
+    static constexpr std::size_t KEY_COUNT = static_cast<std::size_t>(Key::Literal);
+
+    /// \brief values of one object, empty if the metadata is missing
+    using Values = std::array<std::string_view, KEY_COUNT>;
+
+    /// \brief a text with %key% placeholders, %% is a literal percent sign
+    class Template {
+    public:
+        /// \throws std::runtime_error on unknown or unterminated keys
+        explicit Template(const std::string& text);
+
+        /// \brief append the expansion to out
+        ///
+        /// Path templates replace missing values by their defaults ("Unknown"
+        /// or "None") and escape the container separator in values. Other
+        /// templates drop missing values together with the literal that
+        /// follows them, so "%artist% - %title%" becomes "Title".
+        void expand(const Values& values, bool path, std::string& out) const;
+
+        /// \brief the key if the template is just a single key, Key::Literal otherwise
+        Key singleKey() const;
+
+    private:
+        struct Segment {
+            Key key;
+            std::string literal;
+        };
+        std::vector<Segment> segments;
+    };
+
+    /// \brief one virtual container of the audio layout
+    struct Rule {
+        Rule(const std::string& path, const std::string& title);
+
+        Template path;
+        Template title;
+        /// \brief upnp class of the last container, derived from its key
+        std::string upnpClass;
+        /// \brief last container gets the metadata of the track
+        bool isAlbum;
+    };
+
+    TemplateLayout(std::shared_ptr<Config> config,
+        std::shared_ptr<Database> database,
+        std::shared_ptr<ContentManager> content);
+
+    /// \brief the audio layout of the default import script, in the order of the script
+    static const std::vector<std::pair<std::string, std::string>>& getDefaultRules();
+
+    /// \brief look up all values of an object
+    /// \param meta metadata of the object, the values point into it
+    /// \param objTitle used if there is no title tag, the values point into it
+    static Values getValues(const std::map<std::string, std::string>& meta, const std::string& objTitle);
+    static Values getValues(const std::map<std::string, std::string>& meta, std::string&& objTitle) = delete;
+
+protected:
+    void addAudio(const std::shared_ptr<CdsObject>& obj) override;
+
+    std::vector<Rule> rules;
+};
+
+#endif // __TEMPLATE_LAYOUT_H__
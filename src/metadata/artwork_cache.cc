@@ -0,0 +1,178 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    artwork_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file artwork_cache.cc
+
+#include "artwork_cache.h" // API
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <sys/stat.h>
+#include <thread>
+#include <utility>
+
+#include "iohandler/file_io_handler.h"
+#include "iohandler/mem_io_handler.h"
+#include "util/logger.h"
+#include "util/tools.h"
+
+namespace {
+std::time_t getMTime(const fs::path& location)
+{
+    struct stat statbuf;
+    if (stat(location.c_str(), &statbuf) != 0)
+        return -1;
+    return statbuf.st_mtime;
+}
+
+/// \brief check for an image or temporary file written by ArtworkCache::store
+bool isCacheFile(const std::string& name)
+{
+    if (name.size() < 18 || name[16] != '-')
+        return false;
+    return std::all_of(name.begin(), name.begin() + 16, [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); });
+}
+} // namespace
+
+ArtworkCache::ArtworkCache(fs::path base, std::size_t maxEntries)
+    : base(std::move(base))
+    , maxEntries(maxEntries)
+{
+    sweep();
+}
+
+void ArtworkCache::sweep()
+{
+    std::error_code ec;
+    if (!fs::is_directory(base, ec))
+        return;
+
+    std::size_t count = 0;
+    AutoLock lock(mutex);
+    for (auto it = fs::recursive_directory_iterator(base, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file(ec) || !isCacheFile(it->path().filename()) || references.find(it->path()) != references.end())
+            continue;
+        if (fs::remove(it->path(), ec))
+            count++;
+    }
+    if (count > 0)
+        log_debug("Removed {} unused images from artwork cache {}", count, base.c_str());
+}
+
+void ArtworkCache::drop(std::map<fs::path, Entry>::iterator it)
+{
+    auto image = it->second.image;
+    lru.erase(it->second.lru);
+    entries.erase(it);
+    release(image);
+}
+
+void ArtworkCache::release(const fs::path& image)
+{
+    auto ref = references.find(image);
+    if (ref == references.end() || --ref->second > 0)
+        return;
+    references.erase(ref);
+    std::error_code ec;
+    if (fs::remove(image, ec))
+        log_debug("Removed unused artwork {}", image.c_str());
+}
+
+std::string ArtworkCache::getContentName(const std::byte* data, std::size_t size)
+{
+    // FNV-1a, the size in the name makes collisions irrelevant in practice
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= std::to_integer<std::uint64_t>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return fmt::format("{:016x}-{}", hash, size);
+}
+
+std::unique_ptr<IOHandler> ArtworkCache::open(const fs::path& location)
+{
+    auto mtime = getMTime(location);
+    fs::path image;
+    {
+        AutoLock lock(mutex);
+        auto it = entries.find(location);
+        if (it == entries.end())
+            return nullptr;
+        if (mtime < 0 || it->second.mtime != mtime) {
+            drop(it);
+            return nullptr;
+        }
+        lru.splice(lru.begin(), lru, it->second.lru);
+        image = it->second.image;
+    }
+
+    std::error_code ec;
+    if (!fs::is_regular_file(image, ec))
+        return nullptr;
+    log_debug("Serving artwork of {} from {}", location.c_str(), image.c_str());
+    return std::make_unique<FileIOHandler>(image);
+}
+
+std::unique_ptr<IOHandler> ArtworkCache::store(const fs::path& location, const std::byte* data, std::size_t size)
+{
+    auto mtime = getMTime(location);
+    if (mtime < 0)
+        return std::make_unique<MemIOHandler>(data, size);
+
+    auto name = getContentName(data, size);
+    auto image = base / name.substr(0, 2) / name;
+    {
+        // the reference keeps the image from being removed while it is written
+        AutoLock lock(mutex);
+        references[image]++;
+    }
+
+    std::error_code ec;
+    if (!fs::is_regular_file(image, ec)) {
+        try {
+            fs::create_directories(image.parent_path());
+            // several requests may extract the same cover at once
+            auto tmp = image;
+            tmp += fmt::format(".{}.tmp", std::hash<std::thread::id> {}(std::this_thread::get_id()));
+            writeBinaryFile(tmp, data, size);
+            fs::rename(tmp, image);
+        } catch (const std::runtime_error& e) {
+            log_error("Failed to write artwork cache: {}", e.what());
+            AutoLock lock(mutex);
+            release(image);
+            return std::make_unique<MemIOHandler>(data, size);
+        }
+    }
+
+    AutoLock lock(mutex);
+    auto it = entries.find(location);
+    if (it != entries.end())
+        drop(it);
+    lru.push_front(location);
+    entries[location] = Entry { mtime, image, lru.begin() };
+    while (entries.size() > maxEntries && lru.size() > 1)
+        drop(entries.find(lru.back()));
+
+    return std::make_unique<FileIOHandler>(image);
+}
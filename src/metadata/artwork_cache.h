@@ -0,0 +1,95 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    artwork_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file artwork_cache.h
+/// \brief Definition of the ArtworkCache class.
+
+#ifndef __ARTWORK_CACHE_H__
+#define __ARTWORK_CACHE_H__
+
+#include <cstddef>
+#include <ctime>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+namespace fs = std::filesystem;
+
+// forward declaration
+class IOHandler;
+
+/// \brief Keeps artwork extracted from media files on disk
+///
+/// The images are stored under the hash of their content, so a cover that
+/// is embedded in all tracks of an album is only written once. An in memory
+/// index maps media files to their image as long as the file is unchanged,
+/// the least recently used mappings are dropped when it is full. An image
+/// is deleted with the last mapping referring to it and images left from a
+/// previous run are removed on startup, so the directory is bounded by the
+/// index size.
+class ArtworkCache {
+public:
+    /// \param base directory for the extracted images
+    /// \param maxEntries size of the in memory index
+    ArtworkCache(fs::path base, std::size_t maxEntries);
+
+    /// \brief open the cached artwork of a media file
+    /// \return nullptr if the file is unknown or changed since extraction
+    std::unique_ptr<IOHandler> open(const fs::path& location);
+
+    /// \brief store artwork extracted from a media file and open it
+    std::unique_ptr<IOHandler> store(const fs::path& location, const std::byte* data, std::size_t size);
+
+    /// \brief name of the cache file for the image data
+    static std::string getContentName(const std::byte* data, std::size_t size);
+
+protected:
+    struct Entry {
+        std::time_t mtime;
+        fs::path image;
+        std::list<fs::path>::iterator lru;
+    };
+
+    /// \brief remove the mapping and release its image, requires the lock
+    void drop(std::map<fs::path, Entry>::iterator it);
+    /// \brief remove one reference to the image and the image if unused, requires the lock
+    void release(const fs::path& image);
+    /// \brief remove images that are not referenced by the index
+    void sweep();
+
+    fs::path base;
+    std::size_t maxEntries;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+
+    std::map<fs::path, Entry> entries;
+    /// \brief most recently used media file first
+    std::list<fs::path> lru;
+    /// \brief number of mappings per image
+    std::map<fs::path, std::size_t> references;
+};
+
+#endif // __ARTWORK_CACHE_H__
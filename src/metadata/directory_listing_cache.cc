@@ -0,0 +1,108 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    directory_listing_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file directory_listing_cache.cc
+
+#include "directory_listing_cache.h" // API
+
+#include "util/logger.h"
+#include "util/tools.h"
+
+DirectoryListingCache::DirectoryListingCache(std::size_t maxFolders)
+    : maxFolders(maxFolders)
+{
+}
+
+fs::path DirectoryListingCache::find(const fs::path& folder, const std::string& name, bool caseSensitive)
+{
+    auto listing = getListing(folder);
+    if (listing == nullptr)
+        return "";
+
+    if (caseSensitive) {
+        if (listing->names.find(name) != listing->names.end())
+            return folder / name;
+        return "";
+    }
+
+    auto it = listing->folded.find(toLower(name));
+    if (it != listing->folded.end())
+        return folder / it->second;
+    return "";
+}
+
+void DirectoryListingCache::clear()
+{
+    AutoLock lock(mutex);
+    listings.clear();
+    lru.clear();
+}
+
+std::shared_ptr<const DirectoryListingCache::Listing> DirectoryListingCache::getListing(const fs::path& folder)
+{
+    std::error_code ec;
+    // taken before reading the folder, so changes while reading it invalidate the snapshot
+    auto mtime = fs::last_write_time(folder, ec);
+    if (ec)
+        return nullptr;
+
+    {
+        AutoLock lock(mutex);
+        auto it = listings.find(folder);
+        if (it != listings.end() && it->second.first->mtime == mtime) {
+            lru.splice(lru.begin(), lru, it->second.second);
+            return it->second.first;
+        }
+    }
+
+    auto listing = std::make_shared<Listing>();
+    listing->mtime = mtime;
+    for (auto it = fs::directory_iterator(folder, ec); !ec && it != fs::directory_iterator(); it.increment(ec)) {
+        std::error_code fileEc;
+        if (!it->is_regular_file(fileEc))
+            continue;
+        auto name = it->path().filename().string();
+        listing->folded[toLower(name)] = name;
+        listing->names.insert(std::move(name));
+    }
+    if (ec) {
+        log_warning("Failed to read {}: {}", folder.c_str(), ec.message());
+        return nullptr;
+    }
+    log_debug("Read {} files in {}", listing->names.size(), folder.c_str());
+
+    AutoLock lock(mutex);
+    auto it = listings.find(folder);
+    if (it != listings.end()) {
+        lru.erase(it->second.second);
+        listings.erase(it);
+    }
+    lru.push_front(folder);
+    listings.emplace(folder, std::make_pair(listing, lru.begin()));
+    while (listings.size() > maxFolders && !lru.empty()) {
+        listings.erase(lru.back());
+        lru.pop_back();
+    }
+    return listing;
+}
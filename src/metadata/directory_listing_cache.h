@@ -0,0 +1,81 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    directory_listing_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file directory_listing_cache.h
+/// \brief Definition of the DirectoryListingCache class.
+
+#ifndef __DIRECTORY_LISTING_CACHE_H__
+#define __DIRECTORY_LISTING_CACHE_H__
+
+#include <cstddef>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+namespace fs = std::filesystem;
+
+/// \brief Keeps snapshots of the files in recently used folders
+///
+/// Looking for side car files of every item in a large folder would read the
+/// whole folder for each of them. The snapshot of a folder is reused as long
+/// as the modification time of the folder is unchanged, only a few folders
+/// are kept as an import works through them one by one.
+class DirectoryListingCache {
+public:
+    /// \param maxFolders number of folder snapshots to keep
+    explicit DirectoryListingCache(std::size_t maxFolders);
+
+    /// \brief find a regular file in a folder
+    /// \param folder folder to search in
+    /// \param name file name without directory
+    /// \param caseSensitive compare the name exactly or case folded
+    /// \return full path of the file or empty path if not found
+    fs::path find(const fs::path& folder, const std::string& name, bool caseSensitive);
+
+    void clear();
+
+protected:
+    struct Listing {
+        fs::file_time_type mtime;
+        std::unordered_set<std::string> names;
+        /// \brief lower case name to actual name
+        std::unordered_map<std::string, std::string> folded;
+    };
+
+    std::shared_ptr<const Listing> getListing(const fs::path& folder);
+
+    std::size_t maxFolders;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+
+    std::unordered_map<std::string, std::pair<std::shared_ptr<const Listing>, std::list<std::string>::iterator>> listings;
+    /// \brief most recently used folder first
+    std::list<std::string> lru;
+};
+
+#endif // __DIRECTORY_LISTING_CACHE_H__
@@ -46,6 +46,7 @@
 // INT64_C is not defined in ffmpeg/avformat.h but is needed
 // macro defines included via autoconfig.h
 #include <cerrno>
+#include <chrono>
 #include <cinttypes>
 #include <cstdint>
 #include <cstring>
@@ -64,11 +65,12 @@ extern "C" {
 
 #ifdef HAVE_FFMPEGTHUMBNAILER
 #include "iohandler/mem_io_handler.h"
-#include <libffmpegthumbnailer/videothumbnailerc.h>
+#include "metadata/thumbnailer_pool.h"
 #endif
 
 #include "cds_objects.h"
 #include "config/config_manager.h"
+#include "metadata/media_file.h"
 #include "util/string_converter.h"
 
 #ifdef HAVE_AVSTREAM_CODECPAR
@@ -78,8 +80,9 @@ extern "C" {
 #endif
 
 // Default constructor
-FfmpegHandler::FfmpegHandler(std::shared_ptr<Config> config)
+FfmpegHandler::FfmpegHandler(std::shared_ptr<Config> config, std::shared_ptr<ThumbnailerPool> thumbnailerPool)
     : MetadataHandler(std::move(config))
+    , thumbnailerPool(std::move(thumbnailerPool))
 {
 }
 
@@ -224,17 +227,78 @@ static void addFfmpegResourceFields(const std::shared_ptr<CdsItem>& item, AVForm
     }
 }
 
+static void closeIOContext(AVIOContext* pIOCtx)
+{
+    if (!pIOCtx)
+        return;
+    // the buffer may have been replaced by ffmpeg
+    av_freep(&pIOCtx->buffer);
+#if (LIBAVFORMAT_VERSION_INT < AV_VERSION_INT(57, 80, 100))
+    av_freep(&pIOCtx);
+#else
+    avio_context_free(&pIOCtx);
+#endif
+}
+
 // Stub for suppressing ffmpeg error messages during matadata extraction
 static void FfmpegNoOutputStub(void* ptr, int level, const char* fmt, va_list vl)
 {
     // do nothing
 }
 
+#define FFMPEG_IO_BUFFER_SIZE 32768
+
+namespace {
+/// \brief position of the custom io context in the media file
+struct MediaFileReader {
+    MediaFile* file;
+    int64_t position;
+};
+
+int readMediaFile(void* opaque, uint8_t* buf, int buf_size)
+{
+    auto reader = static_cast<MediaFileReader*>(opaque);
+    try {
+        auto count = reader->file->read(reader->position, buf, buf_size);
+        if (count == 0)
+            return AVERROR_EOF;
+        reader->position += count;
+        return static_cast<int>(count);
+    } catch (const std::runtime_error& e) {
+        log_warning("FfmpegHandler: {}", e.what());
+        return AVERROR(EIO);
+    }
+}
+
+int64_t seekMediaFile(void* opaque, int64_t offset, int whence)
+{
+    auto reader = static_cast<MediaFileReader*>(opaque);
+    switch (whence & ~AVSEEK_FORCE) {
+    case AVSEEK_SIZE:
+        return reader->file->getSize();
+    case SEEK_SET:
+        reader->position = offset;
+        break;
+    case SEEK_CUR:
+        reader->position += offset;
+        break;
+    case SEEK_END:
+        reader->position = reader->file->getSize() + offset;
+        break;
+    default:
+        return -1;
+    }
+    return reader->position;
+}
+} // namespace
+
 void FfmpegHandler::fillMetadata(std::shared_ptr<CdsItem> item)
 {
     log_debug("Running ffmpeg handler on {}", item->getLocation().c_str());
 
     AVFormatContext* pFormatCtx = nullptr;
+    AVIOContext* pIOCtx = nullptr;
+    MediaFileReader reader { mediaFile.get(), 0 };
 
     // Suppress all log messages
     av_log_set_callback(FfmpegNoOutputStub);
@@ -243,15 +307,36 @@ void FfmpegHandler::fillMetadata(std::shared_ptr<CdsItem> item)
     // Register all formats and codecs
     av_register_all();
 #endif
+    // Read through the already opened file instead of opening it again
+    if (mediaFile) {
+        auto buffer = static_cast<unsigned char*>(av_malloc(FFMPEG_IO_BUFFER_SIZE));
+        if (buffer)
+            pIOCtx = avio_alloc_context(buffer, FFMPEG_IO_BUFFER_SIZE, 0, &reader, readMediaFile, nullptr, seekMediaFile);
+        if (!pIOCtx) {
+            av_free(buffer);
+            return;
+        }
+        pFormatCtx = avformat_alloc_context();
+        if (!pFormatCtx) {
+            closeIOContext(pIOCtx);
+            return;
+        }
+        pFormatCtx->pb = pIOCtx;
+        pFormatCtx->flags |= AVFMT_FLAG_CUSTOM_IO;
+    }
+
     // Open video file
     if (avformat_open_input(&pFormatCtx,
             item->getLocation().c_str(), nullptr, nullptr)
-        != 0)
+        != 0) {
+        closeIOContext(pIOCtx);
         return; // Couldn't open file
+    }
 
     // Retrieve stream information
     if (avformat_find_stream_info(pFormatCtx, nullptr) < 0) {
         avformat_close_input(&pFormatCtx);
+        closeIOContext(pIOCtx);
         return; // Couldn't find stream information
     }
     // Add metadata using ffmpeg library calls
@@ -263,6 +348,7 @@ void FfmpegHandler::fillMetadata(std::shared_ptr<CdsItem> item)
 
     // Close the video file
     avformat_close_input(&pFormatCtx);
+    closeIOContext(pIOCtx);
 }
 
 #ifdef HAVE_FFMPEGTHUMBNAILER
@@ -286,85 +372,46 @@ fs::path getThumbnailCachePath(const fs::path& base, const fs::path& movie)
     return path;
 }
 
-std::optional<std::vector<std::byte>> FfmpegHandler::readThumbnailCacheFile(const fs::path& movie_filename) const
+std::vector<std::byte> FfmpegHandler::readPlaceholder() const
 {
-    auto path = getThumbnailCachePath(getThumbnailCacheBasePath(*config), movie_filename);
-    return readBinaryFile(path);
-}
-
-void FfmpegHandler::writeThumbnailCacheFile(const fs::path& movie_filename, const std::byte* data, std::size_t size) const
-{
-    try {
-        auto path = getThumbnailCachePath(getThumbnailCacheBasePath(*config), movie_filename);
-        fs::create_directories(path.parent_path());
-        writeBinaryFile(path, data, size);
-    } catch (const std::runtime_error& e) {
-        log_error("Failed to write thumbnail cache: {}", e.what());
-    }
+    auto path = config->getOption(CFG_SERVER_WEBROOT) + DESC_ICON120_JPG;
+    auto data = readBinaryFile(path);
+    if (!data)
+        throw_std_runtime_error("Could not read thumbnail placeholder " + path);
+    return std::move(*data);
 }
 #endif
 
-namespace {
-template <auto C, auto D>
-inline auto wrap_unique_ptr()
-{
-    auto raw_ptr = C();
-    return std::unique_ptr<std::remove_pointer_t<decltype(raw_ptr)>, decltype(D)>(raw_ptr, D);
-}
-} // namespace
-
 std::unique_ptr<IOHandler> FfmpegHandler::serveContent(std::shared_ptr<CdsItem> item, int resNum)
 {
 #ifdef HAVE_FFMPEGTHUMBNAILER
     if (!config->getBoolOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_ENABLED))
         return nullptr;
 
-    const auto cache_enabled = config->getBoolOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_ENABLED);
+    if (thumbnailerPool == nullptr)
+        throw_std_runtime_error("Thumbnail generation is not available");
 
-    if (cache_enabled) {
-        if (auto data = readThumbnailCacheFile(item->getLocation())) {
+    // the size reported by getInfo must match what open serves
+    auto data = thumbnailerPool->getServed(item->getLocation());
+    if (data == nullptr) {
+        if (auto cached = thumbnailerPool->getCached(item->getLocation())) {
             log_debug("Returning cached thumbnail for file: {}", item->getLocation());
-            return std::make_unique<MemIOHandler>(data->data(), data->size());
+            data = std::make_shared<const std::vector<std::byte>>(std::move(*cached));
+        } else {
+            auto result = thumbnailerPool->generate(item->getLocation());
+            auto timeout = config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_TIMEOUT);
+            if (timeout > 0 && result.wait_for(std::chrono::seconds(timeout)) != std::future_status::ready) {
+                // generation continues in the background and fills the cache
+                log_warning("Thumbnail for {} not ready after {} seconds, serving placeholder", item->getLocation(), timeout);
+                data = std::make_shared<const std::vector<std::byte>>(readPlaceholder());
+            } else {
+                data = std::make_shared<const std::vector<std::byte>>(result.get());
+            }
         }
+        thumbnailerPool->setServed(item->getLocation(), data);
     }
 
-    std::scoped_lock thumb_lock { thumb_mutex };
-
-#ifdef FFMPEGTHUMBNAILER_OLD_API
-    auto th = wrap_unique_ptr<create_thumbnailer, destroy_thumbnailer>();
-    auto img = wrap_unique_ptr<create_image_data, destroy_image_data>();
-#else
-    auto th = wrap_unique_ptr<video_thumbnailer_create, video_thumbnailer_destroy>();
-    auto img = wrap_unique_ptr<video_thumbnailer_create_image_data, video_thumbnailer_destroy_image_data>();
-#endif // old api
-
-    th->seek_percentage = config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_SEEK_PERCENTAGE);
-
-    if (config->getBoolOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_FILMSTRIP_OVERLAY))
-        th->overlay_film_strip = 1;
-    else
-        th->overlay_film_strip = 0;
-
-    th->thumbnail_size = config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_THUMBSIZE);
-    th->thumbnail_image_quality = config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_IMAGE_QUALITY);
-    th->thumbnail_image_type = Jpeg;
-
-    log_debug("Generating thumbnail for file: {}", item->getLocation());
-
-#ifdef FFMPEGTHUMBNAILER_OLD_API
-    if (generate_thumbnail_to_buffer(th.get(), item->getLocation().c_str(), img.get()) != 0)
-#else
-    if (video_thumbnailer_generate_thumbnail_to_buffer(th.get(), item->getLocation().c_str(), img.get()) != 0)
-#endif // old api
-    {
-        throw_std_runtime_error(fmt::format("Could not generate thumbnail for {}", item->getLocation()));
-    }
-    if (cache_enabled) {
-        writeThumbnailCacheFile(item->getLocation(),
-            reinterpret_cast<std::byte*>(img->image_data_ptr), img->image_data_size);
-    }
-
-    return std::make_unique<MemIOHandler>(reinterpret_cast<void*>(img->image_data_ptr), img->image_data_size);
+    return std::make_unique<MemIOHandler>(data->data(), data->size());
 #else
     return nullptr;
 #endif
@@ -46,24 +46,24 @@ namespace fs = std::filesystem;
 
 // forward declaration
 class AVFormatContext;
+class ThumbnailerPool;
 
 /// \brief This class is responsible for reading id3 tags metadata
 class FfmpegHandler : public MetadataHandler {
 public:
-    explicit FfmpegHandler(std::shared_ptr<Config> config);
+    explicit FfmpegHandler(std::shared_ptr<Config> config, std::shared_ptr<ThumbnailerPool> thumbnailerPool = nullptr);
     void fillMetadata(std::shared_ptr<CdsItem> item) override;
     std::unique_ptr<IOHandler> serveContent(std::shared_ptr<CdsItem> item, int resNum) override;
     std::string getMimeType() override;
 
 private:
-    // The ffmpegthumbnailer code (ffmpeg?) is not threading safe.
-    // Add a lock around the usage to avoid crashing randomly.
-    std::mutex thumb_mutex;
+    // The ffmpegthumbnailer code (ffmpeg?) is not threading safe,
+    // so thumbnails are generated by the workers of the pool.
+    std::shared_ptr<ThumbnailerPool> thumbnailerPool;
 
     void addFfmpegAuxdataFields(const std::shared_ptr<CdsItem>& item, AVFormatContext* pFormatCtx) const;
     void addFfmpegMetadataFields(const std::shared_ptr<CdsItem>& item, AVFormatContext* pFormatCtx) const;
-    std::optional<std::vector<std::byte>> readThumbnailCacheFile(const fs::path& movie_filename) const;
-    void writeThumbnailCacheFile(const fs::path& movie_filename, const std::byte* data, std::size_t size) const;
+    std::vector<std::byte> readPlaceholder() const;
 };
 
 fs::path getThumbnailCacheBasePath(Config& config);
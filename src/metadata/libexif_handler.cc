@@ -33,11 +33,13 @@
 #include "libexif_handler.h" // API
 
 #include <iohandler/file_io_handler.h>
+#include <libexif/exif-loader.h>
 #include <utility>
 
 #include "cds_objects.h"
 #include "config/config_manager.h"
 #include "iohandler/mem_io_handler.h"
+#include "metadata/media_file.h"
 #include "util/string_converter.h"
 #include "util/tools.h"
 
@@ -359,7 +361,22 @@ void LibExifHandler::fillMetadata(std::shared_ptr<CdsItem> item)
 
     auto sc = StringConverter::m2i(config);
 
-    ed = exif_data_new_from_file(item->getLocation().c_str());
+    if (mediaFile) {
+        // the loader stops reading as soon as it found the exif block
+        ExifLoader* loader = exif_loader_new();
+        unsigned char buffer[1024];
+        off_t offset = 0;
+        std::size_t count;
+        while ((count = mediaFile->read(offset, buffer, sizeof(buffer))) > 0) {
+            if (!exif_loader_write(loader, buffer, count))
+                break;
+            offset += count;
+        }
+        ed = exif_loader_get_data(loader);
+        exif_loader_unref(loader);
+    } else {
+        ed = exif_data_new_from_file(item->getLocation().c_str());
+    }
 
     if (!ed) {
         log_debug("Exif data not found, attempting to set resolution internally...");
@@ -45,6 +45,8 @@
 #include "cds_objects.h"
 #include "config/config_manager.h"
 #include "iohandler/mem_io_handler.h"
+#include "metadata/artwork_cache.h"
+#include "metadata/media_file.h"
 #include "util/string_converter.h"
 #include "util/tools.h"
 
@@ -119,8 +121,57 @@ public:
     }
 };
 
-MatroskaHandler::MatroskaHandler(std::shared_ptr<Config> config)
+// reading from an already opened file
+class media_file_io_callback : public IOCallback {
+private:
+    MediaFile& file;
+    int64_t position;
+
+public:
+    explicit media_file_io_callback(MediaFile& file)
+        : file(file)
+        , position(0)
+    {
+    }
+
+    uint32 read(void* buffer, size_t size) override
+    {
+        auto count = file.read(position, buffer, size);
+        position += count;
+        return count;
+    }
+
+    void setFilePointer(int64_t offset, seek_mode mode = seek_beginning) override
+    {
+        assert(mode == SEEK_CUR || mode == SEEK_END || mode == SEEK_SET);
+        if (mode == SEEK_CUR)
+            offset += position;
+        else if (mode == SEEK_END)
+            offset += file.getSize();
+        if (offset < 0)
+            throw_std_runtime_error("seek failed");
+        position = offset;
+    }
+
+    size_t write(const void* p_buffer, size_t i_size) override
+    {
+        // not needed
+        return 0;
+    }
+
+    uint64 getFilePointer() override
+    {
+        return position;
+    }
+
+    void close() override
+    {
+    }
+};
+
+MatroskaHandler::MatroskaHandler(std::shared_ptr<Config> config, std::shared_ptr<ArtworkCache> artworkCache)
     : MetadataHandler(std::move(config))
+    , artworkCache(std::move(artworkCache))
 {
 }
 
@@ -131,25 +182,37 @@ void MatroskaHandler::fillMetadata(std::shared_ptr<CdsItem> item)
 
 std::unique_ptr<IOHandler> MatroskaHandler::serveContent(std::shared_ptr<CdsItem> item, int resNum)
 {
-    MemIOHandler* io_handler;
-    parseMKV(item, &io_handler);
+    if (artworkCache != nullptr) {
+        auto cached = artworkCache->open(item->getLocation());
+        if (cached != nullptr)
+            return cached;
+    }
+
+    std::vector<std::byte> artwork;
+    parseMKV(item, &artwork);
+    if (artwork.empty())
+        throw_std_runtime_error("resource has no cover art: " + item->getLocation().string());
 
-    std::unique_ptr<IOHandler> h;
-    h.reset(io_handler);
-    return h;
+    if (artworkCache == nullptr)
+        return std::make_unique<MemIOHandler>(artwork.data(), artwork.size());
+    return artworkCache->store(item->getLocation(), artwork.data(), artwork.size());
 }
 
-void MatroskaHandler::parseMKV(const std::shared_ptr<CdsItem>& item, MemIOHandler** p_io_handler) const
+void MatroskaHandler::parseMKV(const std::shared_ptr<CdsItem>& item, std::vector<std::byte>* p_artwork) const
 {
-    file_io_callback ebml_file(item->getLocation().c_str());
-    EbmlStream ebml_stream(ebml_file);
+    std::unique_ptr<IOCallback> ebml_file;
+    if (mediaFile)
+        ebml_file = std::make_unique<media_file_io_callback>(*mediaFile);
+    else
+        ebml_file = std::make_unique<file_io_callback>(item->getLocation().c_str());
+    EbmlStream ebml_stream(*ebml_file);
 
     EbmlElement* el_l0 = ebml_stream.FindNextID(KaxSegment::ClassInfos, ~0);
     while (el_l0 != nullptr) {
         int i_upper_level = 0;
         EbmlElement* el_l1 = ebml_stream.FindNextElement(el_l0->Generic().Context, i_upper_level, ~0, true);
         while (el_l1 != nullptr) {
-            parseLevel1Element(item, ebml_stream, el_l1, p_io_handler);
+            parseLevel1Element(item, ebml_stream, el_l1, p_artwork);
 
             el_l1->SkipData(ebml_stream, el_l1->Generic().Context);
             delete el_l1;
@@ -166,7 +229,7 @@ void MatroskaHandler::parseMKV(const std::shared_ptr<CdsItem>& item, MemIOHandle
     ebml_file.close();
 }
 
-void MatroskaHandler::parseLevel1Element(const std::shared_ptr<CdsItem>& item, EbmlStream& ebml_stream, EbmlElement* el_l1, MemIOHandler** p_io_handler) const
+void MatroskaHandler::parseLevel1Element(const std::shared_ptr<CdsItem>& item, EbmlStream& ebml_stream, EbmlElement* el_l1, std::vector<std::byte>* p_artwork) const
 {
     // Looking at just at EbmlId is not reliable since it can be a dummy element.
     if (!el_l1->IsMaster())
@@ -179,7 +242,7 @@ void MatroskaHandler::parseLevel1Element(const std::shared_ptr<CdsItem>& item, E
     if (EbmlId(*master) == KaxInfo::ClassInfos.GlobalId) {
         parseInfo(item, ebml_stream, master);
     } else if (EbmlId(*master) == KaxAttachments::ClassInfos.GlobalId) {
-        parseAttachments(item, ebml_stream, master, p_io_handler);
+        parseAttachments(item, ebml_stream, master, p_artwork);
     }
 }
 
@@ -222,7 +285,7 @@ void MatroskaHandler::parseInfo(const std::shared_ptr<CdsItem>& item, EbmlStream
     }
 }
 
-void MatroskaHandler::parseAttachments(const std::shared_ptr<CdsItem>& item, EbmlStream& ebml_stream, EbmlMaster* attachments, MemIOHandler** p_io_handler)
+void MatroskaHandler::parseAttachments(const std::shared_ptr<CdsItem>& item, EbmlStream& ebml_stream, EbmlMaster* attachments, std::vector<std::byte>* p_artwork)
 {
     EbmlElement* dummy_el;
     int i_upper_level = 0;
@@ -243,9 +306,10 @@ void MatroskaHandler::parseAttachments(const std::shared_ptr<CdsItem>& item, Ebm
             auto& fileData = GetChild<KaxFileData>(*attachedFile);
             // printf("KaxFileData (size=%ld)\n", fileData.GetSize());
 
-            if (p_io_handler != nullptr) {
+            if (p_artwork != nullptr) {
                 // serveContent
-                *p_io_handler = new MemIOHandler(fileData.GetBuffer(), fileData.GetSize());
+                auto begin = reinterpret_cast<const std::byte*>(fileData.GetBuffer());
+                p_artwork->assign(begin, begin + fileData.GetSize());
             } else {
                 // fillMetadata
                 std::string art_mimetype = getContentTypeFromByteVector(&fileData);
@@ -36,20 +36,22 @@
 #include "metadata_handler.h"
 
 // forward declaration
-class MemIOHandler;
+class ArtworkCache;
 
 /// \brief This class is responsible for reading webm or mkv tags metadata
 class MatroskaHandler : public MetadataHandler {
 public:
-    explicit MatroskaHandler(std::shared_ptr<Config> config);
+    explicit MatroskaHandler(std::shared_ptr<Config> config, std::shared_ptr<ArtworkCache> artworkCache = nullptr);
     void fillMetadata(std::shared_ptr<CdsItem> item) override;
     std::unique_ptr<IOHandler> serveContent(std::shared_ptr<CdsItem> item, int resNum) override;
 
 private:
-    void parseMKV(const std::shared_ptr<CdsItem>& item, MemIOHandler** p_io_handler) const;
-    void parseLevel1Element(const std::shared_ptr<CdsItem>& item, LIBEBML_NAMESPACE::EbmlStream& ebml_stream, LIBEBML_NAMESPACE::EbmlElement* el_l1, MemIOHandler** p_io_handler) const;
+    std::shared_ptr<ArtworkCache> artworkCache;
+
+    void parseMKV(const std::shared_ptr<CdsItem>& item, std::vector<std::byte>* p_artwork) const;
+    void parseLevel1Element(const std::shared_ptr<CdsItem>& item, LIBEBML_NAMESPACE::EbmlStream& ebml_stream, LIBEBML_NAMESPACE::EbmlElement* el_l1, std::vector<std::byte>* p_artwork) const;
     void parseInfo(const std::shared_ptr<CdsItem>& item, EbmlStream& ebml_stream, LIBEBML_NAMESPACE::EbmlMaster* info) const;
-    static void parseAttachments(const std::shared_ptr<CdsItem>& item, LIBEBML_NAMESPACE::EbmlStream& ebml_stream, LIBEBML_NAMESPACE::EbmlMaster* attachments, MemIOHandler** io_handler);
+    static void parseAttachments(const std::shared_ptr<CdsItem>& item, LIBEBML_NAMESPACE::EbmlStream& ebml_stream, LIBEBML_NAMESPACE::EbmlMaster* attachments, std::vector<std::byte>* p_artwork);
     static std::string getContentTypeFromByteVector(const LIBMATROSKA_NAMESPACE::KaxFileData* data);
     static void addArtworkResource(const std::shared_ptr<CdsItem>& item, const std::string& art_mimetype);
 };
@@ -0,0 +1,120 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    media_file.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file media_file.cc
+
+#include "media_file.h" // API
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+
+#include "exceptions.h"
+
+MediaFile::MediaFile(fs::path path, std::size_t headerSize, std::size_t trailerSize)
+    : path(std::move(path))
+    , readCount(0)
+    , headerSize(0)
+    , headerLoaded(false)
+    , trailerOffset(0)
+    , trailerSize(0)
+    , trailerLoaded(false)
+{
+#ifdef O_CLOEXEC
+    fd = ::open(this->path.c_str(), O_RDONLY | O_CLOEXEC);
+#else
+    fd = ::open(this->path.c_str(), O_RDONLY);
+#endif
+    if (fd < 0)
+        throw_std_runtime_error("Error opening " + this->path.string() + ": " + std::strerror(errno));
+
+    if (fstat(fd, &statbuf) != 0 || !S_ISREG(statbuf.st_mode)) {
+        ::close(fd);
+        throw_std_runtime_error("Not a file: " + this->path.string());
+    }
+
+    auto size = static_cast<std::size_t>(statbuf.st_size);
+    this->headerSize = std::min(headerSize, size);
+
+    // the trailer only holds what is not part of the header already
+    this->trailerSize = std::min(trailerSize, size - this->headerSize);
+    trailerOffset = statbuf.st_size - this->trailerSize;
+}
+
+MediaFile::~MediaFile()
+{
+    ::close(fd);
+}
+
+std::size_t MediaFile::readFile(off_t offset, void* buffer, std::size_t length) const
+{
+    std::size_t done = 0;
+    while (done < length) {
+        auto ret = ::pread(fd, static_cast<char*>(buffer) + done, length - done, offset + done);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret < 0)
+            throw_std_runtime_error("Error reading " + path.string() + ": " + std::strerror(errno));
+        if (ret == 0)
+            break;
+        done += ret;
+    }
+    return done;
+}
+
+void MediaFile::loadBlock(std::vector<std::byte>& block, bool& loaded, off_t offset, std::size_t length)
+{
+    if (loaded)
+        return;
+    block.resize(length);
+    block.resize(readFile(offset, block.data(), block.size()));
+    loaded = true;
+}
+
+std::size_t MediaFile::read(off_t offset, void* buffer, std::size_t length)
+{
+    if (offset < 0 || offset >= statbuf.st_size || length == 0)
+        return 0;
+    length = std::min(length, static_cast<std::size_t>(statbuf.st_size - offset));
+
+    if (static_cast<std::size_t>(offset) + length <= headerSize) {
+        loadBlock(header, headerLoaded, 0, headerSize);
+        if (static_cast<std::size_t>(offset) + length <= header.size()) {
+            std::memcpy(buffer, header.data() + offset, length);
+            return length;
+        }
+    }
+    if (trailerSize > 0 && offset >= trailerOffset && static_cast<std::size_t>(offset - trailerOffset) + length <= trailerSize) {
+        loadBlock(trailer, trailerLoaded, trailerOffset, trailerSize);
+        if (static_cast<std::size_t>(offset - trailerOffset) + length <= trailer.size()) {
+            std::memcpy(buffer, trailer.data() + (offset - trailerOffset), length);
+            return length;
+        }
+    }
+
+    readCount++;
+    return readFile(offset, buffer, length);
+}
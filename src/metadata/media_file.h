@@ -0,0 +1,84 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    media_file.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file media_file.h
+/// \brief Definition of the MediaFile class.
+
+#ifndef __MEDIA_FILE_H__
+#define __MEDIA_FILE_H__
+
+#include <cstddef>
+#include <filesystem>
+#include <sys/stat.h>
+#include <vector>
+namespace fs = std::filesystem;
+
+#define MEDIA_FILE_HEADER_SIZE (256 * 1024)
+#define MEDIA_FILE_TRAILER_SIZE (64 * 1024)
+
+/// \brief A media file opened once for all metadata handlers
+///
+/// Tags are mostly located at the beginning or the end of a file, so the
+/// first read inside one of them loads it in one go and later reads are
+/// served from memory. Nothing is read before a handler asks for it.
+/// The handlers access the file through adapters for their libraries
+/// instead of opening it by name.
+class MediaFile {
+public:
+    explicit MediaFile(fs::path path, std::size_t headerSize = MEDIA_FILE_HEADER_SIZE, std::size_t trailerSize = MEDIA_FILE_TRAILER_SIZE);
+    ~MediaFile();
+
+    MediaFile(const MediaFile&) = delete;
+    MediaFile& operator=(const MediaFile&) = delete;
+
+    const fs::path& getPath() const { return path; }
+    off_t getSize() const { return statbuf.st_size; }
+    const struct stat& getStat() const { return statbuf; }
+
+    /// \brief read from any position of the file
+    /// \return number of bytes read, less than length only at the end of the file
+    std::size_t read(off_t offset, void* buffer, std::size_t length);
+
+    /// \brief number of reads that went to the file after opening it
+    std::size_t getReadCount() const { return readCount; }
+
+protected:
+    std::size_t readFile(off_t offset, void* buffer, std::size_t length) const;
+    /// \brief read the range into block unless it was read before
+    void loadBlock(std::vector<std::byte>& block, bool& loaded, off_t offset, std::size_t length);
+
+    fs::path path;
+    int fd;
+    struct stat statbuf;
+    std::size_t readCount;
+
+    std::size_t headerSize;
+    bool headerLoaded;
+    std::vector<std::byte> header;
+    off_t trailerOffset;
+    std::size_t trailerSize;
+    bool trailerLoaded;
+    std::vector<std::byte> trailer;
+};
+
+#endif // __MEDIA_FILE_H__
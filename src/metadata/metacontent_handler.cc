@@ -45,30 +45,22 @@ fs::path MetacontentHandler::getContentPath(const std::vector<std::string>& name
         auto folder = item->getLocation().parent_path();
         log_debug("Folder name: {}", folder.c_str());
 
-        if (isCaseSensitive) {
-            for (const auto& name : names) {
-                auto found = folder / expandName(name, item);
+        for (const auto& name : names) {
+            auto fileName = expandName(name, item);
+            fs::path found;
+            if (fileName.find('/') == std::string::npos) {
+                found = listingCache.find(folder, fileName, isCaseSensitive);
+            } else if (isCaseSensitive) {
+                // names can point to sub folders
                 std::error_code ec;
-                bool exists = isRegularFile(found, ec); // no error throwing, please
-                if (!exists)
-                    continue;
-
-                log_debug("{}: found", found.c_str());
-                return found;
-            }
-        } else {
-            auto fileNames = std::map<std::string, fs::path>();
-            for (const auto& p : fs::directory_iterator(folder))
-                if (p.is_regular_file())
-                    fileNames[toLower(p.path().filename())] = p;
-
-            for (const auto& name : names) {
-                auto it = std::find_if(fileNames.begin(), fileNames.end(), [fileName = toLower(expandName(name, item))](const auto& testFile) { return testFile.first == fileName; });
-                if (it != fileNames.end()) {
-                    log_debug("{}: found", it->first.c_str());
-                    return it->second;
-                }
+                if (isRegularFile(folder / fileName, ec)) // no error throwing, please
+                    found = folder / fileName;
             }
+            if (found.empty())
+                continue;
+
+            log_debug("{}: found", found.c_str());
+            return found;
         }
     }
     return "";
@@ -79,6 +71,7 @@ static constexpr std::array<std::pair<std::string_view, metadata_fields_t>, 2> m
     { "%title%", M_TITLE },
 } };
 bool MetacontentHandler::caseSensitive = true;
+DirectoryListingCache MetacontentHandler::listingCache(METACONTENT_LISTING_CACHE_FOLDERS);
 
 std::string MetacontentHandler::expandName(const std::string& name, const std::shared_ptr<CdsItem>& item)
 {
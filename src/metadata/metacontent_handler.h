@@ -30,8 +30,11 @@
 #include <filesystem>
 namespace fs = std::filesystem;
 
+#include "directory_listing_cache.h"
 #include "metadata_handler.h"
 
+#define METACONTENT_LISTING_CACHE_FOLDERS 16
+
 /// \brief This class is responsible for populating filesystem based metadata
 class MetacontentHandler : public MetadataHandler {
 public:
@@ -39,6 +42,9 @@ public:
     static bool caseSensitive;
 
 protected:
+    /// \brief folder contents shared by all handlers
+    static DirectoryListingCache listingCache;
+
     static fs::path getContentPath(const std::vector<std::string>& names, const std::shared_ptr<CdsItem>& item, bool isCaseSensitive);
     static std::string expandName(const std::string& name, const std::shared_ptr<CdsItem>& item);
 };
@@ -31,11 +31,13 @@
 
 #include "metadata_handler.h" // API
 
+#include <cstring>
 #include <filesystem>
 #include <utility>
 
 #include "cds_objects.h"
 #include "config/config_manager.h"
+#include "content_manager.h"
 #include "util/tools.h"
 
 #ifdef HAVE_EXIV2
@@ -58,6 +60,7 @@
 #include "metadata/matroska_handler.h"
 #endif
 
+#include "metadata/media_file.h"
 #include "metadata/metacontent_handler.h"
 
 MetadataHandler::MetadataHandler(std::shared_ptr<Config> config)
@@ -65,13 +68,27 @@ MetadataHandler::MetadataHandler(std::shared_ptr<Config> config)
 {
 }
 
+MetadataHandler& MetadataHandler::withFile(std::shared_ptr<MediaFile> file)
+{
+    mediaFile = std::move(file);
+    return *this;
+}
+
+static bool isTheora(MediaFile& file)
+{
+    char buffer[7];
+    if (file.read(0, buffer, 4) != 4 || memcmp(buffer, "OggS", 4) != 0)
+        return false;
+    if (file.read(28, buffer, 7) != 7)
+        throw_std_runtime_error("Incomplete file " + file.getPath().string());
+    return memcmp(buffer, "\x80theora", 7) == 0;
+}
+
 void MetadataHandler::setMetadata(const std::shared_ptr<Config>& config, const std::shared_ptr<CdsItem>& item)
 {
-    std::string location = item->getLocation();
-    std::error_code ec;
-    if (!isRegularFile(location, ec))
-        throw_std_runtime_error("Not a file: " + location);
-    auto filesize = getFileSize(location);
+    // all handlers read from this, so the file is opened only once
+    auto file = std::make_shared<MediaFile>(item->getLocation());
+    auto filesize = file->getSize();
 
     std::string mimetype = item->getMimeType();
 
@@ -84,13 +101,13 @@ void MetadataHandler::setMetadata(const std::shared_ptr<Config>& config, const s
     auto mappings = config->getDictionaryOption(CFG_IMPORT_MAPPINGS_MIMETYPE_TO_CONTENTTYPE_LIST);
     std::string content_type = getValueOrDefault(mappings, mimetype);
 
-    if ((content_type == CONTENT_TYPE_OGG) && (isTheora(item->getLocation()))) {
+    if ((content_type == CONTENT_TYPE_OGG) && (isTheora(*file))) {
         item->setFlag(OBJECT_FLAG_OGG_THEORA);
     }
 
 #ifdef HAVE_TAGLIB
     if ((content_type == CONTENT_TYPE_MP3) || ((content_type == CONTENT_TYPE_OGG) && (!item->getFlag(OBJECT_FLAG_OGG_THEORA))) || (content_type == CONTENT_TYPE_WMA) || (content_type == CONTENT_TYPE_WAVPACK) || (content_type == CONTENT_TYPE_FLAC) || (content_type == CONTENT_TYPE_PCM) || (content_type == CONTENT_TYPE_AIFF) || (content_type == CONTENT_TYPE_APE) || (content_type == CONTENT_TYPE_MP4)) {
-        TagLibHandler(config).fillMetadata(item);
+        TagLibHandler(config).withFile(file).fillMetadata(item);
     }
 #endif // HAVE_TAGLIB
 
@@ -102,19 +119,19 @@ void MetadataHandler::setMetadata(const std::shared_ptr<Config>& config, const s
 
 #ifdef HAVE_LIBEXIF
     if (content_type == CONTENT_TYPE_JPG) {
-        LibExifHandler(config).fillMetadata(item);
+        LibExifHandler(config).withFile(file).fillMetadata(item);
     }
 #endif // HAVE_LIBEXIF
 
 #ifdef HAVE_MATROSKA
     if (content_type == CONTENT_TYPE_MKV) {
-        MatroskaHandler(config).fillMetadata(item);
+        MatroskaHandler(config).withFile(file).fillMetadata(item);
     }
 #endif
 
 #ifdef HAVE_FFMPEG
     if (content_type != CONTENT_TYPE_PLAYLIST && ((content_type == CONTENT_TYPE_OGG && item->getFlag(OBJECT_FLAG_OGG_THEORA)) || startswith(item->getMimeType(), "video") || startswith(item->getMimeType(), "audio"))) {
-        FfmpegHandler(config).fillMetadata(item);
+        FfmpegHandler(config).withFile(file).fillMetadata(item);
     }
 #else
     if (content_type == CONTENT_TYPE_AVI) {
@@ -133,6 +150,8 @@ void MetadataHandler::setMetadata(const std::shared_ptr<Config>& config, const s
     if (startswith(mimetype, "video"))
         SubtitleHandler(config).fillMetadata(item);
     ResourceHandler(config).fillMetadata(item);
+
+    log_debug("Metadata of {} read with {} extra reads", item->getLocation().c_str(), file->getReadCount());
 }
 
 std::string MetadataHandler::getMetaFieldName(metadata_fields_t field)
@@ -145,7 +164,7 @@ std::string MetadataHandler::getResAttrName(resource_attributes_t attr)
     return res_keys.at(attr).second;
 }
 
-std::unique_ptr<MetadataHandler> MetadataHandler::createHandler(const std::shared_ptr<Config>& config, int handlerType)
+std::unique_ptr<MetadataHandler> MetadataHandler::createHandler(const std::shared_ptr<Config>& config, const std::shared_ptr<ContentManager>& content, int handlerType)
 {
     switch (handlerType) {
 #ifdef HAVE_LIBEXIF
@@ -154,15 +173,15 @@ std::unique_ptr<MetadataHandler> MetadataHandler::createHandler(const std::share
 #endif
 #ifdef HAVE_TAGLIB
     case CH_ID3:
-        return std::make_unique<TagLibHandler>(config);
+        return std::make_unique<TagLibHandler>(config, content->getArtworkCache());
 #endif
 #ifdef HAVE_MATROSKA
     case CH_MATROSKA:
-        return std::make_unique<MatroskaHandler>(config);
+        return std::make_unique<MatroskaHandler>(config, content->getArtworkCache());
 #endif
 #if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
     case CH_FFTH:
-        return std::make_unique<FfmpegHandler>(config);
+        return std::make_unique<FfmpegHandler>(config, content->getThumbnailerPool());
 #endif
     case CH_FANART:
         return std::make_unique<FanArtHandler>(config);
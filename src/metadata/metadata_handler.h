@@ -39,7 +39,9 @@
 // forward declaration
 class CdsItem;
 class Config;
+class ContentManager;
 class IOHandler;
+class MediaFile;
 
 // content handler Id's
 #define CH_DEFAULT 0
@@ -170,6 +172,8 @@ constexpr std::array<std::pair<resource_attributes_t, const char*>, R_MAX> res_k
 class MetadataHandler {
 protected:
     std::shared_ptr<Config> config;
+    /// \brief file opened by setMetadata, handlers open the location themselves if not set
+    std::shared_ptr<MediaFile> mediaFile;
 
 public:
     /// \brief Definition of the supported metadata fields.
@@ -179,7 +183,10 @@ public:
     static void setMetadata(const std::shared_ptr<Config>& config, const std::shared_ptr<CdsItem>& item);
     static std::string getMetaFieldName(metadata_fields_t field);
     static std::string getResAttrName(resource_attributes_t attr);
-    static std::unique_ptr<MetadataHandler> createHandler(const std::shared_ptr<Config>& config, int handlerType);
+    static std::unique_ptr<MetadataHandler> createHandler(const std::shared_ptr<Config>& config, const std::shared_ptr<ContentManager>& content, int handlerType);
+
+    /// \brief read from an already opened file in fillMetadata
+    MetadataHandler& withFile(std::shared_ptr<MediaFile> file);
 
     virtual void fillMetadata(std::shared_ptr<CdsItem> item) = 0;
     virtual std::unique_ptr<IOHandler> serveContent(std::shared_ptr<CdsItem> item, int resNum) = 0;
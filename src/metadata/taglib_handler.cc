@@ -51,11 +51,14 @@
 #include "cds_objects.h"
 #include "config/config_manager.h"
 #include "iohandler/mem_io_handler.h"
+#include "metadata/artwork_cache.h"
+#include "metadata/media_file.h"
 #include "util/string_converter.h"
 #include "util/tools.h"
 
-TagLibHandler::TagLibHandler(std::shared_ptr<Config> config)
+TagLibHandler::TagLibHandler(std::shared_ptr<Config> config, std::shared_ptr<ArtworkCache> artworkCache)
     : MetadataHandler(std::move(config))
+    , artworkCache(std::move(artworkCache))
 {
     entrySeparator = this->config->getOption(CFG_IMPORT_LIBOPTS_ENTRY_SEP);
     legacyEntrySeparator = this->config->getOption(CFG_IMPORT_LIBOPTS_ENTRY_LEGACY_SEP);
@@ -216,29 +219,86 @@ void TagLibHandler::populateGenericTags(const std::shared_ptr<CdsItem>& item, co
     }
 }
 
+namespace {
+/// \brief read only TagLib stream on top of an opened MediaFile
+class MediaFileStream : public TagLib::IOStream {
+public:
+    explicit MediaFileStream(std::shared_ptr<MediaFile> file)
+        : file(std::move(file))
+        , position(0)
+    {
+    }
+
+    TagLib::FileName name() const override { return file->getPath().c_str(); }
+
+    TagLib::ByteVector readBlock(unsigned long length) override
+    {
+        TagLib::ByteVector data(static_cast<unsigned int>(length));
+        auto count = file->read(position, data.data(), length);
+        data.resize(static_cast<unsigned int>(count));
+        position += count;
+        return data;
+    }
+
+    void writeBlock(const TagLib::ByteVector& /*data*/) override { }
+    void insert(const TagLib::ByteVector& /*data*/, unsigned long /*start*/, unsigned long /*replace*/) override { }
+    void removeBlock(unsigned long /*start*/, unsigned long /*length*/) override { }
+    bool readOnly() const override { return true; }
+    bool isOpen() const override { return true; }
+
+    void seek(long offset, Position p) override
+    {
+        switch (p) {
+        case Beginning:
+            position = offset;
+            break;
+        case Current:
+            position += offset;
+            break;
+        case End:
+            position = file->getSize() + offset;
+            break;
+        }
+    }
+
+    void clear() override { }
+    long tell() const override { return position; }
+    long length() override { return file->getSize(); }
+    void truncate(long /*length*/) override { }
+
+protected:
+    std::shared_ptr<MediaFile> file;
+    long position;
+};
+} // namespace
+
 void TagLibHandler::fillMetadata(std::shared_ptr<CdsItem> item)
 {
     auto mappings = config->getDictionaryOption(CFG_IMPORT_MAPPINGS_MIMETYPE_TO_CONTENTTYPE_LIST);
     std::string content_type = getValueOrDefault(mappings, item->getMimeType());
 
-    TagLib::FileStream fs(item->getLocation().c_str(), true); // true = Read only
+    std::unique_ptr<TagLib::IOStream> fs;
+    if (mediaFile)
+        fs = std::make_unique<MediaFileStream>(mediaFile);
+    else
+        fs = std::make_unique<TagLib::FileStream>(item->getLocation().c_str(), true); // true = Read only
 
     if (content_type == CONTENT_TYPE_MP3) {
-        extractMP3(&fs, item);
+        extractMP3(fs.get(), item);
     } else if (content_type == CONTENT_TYPE_FLAC) {
-        extractFLAC(&fs, item);
+        extractFLAC(fs.get(), item);
     } else if (content_type == CONTENT_TYPE_MP4) {
-        extractMP4(&fs, item);
+        extractMP4(fs.get(), item);
     } else if (content_type == CONTENT_TYPE_OGG) {
-        extractOgg(&fs, item);
+        extractOgg(fs.get(), item);
     } else if (content_type == CONTENT_TYPE_APE) {
-        extractAPE(&fs, item);
+        extractAPE(fs.get(), item);
     } else if (content_type == CONTENT_TYPE_WMA) {
-        extractASF(&fs, item);
+        extractASF(fs.get(), item);
     } else if (content_type == CONTENT_TYPE_WAVPACK) {
-        extractWavPack(&fs, item);
+        extractWavPack(fs.get(), item);
     } else if (content_type == CONTENT_TYPE_AIFF) {
-        extractAiff(&fs, item);
+        extractAiff(fs.get(), item);
     } else {
         log_warning("TagLibHandler {}: Does not handle the {} content type", item->getLocation().c_str(), content_type.c_str());
     }
@@ -277,8 +337,21 @@ void TagLibHandler::addArtworkResource(const std::shared_ptr<CdsItem>& item, con
     }
 }
 
+std::unique_ptr<IOHandler> TagLibHandler::serveArtwork(const std::shared_ptr<CdsItem>& item, const TagLib::ByteVector& data) const
+{
+    if (artworkCache == nullptr)
+        return std::make_unique<MemIOHandler>(data.data(), data.size());
+    return artworkCache->store(item->getLocation(), reinterpret_cast<const std::byte*>(data.data()), data.size());
+}
+
 std::unique_ptr<IOHandler> TagLibHandler::serveContent(std::shared_ptr<CdsItem> item, int resNum)
 {
+    if (artworkCache != nullptr) {
+        auto cached = artworkCache->open(item->getLocation());
+        if (cached != nullptr)
+            return cached;
+    }
+
     auto mappings = config->getDictionaryOption(CFG_IMPORT_MAPPINGS_MIMETYPE_TO_CONTENTTYPE_LIST);
     std::string content_type = getValueOrDefault(mappings, item->getMimeType());
 
@@ -300,8 +373,7 @@ std::unique_ptr<IOHandler> TagLibHandler::serveContent(std::shared_ptr<CdsItem>
 
         auto art = dynamic_cast<TagLib::ID3v2::AttachedPictureFrame*>(list.front());
 
-        auto h = std::make_unique<MemIOHandler>(art->picture().data(), art->picture().size());
-        return h;
+        return serveArtwork(item, art->picture());
     }
     if (content_type == CONTENT_TYPE_FLAC) {
         TagLib::FLAC::File f(&roStream, TagLib::ID3v2::FrameFactory::instance());
@@ -315,8 +387,7 @@ std::unique_ptr<IOHandler> TagLibHandler::serveContent(std::shared_ptr<CdsItem>
         TagLib::FLAC::Picture* pic = f.pictureList().front();
         const TagLib::ByteVector& data = pic->data();
 
-        auto h = std::make_unique<MemIOHandler>(data.data(), data.size());
-        return h;
+        return serveArtwork(item, data);
     }
     if (content_type == CONTENT_TYPE_MP4) {
         TagLib::MP4::File f(&roStream);
@@ -344,8 +415,7 @@ std::unique_ptr<IOHandler> TagLibHandler::serveContent(std::shared_ptr<CdsItem>
         const TagLib::MP4::CoverArt& coverArt = coverArtList.front();
         const TagLib::ByteVector& data = coverArt.data();
 
-        auto h = std::make_unique<MemIOHandler>(data.data(), data.size());
-        return h;
+        return serveArtwork(item, data);
     }
     if (content_type == CONTENT_TYPE_WMA) {
         TagLib::ASF::File f(&roStream);
@@ -367,8 +437,7 @@ std::unique_ptr<IOHandler> TagLibHandler::serveContent(std::shared_ptr<CdsItem>
 
         const TagLib::ByteVector& data = wmpic.picture();
 
-        auto h = std::make_unique<MemIOHandler>(data.data(), data.size());
-        return h;
+        return serveArtwork(item, data);
     }
     if (content_type == CONTENT_TYPE_OGG) {
         TagLib::Ogg::Vorbis::File f(&roStream);
@@ -383,8 +452,7 @@ std::unique_ptr<IOHandler> TagLibHandler::serveContent(std::shared_ptr<CdsItem>
         const TagLib::FLAC::Picture* pic = picList.front();
         const TagLib::ByteVector& data = pic->data();
 
-        auto h = std::make_unique<MemIOHandler>(data.data(), data.size());
-        return h;
+        return serveArtwork(item, data);
     }
 
     throw_std_runtime_error("Unsupported content_type: " + content_type);
@@ -475,7 +543,7 @@ void TagLibHandler::extractMP3(TagLib::IOStream* roStream, const std::shared_ptr
 
 void TagLibHandler::extractOgg(TagLib::IOStream* roStream, const std::shared_ptr<CdsItem>& item) const
 {
-    TagLib::Ogg::Vorbis::File vorbis(item->getLocation().c_str());
+    TagLib::Ogg::Vorbis::File vorbis(roStream);
 
     if (!vorbis.isValid()) {
         log_info("TagLibHandler {}: could not open ogg file",
@@ -43,16 +43,20 @@
 
 #include "metadata_handler.h"
 
+// forward declaration
+class ArtworkCache;
+
 /// \brief This class is responsible for reading id3 or ogg tags metadata
 class TagLibHandler : public MetadataHandler {
 public:
-    explicit TagLibHandler(std::shared_ptr<Config> config);
+    explicit TagLibHandler(std::shared_ptr<Config> config, std::shared_ptr<ArtworkCache> artworkCache = nullptr);
     void fillMetadata(std::shared_ptr<CdsItem> item) override;
     std::unique_ptr<IOHandler> serveContent(std::shared_ptr<CdsItem> item, int resNum) override;
 
 private:
     std::string entrySeparator;
     std::string legacyEntrySeparator;
+    std::shared_ptr<ArtworkCache> artworkCache;
 
     void addField(metadata_fields_t field, const TagLib::File& file, const TagLib::Tag* tag, const std::shared_ptr<CdsItem>& item) const;
 
@@ -60,6 +64,7 @@ private:
     static bool isValidArtworkContentType(const std::string& art_mimetype);
     static std::string getContentTypeFromByteVector(const TagLib::ByteVector& data);
     static void addArtworkResource(const std::shared_ptr<CdsItem>& item, const std::string& art_mimetype);
+    std::unique_ptr<IOHandler> serveArtwork(const std::shared_ptr<CdsItem>& item, const TagLib::ByteVector& data) const;
     void extractMP3(TagLib::IOStream* roStream, const std::shared_ptr<CdsItem>& item) const;
     void extractOgg(TagLib::IOStream* roStream, const std::shared_ptr<CdsItem>& item) const;
     void extractASF(TagLib::IOStream* roStream, const std::shared_ptr<CdsItem>& item) const;
@@ -0,0 +1,265 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    thumbnail_cache.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file thumbnail_cache.cc
+
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+#include "thumbnail_cache.h" // API
+
+#include <fstream>
+#include <set>
+#include <sys/stat.h>
+#include <utility>
+
+#include "metadata/ffmpeg_handler.h"
+#include "util/logger.h"
+#include "util/tools.h"
+
+#define THUMBNAIL_CACHE_INDEX "thumbnail-cache.idx"
+// the index is written at least this often while thumbnails are added
+#define THUMBNAIL_CACHE_FLUSH_INTERVAL std::chrono::minutes(5)
+
+ThumbnailCache::ThumbnailCache(fs::path base, std::string settings, std::uintmax_t maxSize)
+    : base(std::move(base))
+    , settings(std::move(settings))
+    , maxSize(maxSize)
+    , totalSize(0)
+    , dirty(false)
+    , saved(std::chrono::steady_clock::now())
+{
+    load();
+}
+
+std::string ThumbnailCache::makeKey(const fs::path& movie) const
+{
+    struct stat statbuf;
+    if (stat(movie.c_str(), &statbuf) != 0)
+        return "";
+    return fmt::format("{}:{}:{}", statbuf.st_mtime, statbuf.st_size, settings);
+}
+
+fs::path ThumbnailCache::getIndexPath() const
+{
+    return base / THUMBNAIL_CACHE_INDEX;
+}
+
+void ThumbnailCache::load()
+{
+    std::ifstream index(getIndexPath());
+    if (!index)
+        return;
+
+    // one entry per line: key, size and movie separated by tabs
+    std::string line;
+    while (std::getline(index, line)) {
+        auto keyEnd = line.find('\t');
+        auto sizeEnd = keyEnd == std::string::npos ? std::string::npos : line.find('\t', keyEnd + 1);
+        if (sizeEnd == std::string::npos)
+            continue;
+
+        fs::path movie = line.substr(sizeEnd + 1);
+        if (!movie.is_absolute() || entries.find(movie) != entries.end())
+            continue;
+
+        std::error_code ec;
+        auto size = fs::file_size(getThumbnailCachePath(base, movie), ec);
+        if (ec)
+            continue;
+
+        lru.push_back(movie);
+        entries[movie] = Entry { line.substr(0, keyEnd), size, std::prev(lru.end()) };
+        totalSize += size;
+    }
+    log_debug("Loaded {} thumbnail cache entries, {} bytes", entries.size(), totalSize);
+    evict();
+}
+
+void ThumbnailCache::flush()
+{
+    {
+        AutoLock lock(mutex);
+        if (!dirty || std::chrono::steady_clock::now() - saved < THUMBNAIL_CACHE_FLUSH_INTERVAL)
+            return;
+    }
+    save();
+}
+
+void ThumbnailCache::save()
+{
+    AutoLock saveLock(saveMutex);
+    std::string content;
+    {
+        AutoLock lock(mutex);
+        saved = std::chrono::steady_clock::now();
+        if (!dirty)
+            return;
+        for (const auto& movie : lru) {
+            if (movie.native().find('\n') != std::string::npos)
+                continue;
+            content += fmt::format("{}\t{}\t{}\n", entries.at(movie).key, entries.at(movie).size, movie.native());
+        }
+        dirty = false;
+    }
+
+    try {
+        fs::create_directories(base);
+        auto tmp = getIndexPath();
+        tmp += ".tmp";
+        writeBinaryFile(tmp, reinterpret_cast<const std::byte*>(content.data()), content.size());
+        fs::rename(tmp, getIndexPath());
+    } catch (const std::runtime_error& e) {
+        log_error("Failed to write thumbnail cache index: {}", e.what());
+    }
+}
+
+std::uintmax_t ThumbnailCache::getSize()
+{
+    AutoLock lock(mutex);
+    return totalSize;
+}
+
+void ThumbnailCache::remove(EntryMap::iterator it)
+{
+    std::error_code ec;
+    fs::remove(getThumbnailCachePath(base, it->first), ec);
+    totalSize -= it->second.size;
+    lru.erase(it->second.lru);
+    entries.erase(it);
+    dirty = true;
+}
+
+void ThumbnailCache::evict()
+{
+    if (maxSize == 0)
+        return;
+    while (totalSize > maxSize && !lru.empty()) {
+        log_debug("Evicting thumbnail of {}", lru.back().c_str());
+        remove(entries.find(lru.back()));
+    }
+}
+
+bool ThumbnailCache::isValid(const fs::path& movie)
+{
+    auto key = makeKey(movie);
+    AutoLock lock(mutex);
+    auto it = entries.find(movie);
+    return it != entries.end() && !key.empty() && it->second.key == key;
+}
+
+std::optional<std::vector<std::byte>> ThumbnailCache::get(const fs::path& movie)
+{
+    auto key = makeKey(movie);
+    {
+        AutoLock lock(mutex);
+        auto it = entries.find(movie);
+        if (it == entries.end())
+            return std::nullopt;
+        if (key.empty() || it->second.key != key) {
+            log_debug("Cached thumbnail of {} is outdated", movie.c_str());
+            remove(it);
+            return std::nullopt;
+        }
+        lru.splice(lru.begin(), lru, it->second.lru);
+        dirty = true;
+    }
+    return readBinaryFile(getThumbnailCachePath(base, movie));
+}
+
+void ThumbnailCache::put(const fs::path& movie, const std::vector<std::byte>& data)
+{
+    auto key = makeKey(movie);
+    if (key.empty())
+        return;
+
+    try {
+        auto path = getThumbnailCachePath(base, movie);
+        fs::create_directories(path.parent_path());
+        writeBinaryFile(path, data.data(), data.size());
+    } catch (const std::runtime_error& e) {
+        log_error("Failed to write thumbnail cache: {}", e.what());
+        return;
+    }
+
+    AutoLock lock(mutex);
+    auto it = entries.find(movie);
+    if (it != entries.end()) {
+        totalSize -= it->second.size;
+        lru.erase(it->second.lru);
+        entries.erase(it);
+    }
+    lru.push_front(movie);
+    entries[movie] = Entry { key, data.size(), lru.begin() };
+    totalSize += data.size();
+    dirty = true;
+    evict();
+}
+
+void ThumbnailCache::sweep(const std::function<bool(const fs::path&)>& isKnown)
+{
+    auto started = fs::file_time_type::clock::now();
+    std::vector<fs::path> movies;
+    {
+        AutoLock lock(mutex);
+        movies.assign(lru.begin(), lru.end());
+    }
+
+    size_t removed = 0;
+    for (const auto& movie : movies) {
+        std::error_code ec;
+        if (fs::is_regular_file(movie, ec) && isKnown(movie))
+            continue;
+        AutoLock lock(mutex);
+        auto it = entries.find(movie);
+        if (it != entries.end()) {
+            remove(it);
+            removed++;
+        }
+    }
+
+    // thumbnails without index entry were written by an older version or lost their entry
+    std::set<fs::path> known;
+    {
+        AutoLock lock(mutex);
+        for (const auto& [movie, entry] : entries)
+            known.insert(getThumbnailCachePath(base, movie));
+    }
+    const std::string suffix = "-thumb.jpg";
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(base, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        const auto& path = it->path();
+        auto name = path.filename().string();
+        std::error_code fileEc;
+        if (!it->is_regular_file(fileEc) || name.size() < suffix.size() || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+            continue;
+        // files written after the start of the sweep may not be in the snapshot yet
+        if (known.find(path) == known.end() && it->last_write_time(fileEc) < started) {
+            if (fs::remove(path, fileEc))
+                removed++;
+        }
+    }
+
+    log_info("Thumbnail cache sweep removed {} orphans, {} bytes in use", removed, getSize());
+    save();
+}
+
+#endif // HAVE_FFMPEG && HAVE_FFMPEGTHUMBNAILER
@@ -0,0 +1,113 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    thumbnail_cache.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file thumbnail_cache.h
+/// \brief Definition of the ThumbnailCache class.
+
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+
+#ifndef __THUMBNAIL_CACHE_H__
+#define __THUMBNAIL_CACHE_H__
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+namespace fs = std::filesystem;
+
+/// \brief Size bounded store for generated video thumbnails
+///
+/// Every entry remembers modification time and size of the movie and the
+/// thumbnailer settings it was created with, a thumbnail is only returned
+/// while all of them are unchanged. The index is kept in the cache directory
+/// so the least recently used entries can be evicted across restarts.
+class ThumbnailCache {
+public:
+    /// \param base cache directory
+    /// \param settings description of the thumbnailer settings, part of the entry key
+    /// \param maxSize limit for the sum of all thumbnails in bytes, 0 is unlimited
+    ThumbnailCache(fs::path base, std::string settings, std::uintmax_t maxSize);
+
+    /// \brief thumbnail of the movie if the cached one is still valid
+    std::optional<std::vector<std::byte>> get(const fs::path& movie);
+
+    /// \brief check for a valid thumbnail without reading it
+    bool isValid(const fs::path& movie);
+
+    void put(const fs::path& movie, const std::vector<std::byte>& data);
+
+    /// \brief remove thumbnails of movies that are gone and files without index entry
+    /// \param isKnown tells if the movie is still part of the database
+    void sweep(const std::function<bool(const fs::path&)>& isKnown);
+
+    /// \brief write the index to the cache directory
+    void save();
+
+    /// \brief write the index if it changed and was not written for a while
+    void flush();
+
+    std::uintmax_t getSize();
+
+protected:
+    struct Entry {
+        std::string key;
+        std::uintmax_t size;
+        std::list<fs::path>::iterator lru;
+    };
+    using EntryMap = std::map<fs::path, Entry>;
+
+    /// \brief key of the current state of the movie, empty if it cannot be read
+    std::string makeKey(const fs::path& movie) const;
+    fs::path getIndexPath() const;
+
+    void load();
+    void remove(EntryMap::iterator it);
+    void evict();
+
+    fs::path base;
+    std::string settings;
+    std::uintmax_t maxSize;
+    std::uintmax_t totalSize;
+    bool dirty;
+    std::chrono::steady_clock::time_point saved;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+    /// \brief only one thread writes the index file
+    std::mutex saveMutex;
+
+    EntryMap entries;
+    /// \brief most recently used movie first
+    std::list<fs::path> lru;
+};
+
+#endif // __THUMBNAIL_CACHE_H__
+
+#endif // HAVE_FFMPEG && HAVE_FFMPEGTHUMBNAILER
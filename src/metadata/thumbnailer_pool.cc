@@ -0,0 +1,283 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    thumbnailer_pool.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file thumbnailer_pool.cc
+
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+#include "thumbnailer_pool.h" // API
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include <libffmpegthumbnailer/videothumbnailerc.h>
+
+#include "config/config.h"
+#include "exceptions.h"
+#include "metadata/ffmpeg_handler.h"
+#include "metadata/thumbnail_cache.h"
+#include "util/logger.h"
+
+// further pre-generation requests are dropped, the thumbnail is generated on the first request instead
+#define THUMBNAILER_MAX_PREGENERATE 1000
+
+// getInfo and open of one request follow each other closely
+#define SERVED_THUMBNAIL_LIFETIME std::chrono::seconds(5)
+
+namespace {
+template <auto C, auto D>
+inline auto wrap_unique_ptr()
+{
+    auto raw_ptr = C();
+    return std::unique_ptr<std::remove_pointer_t<decltype(raw_ptr)>, decltype(D)>(raw_ptr, D);
+}
+} // namespace
+
+ThumbnailerPool::ThumbnailerPool(std::shared_ptr<Config> config)
+    : config(std::move(config))
+    , shutdownFlag(false)
+{
+    if (this->config->getBoolOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_ENABLED)) {
+        // thumbnails created with other settings must not be served
+        auto settings = fmt::format("{}/{}/{}/{}",
+            this->config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_THUMBSIZE),
+            this->config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_SEEK_PERCENTAGE),
+            this->config->getBoolOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_FILMSTRIP_OVERLAY),
+            this->config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_IMAGE_QUALITY));
+        auto maxSize = std::uintmax_t(this->config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_CACHE_DIR_MAX_SIZE)) * 1024 * 1024;
+        cache = std::make_unique<ThumbnailCache>(getThumbnailCacheBasePath(*this->config), settings, maxSize);
+    }
+    // without cache the thumbnails would be generated for nothing
+    pregenerateEnabled = cache != nullptr && this->config->getBoolOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_PREGENERATE);
+
+    int count = this->config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_WORKERS);
+    for (int i = 0; i < count; i++)
+        workers.emplace_back(&ThumbnailerPool::threadProc, this);
+    log_debug("Started {} thumbnail workers", count);
+}
+
+ThumbnailerPool::~ThumbnailerPool()
+{
+    shutdown();
+}
+
+void ThumbnailerPool::shutdown()
+{
+    {
+        AutoLock lock(mutex);
+        if (shutdownFlag)
+            return;
+        shutdownFlag = true;
+    }
+    cond.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers.clear();
+    if (sweeper.joinable())
+        sweeper.join();
+
+    // nobody will pick up the remaining requests
+    for (auto& [location, promise] : promises) {
+        promise.set_exception(std::make_exception_ptr(std::runtime_error("thumbnailer shut down")));
+    }
+    promises.clear();
+    pending.clear();
+    queue.clear();
+    pregenerateQueue.clear();
+    served.clear();
+
+    if (cache != nullptr)
+        cache->save();
+}
+
+std::optional<std::vector<std::byte>> ThumbnailerPool::getCached(const fs::path& location)
+{
+    if (cache == nullptr)
+        return std::nullopt;
+    auto data = cache->get(location);
+    cache->flush();
+    return data;
+}
+
+ThumbnailerPool::Result ThumbnailerPool::generate(const fs::path& location)
+{
+    return enqueue(location, true);
+}
+
+void ThumbnailerPool::pregenerate(const fs::path& location)
+{
+    if (!pregenerateEnabled || cache->isValid(location))
+        return;
+    enqueue(location, false);
+}
+
+std::shared_ptr<const std::vector<std::byte>> ThumbnailerPool::getServed(const fs::path& location)
+{
+    AutoLock lock(mutex);
+    auto it = served.find(location);
+    if (it == served.end() || std::chrono::steady_clock::now() - it->second.first > SERVED_THUMBNAIL_LIFETIME)
+        return nullptr;
+    return it->second.second;
+}
+
+void ThumbnailerPool::setServed(const fs::path& location, std::shared_ptr<const std::vector<std::byte>> data)
+{
+    auto now = std::chrono::steady_clock::now();
+    AutoLock lock(mutex);
+    for (auto it = served.begin(); it != served.end();) {
+        if (now - it->second.first > SERVED_THUMBNAIL_LIFETIME)
+            it = served.erase(it);
+        else
+            ++it;
+    }
+    served[location] = { now, std::move(data) };
+}
+
+void ThumbnailerPool::sweepCache(std::function<bool(const fs::path&)> isKnown)
+{
+    if (cache == nullptr)
+        return;
+    AutoLock lock(mutex);
+    if (shutdownFlag || sweeper.joinable())
+        return;
+    sweeper = std::thread { [this, isKnown = std::move(isKnown)] {
+        cache->sweep(isKnown);
+    } };
+}
+
+ThumbnailerPool::Result ThumbnailerPool::enqueue(const fs::path& location, bool urgent)
+{
+    AutoLock lock(mutex);
+    auto it = pending.find(location);
+    if (it != pending.end()) {
+        log_debug("Thumbnail for {} already requested", location.c_str());
+        if (urgent) {
+            // a client is waiting now, move a pre-generation request to the front
+            auto pos = std::find(pregenerateQueue.begin(), pregenerateQueue.end(), location);
+            if (pos != pregenerateQueue.end()) {
+                pregenerateQueue.erase(pos);
+                queue.push_front(location);
+            }
+        }
+        return it->second;
+    }
+
+    if (!urgent && pregenerateQueue.size() >= THUMBNAILER_MAX_PREGENERATE) {
+        log_debug("Thumbnail queue is full, {} is generated on request", location.c_str());
+        return {};
+    }
+
+    if (shutdownFlag) {
+        std::promise<std::vector<std::byte>> failed;
+        failed.set_exception(std::make_exception_ptr(std::runtime_error("thumbnailer shut down")));
+        return failed.get_future().share();
+    }
+
+    auto& promise = promises[location];
+    auto result = promise.get_future().share();
+    pending[location] = result;
+    if (urgent)
+        queue.push_front(location);
+    else
+        pregenerateQueue.push_back(location);
+    cond.notify_one();
+    return result;
+}
+
+void ThumbnailerPool::threadProc()
+{
+#ifdef FFMPEGTHUMBNAILER_OLD_API
+    auto th = wrap_unique_ptr<create_thumbnailer, destroy_thumbnailer>();
+#else
+    auto th = wrap_unique_ptr<video_thumbnailer_create, video_thumbnailer_destroy>();
+#endif // old api
+
+    th->seek_percentage = config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_SEEK_PERCENTAGE);
+
+    if (config->getBoolOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_FILMSTRIP_OVERLAY))
+        th->overlay_film_strip = 1;
+    else
+        th->overlay_film_strip = 0;
+
+    th->thumbnail_size = config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_THUMBSIZE);
+    th->thumbnail_image_quality = config->getIntOption(CFG_SERVER_EXTOPTS_FFMPEGTHUMBNAILER_IMAGE_QUALITY);
+    th->thumbnail_image_type = Jpeg;
+
+    AutoLockU lock(mutex);
+    while (true) {
+        cond.wait(lock, [this] { return shutdownFlag || !queue.empty() || !pregenerateQueue.empty(); });
+        if (shutdownFlag)
+            break;
+
+        auto& next = queue.empty() ? pregenerateQueue : queue;
+        auto location = next.front();
+        next.pop_front();
+        lock.unlock();
+
+        std::vector<std::byte> data;
+        std::exception_ptr error;
+        try {
+#ifdef FFMPEGTHUMBNAILER_OLD_API
+            auto img = wrap_unique_ptr<create_image_data, destroy_image_data>();
+#else
+            auto img = wrap_unique_ptr<video_thumbnailer_create_image_data, video_thumbnailer_destroy_image_data>();
+#endif // old api
+
+            log_debug("Generating thumbnail for file: {}", location.c_str());
+
+#ifdef FFMPEGTHUMBNAILER_OLD_API
+            if (generate_thumbnail_to_buffer(th.get(), location.c_str(), img.get()) != 0)
+#else
+            if (video_thumbnailer_generate_thumbnail_to_buffer(th.get(), location.c_str(), img.get()) != 0)
+#endif // old api
+            {
+                throw_std_runtime_error(fmt::format("Could not generate thumbnail for {}", location.c_str()));
+            }
+
+            auto begin = reinterpret_cast<const std::byte*>(img->image_data_ptr);
+            data.assign(begin, begin + img->image_data_size);
+
+            if (cache != nullptr) {
+                cache->put(location, data);
+                cache->flush();
+            }
+        } catch (const std::exception&) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        auto it = promises.find(location);
+        if (it != promises.end()) {
+            if (error)
+                it->second.set_exception(error);
+            else
+                it->second.set_value(std::move(data));
+            promises.erase(it);
+        }
+        pending.erase(location);
+    }
+}
+
+#endif // HAVE_FFMPEG && HAVE_FFMPEGTHUMBNAILER
@@ -0,0 +1,119 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    thumbnailer_pool.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file thumbnailer_pool.h
+/// \brief Definition of the ThumbnailerPool class.
+
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+
+#ifndef __THUMBNAILER_POOL_H__
+#define __THUMBNAILER_POOL_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+namespace fs = std::filesystem;
+
+class Config;
+class ThumbnailCache;
+
+/// \brief Generates video thumbnails on a fixed number of worker threads
+///
+/// ffmpegthumbnailer instances must not be shared between threads, so every
+/// worker owns one for its whole lifetime. Requests for a file that is
+/// already queued or being generated share the result of the first request.
+/// Requests of clients are served before thumbnails pre-generated on import.
+class ThumbnailerPool {
+public:
+    using Result = std::shared_future<std::vector<std::byte>>;
+
+    explicit ThumbnailerPool(std::shared_ptr<Config> config);
+    ~ThumbnailerPool();
+
+    ThumbnailerPool(const ThumbnailerPool&) = delete;
+    ThumbnailerPool& operator=(const ThumbnailerPool&) = delete;
+
+    /// \brief thumbnail from the cache if it matches the current file
+    std::optional<std::vector<std::byte>> getCached(const fs::path& location);
+
+    /// \brief queue thumbnail generation for a file
+    /// \return future holding the jpeg data, it holds an exception if generation failed
+    Result generate(const fs::path& location);
+
+    /// \brief queue generation of a thumbnail that is not in the cache yet, if enabled
+    void pregenerate(const fs::path& location);
+
+    /// \brief thumbnail or placeholder that was served for a file in the last seconds
+    ///
+    /// libupnp asks for the size and the data of a file in two calls, both
+    /// have to see the same data even if the thumbnail got ready in between.
+    std::shared_ptr<const std::vector<std::byte>> getServed(const fs::path& location);
+
+    /// \brief remember what was served for a file
+    void setServed(const fs::path& location, std::shared_ptr<const std::vector<std::byte>> data);
+
+    /// \brief remove cache entries of files that are not part of the database anymore
+    /// \param isKnown called on a background thread for every cached file
+    void sweepCache(std::function<bool(const fs::path&)> isKnown);
+
+    void shutdown();
+
+protected:
+    void threadProc();
+    Result enqueue(const fs::path& location, bool urgent);
+
+    std::shared_ptr<Config> config;
+    std::unique_ptr<ThumbnailCache> cache;
+    bool pregenerateEnabled;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+    using AutoLockU = std::unique_lock<decltype(mutex)>;
+
+    /// \brief requests of clients, served first
+    std::deque<fs::path> queue;
+    /// \brief thumbnails of imported files, limited so a large import does not pile up requests
+    std::deque<fs::path> pregenerateQueue;
+    std::map<fs::path, std::promise<std::vector<std::byte>>> promises;
+    std::map<fs::path, Result> pending;
+    std::map<fs::path, std::pair<std::chrono::steady_clock::time_point, std::shared_ptr<const std::vector<std::byte>>>> served;
+    bool shutdownFlag;
+
+    std::vector<std::thread> workers;
+    std::thread sweeper;
+};
+
+#endif // __THUMBNAILER_POOL_H__
+
+#endif // HAVE_FFMPEG && HAVE_FFMPEGTHUMBNAILER
@@ -90,7 +90,7 @@ std::unique_ptr<pugi::xml_document> ATrailersService::getData()
 
     try {
         log_debug("DOWNLOADING URL: {}", service_url.c_str());
-        buffer = URL::download(service_url, &retcode,
+        buffer = URL(content->getCurlEngine()).download(service_url, &retcode,
             curl_handle, false, true, true);
     } catch (const std::runtime_error& ex) {
         log_error("Failed to download Apple Trailers XML data: {}",
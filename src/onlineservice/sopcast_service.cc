@@ -82,7 +82,7 @@ std::unique_ptr<pugi::xml_document> SopCastService::getData()
 
     try {
         log_debug("DOWNLOADING URL: {}", SOPCAST_CHANNEL_URL);
-        buffer = URL::download(SOPCAST_CHANNEL_URL, &retcode,
+        buffer = URL(content->getCurlEngine()).download(SOPCAST_CHANNEL_URL, &retcode,
             curl_handle, false, true, true);
 
     } catch (const std::runtime_error& ex) {
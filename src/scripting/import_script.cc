@@ -36,6 +36,7 @@
 
 #include "config/config_manager.h"
 #include "js_functions.h"
+#include "runtime.h"
 
 ImportScript::ImportScript(const std::shared_ptr<Config>& config,
     std::shared_ptr<Database> database,
@@ -50,6 +51,34 @@ ImportScript::ImportScript(const std::shared_ptr<Config>& config,
     } catch (const std::runtime_error& ex) {
         throw ex;
     }
+
+    // run the script once without orig, if it only defines its entry point
+    // the compiled function is called for every object from now on
+    Runtime::AutoLock lock(runtime->getMutex());
+    duk_push_thread_stash(ctx, ctx);
+    duk_get_prop_string(ctx, -1, "script");
+    duk_remove(ctx, -2);
+    if (duk_pcall(ctx, 0) != DUK_EXEC_SUCCESS)
+        log_debug("Import script needs orig at top level: {}", duk_safe_to_string(ctx, -1));
+    duk_pop(ctx);
+
+    duk_get_global_string(ctx, IMPORT_SCRIPT_ENTRY_POINT);
+    entryPoint = duk_is_function(ctx, -1);
+    duk_pop(ctx);
+    log_debug("Import script {} {}", scriptPath.c_str(), entryPoint ? "uses entry point " IMPORT_SCRIPT_ENTRY_POINT : "is run for every object");
+}
+
+void ImportScript::callEntryPoint()
+{
+    Runtime::AutoLock lock(runtime->getMutex());
+    duk_get_global_string(ctx, IMPORT_SCRIPT_ENTRY_POINT);
+    duk_get_global_string(ctx, "orig");
+    if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS) {
+        log_error("Failed to execute script: {}", duk_safe_to_string(ctx, -1));
+        duk_pop(ctx);
+        throw_std_runtime_error("Script: failed to execute " IMPORT_SCRIPT_ENTRY_POINT);
+    }
+    duk_pop(ctx);
 }
 
 void ImportScript::processCdsObject(const std::shared_ptr<CdsObject>& obj, const std::string& scriptpath)
@@ -60,7 +89,10 @@ void ImportScript::processCdsObject(const std::shared_ptr<CdsObject>& obj, const
         duk_put_global_string(ctx, "orig");
         duk_push_string(ctx, scriptpath.c_str());
         duk_put_global_string(ctx, "object_script_path");
-        execute();
+        if (entryPoint)
+            callEntryPoint();
+        else
+            execute();
         duk_push_global_object(ctx);
         duk_del_prop_string(ctx, -1, "orig");
         duk_del_prop_string(ctx, -1, "object_script_path");
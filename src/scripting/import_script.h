@@ -43,6 +43,9 @@ class ContentManager;
 class Runtime;
 class Database;
 
+// function the import script may define instead of processing orig at top level
+#define IMPORT_SCRIPT_ENTRY_POINT "importItem"
+
 class ImportScript : public Script {
 public:
     ImportScript(const std::shared_ptr<Config>& config,
@@ -52,6 +55,13 @@ public:
     ~ImportScript() override;
     void processCdsObject(const std::shared_ptr<CdsObject>& obj, const std::string& scriptpath);
     script_class_t whoami() override { return S_IMPORT; }
+
+protected:
+    /// \brief call the entry point of the script with orig
+    void callEntryPoint();
+
+    /// \brief the script defines IMPORT_SCRIPT_ENTRY_POINT and is not run for every object
+    bool entryPoint { false };
 };
 
 #endif // __SCRIPTING_IMPORT_SCRIPT_H__
@@ -38,6 +38,7 @@
 #include "content_manager.h"
 #include "database/database.h"
 #include "metadata/metadata_handler.h"
+#include "runtime.h"
 #include "script.h"
 #include "util/string_converter.h"
 
@@ -107,6 +108,8 @@ duk_ret_t js_addCdsObject(duk_context* ctx)
             return 0;
         }
 
+        // the import script usually adds orig itself, it is then converted only once
+        bool addsOrig = (self->whoami() == S_IMPORT) && duk_strict_equals(ctx, 0, -1);
         auto orig_object = self->dukObject2cdsObject(self->getProcessedObject());
         if (orig_object == nullptr)
             return 0;
@@ -144,12 +147,14 @@ duk_ret_t js_addCdsObject(duk_context* ctx)
             } else
                 cds_obj = self->dukObject2cdsObject(self->getProcessedObject());
         } else
-            cds_obj = self->dukObject2cdsObject(orig_object);
+            cds_obj = addsOrig ? orig_object : self->dukObject2cdsObject(orig_object);
 
         if (cds_obj == nullptr) {
             return 0;
         }
 
+        // scripts on other heaps run at the same time, their changes are made one by one
+        Runtime::AutoLock writeLock(*self->getRuntime()->getWriteMutex());
         int id;
 
         if ((self->whoami() == S_PLAYLIST) && (self->getConfig()->getBoolOption(CFG_IMPORT_SCRIPTING_PLAYLIST_SCRIPT_LINK_OBJECTS))) {
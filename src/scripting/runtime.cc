@@ -32,6 +32,8 @@
 #ifdef HAVE_JS
 #include "runtime.h" // API
 
+#include <utility>
+
 [[noreturn]] static void fatal_handler(void* udata, const char* msg)
 {
     log_error("Fatal Duktape error: {}", msg ? msg : "no message");
@@ -39,6 +41,12 @@
 }
 
 Runtime::Runtime()
+    : Runtime(std::make_shared<std::recursive_mutex>())
+{
+}
+
+Runtime::Runtime(std::shared_ptr<std::recursive_mutex> writeMutex)
+    : writeMutex(std::move(writeMutex))
 {
     ctx = duk_create_heap(nullptr, nullptr, nullptr, nullptr, fatal_handler);
 }
@@ -33,6 +33,7 @@
 #define __SCRIPTING_RUNTIME_H__
 
 #include <duktape.h>
+#include <memory>
 #include <mutex>
 #include <pthread.h>
 
@@ -43,9 +44,12 @@ class Runtime {
 protected:
     duk_context* ctx;
     std::recursive_mutex mutex;
+    std::shared_ptr<std::recursive_mutex> writeMutex;
 
 public:
     Runtime();
+    /// \brief create a heap that writes to the database in turn with other heaps
+    explicit Runtime(std::shared_ptr<std::recursive_mutex> writeMutex);
     virtual ~Runtime();
 
     /// \brief Returns a new (sub)context. !!! Not thread-safe !!!
@@ -54,6 +58,9 @@ public:
 
     using AutoLock = std::lock_guard<std::recursive_mutex>;
     std::recursive_mutex& getMutex() { return mutex; }
+
+    /// \brief serializes the changes scripts make to the database
+    const std::shared_ptr<std::recursive_mutex>& getWriteMutex() const { return writeMutex; }
 };
 
 #endif // __SCRIPTING_RUNTIME_H__
@@ -32,6 +32,9 @@
 #ifdef HAVE_JS
 #include "script.h" // API
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <utility>
 
 #include "cds_objects.h"
@@ -273,11 +276,179 @@ void Script::_load(const std::string& scriptPath)
         throw_std_runtime_error(std::string { "Failed to convert import script:" } + e.what());
     }
 
+    // bytecode is only valid for the engine version that produced it
+    auto compiledKey = fmt::format("{}\n{}\n{}", DUK_VERSION, scriptPath, scriptText);
+    auto compiledPath = getCompiledPath(scriptPath, compiledKey);
+    if (loadCompiled(compiledPath, compiledKey))
+        return;
+
     duk_push_string(ctx, scriptPath.c_str());
     if (duk_pcompile_lstring_filename(ctx, 0, scriptText.c_str(), scriptText.length()) != 0) {
         log_error("Failed to load script: {}", duk_safe_to_string(ctx, -1));
         throw_std_runtime_error("Scripting: failed to compile " + scriptPath);
     }
+    storeCompiled(compiledPath, compiledKey);
+}
+
+fs::path Script::getCompiledPath(const std::string& scriptPath, const std::string& compiledKey) const
+{
+#ifdef DUK_USE_BYTECODE_DUMP_SUPPORT
+    auto name = fmt::format("{}-{:08x}-{}.bin", fs::path(scriptPath).stem().string(), stringHash(compiledKey), compiledKey.length());
+    return fs::path(config->getOption(CFG_SERVER_HOME)) / JS_BYTECODE_CACHE_DIR / name;
+#else
+    return {};
+#endif
+}
+
+#ifdef DUK_USE_BYTECODE_DUMP_SUPPORT
+static duk_ret_t js_load_function(duk_context* ctx, void* /*udata*/)
+{
+    duk_load_function(ctx);
+    return 1;
+}
+
+static duk_ret_t js_dump_function(duk_context* ctx, void* /*udata*/)
+{
+    duk_dump_function(ctx);
+    return 1;
+}
+
+// duk_load_function does not validate the bytecode and crashes on broken
+// input, so every file starts with this header and is checked before loading
+struct CompiledHeader {
+    char magic[8];
+    std::uint32_t duktapeVersion;
+    std::uint32_t sourceHash;
+    std::uint64_t sourceLength;
+    std::uint64_t payloadLength;
+    std::uint64_t payloadChecksum;
+};
+static constexpr char COMPILED_MAGIC[8] = { 'G', 'B', 'J', 'S', 'B', 'C', '0', '1' };
+
+static std::uint64_t compiledChecksum(const std::byte* data, std::size_t size)
+{
+    // FNV-1a
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= std::to_integer<std::uint64_t>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static bool isValidCompiled(const std::vector<std::byte>& file, const std::string& compiledKey)
+{
+    CompiledHeader header;
+    if (file.size() <= sizeof(header))
+        return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+    auto payloadSize = file.size() - sizeof(header);
+    return std::memcmp(header.magic, COMPILED_MAGIC, sizeof(header.magic)) == 0
+        && header.duktapeVersion == DUK_VERSION
+        && header.sourceHash == stringHash(compiledKey)
+        && header.sourceLength == compiledKey.length()
+        && header.payloadLength == payloadSize
+        && header.payloadChecksum == compiledChecksum(file.data() + sizeof(header), payloadSize);
+}
+#endif
+
+bool Script::loadCompiled(const fs::path& compiledPath, const std::string& compiledKey)
+{
+#ifdef DUK_USE_BYTECODE_DUMP_SUPPORT
+    if (compiledPath.empty())
+        return false;
+    auto file = readBinaryFile(compiledPath);
+    if (!file)
+        return false;
+
+    std::error_code ec;
+    if (!isValidCompiled(*file, compiledKey)) {
+        log_warning("Removing invalid compiled script {}", compiledPath.c_str());
+        fs::remove(compiledPath, ec);
+        return false;
+    }
+
+    auto size = file->size() - sizeof(CompiledHeader);
+    auto buffer = duk_push_fixed_buffer(ctx, size);
+    std::copy(file->begin() + sizeof(CompiledHeader), file->end(), static_cast<std::byte*>(buffer));
+    if (duk_safe_call(ctx, js_load_function, nullptr, 1, 1) != DUK_EXEC_SUCCESS) {
+        log_warning("Removing compiled script {}: {}", compiledPath.c_str(), duk_safe_to_string(ctx, -1));
+        duk_pop(ctx);
+        fs::remove(compiledPath, ec);
+        return false;
+    }
+    log_debug("Loaded compiled script {}", compiledPath.c_str());
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Script::storeCompiled(const fs::path& compiledPath, const std::string& compiledKey)
+{
+#ifdef DUK_USE_BYTECODE_DUMP_SUPPORT
+    if (compiledPath.empty())
+        return;
+
+    // keep the compiled function on the stack, only the copy is dumped
+    duk_dup_top(ctx);
+    if (duk_safe_call(ctx, js_dump_function, nullptr, 1, 1) != DUK_EXEC_SUCCESS) {
+        log_warning("Failed to dump compiled script: {}", duk_safe_to_string(ctx, -1));
+        duk_pop(ctx);
+        return;
+    }
+
+    duk_size_t size = 0;
+    auto data = static_cast<const std::byte*>(duk_get_buffer_data(ctx, -1, &size));
+    CompiledHeader header;
+    std::memcpy(header.magic, COMPILED_MAGIC, sizeof(header.magic));
+    header.duktapeVersion = DUK_VERSION;
+    header.sourceHash = stringHash(compiledKey);
+    header.sourceLength = compiledKey.length();
+    header.payloadLength = size;
+    header.payloadChecksum = compiledChecksum(data, size);
+    std::vector<std::byte> file(sizeof(header) + size);
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::copy(data, data + size, file.begin() + sizeof(header));
+    try {
+        fs::create_directories(compiledPath.parent_path());
+        auto tmp = compiledPath;
+        tmp += ".tmp";
+        writeBinaryFile(tmp, file.data(), file.size());
+        fs::rename(tmp, compiledPath);
+    } catch (const std::exception& e) {
+        log_warning("Failed to write compiled script {}: {}", compiledPath.c_str(), e.what());
+    }
+    duk_pop(ctx);
+    pruneCompiled(compiledPath);
+#endif
+}
+
+void Script::pruneCompiled(const fs::path& compiledPath)
+{
+    // older versions of the script have the same stem and a different hash
+    auto stem = compiledPath.filename().string();
+    stem = stem.substr(0, stem.rfind('-'));
+    stem = stem.substr(0, stem.rfind('-') + 1);
+
+    std::error_code ec;
+    for (auto it = fs::directory_iterator(compiledPath.parent_path(), ec); !ec && it != fs::directory_iterator(); it.increment(ec)) {
+        auto name = it->path().filename().string();
+        if (it->path() == compiledPath || !startswith(name, stem))
+            continue;
+        // <hash>-<length>.bin as written by storeCompiled
+        auto rest = name.substr(stem.length());
+        auto dot = rest.find('.');
+        if (dot == std::string::npos || rest.find_first_not_of("0123456789abcdef") != 8 || rest[8] != '-'
+            || rest.find_first_not_of("0123456789", 9) != dot)
+            continue;
+        auto ext = rest.substr(dot);
+        if (ext != ".bin" && ext != ".bin.tmp")
+            continue;
+        log_debug("Removing outdated compiled script {}", it->path().c_str());
+        std::error_code removeEc;
+        fs::remove(it->path(), removeEc);
+    }
 }
 
 void Script::load(const std::string& scriptPath)
@@ -33,7 +33,9 @@
 #define __SCRIPTING_SCRIPT_H__
 
 #include <duktape.h>
+#include <filesystem>
 #include <mutex>
+namespace fs = std::filesystem;
 
 #include "common.h"
 
@@ -48,6 +50,9 @@ class StringConverter;
 // perform garbage collection after script has been run for x times
 #define JS_CALL_GC_AFTER_NUM (1000)
 
+// compiled scripts are kept in this subdirectory of the server home
+#define JS_BYTECODE_CACHE_DIR "js-cache"
+
 typedef enum {
     S_IMPORT = 0,
     S_PLAYLIST
@@ -91,6 +96,7 @@ public:
     std::shared_ptr<Config> getConfig() const { return config; }
     std::shared_ptr<Database> getDatabase() const { return database; }
     std::shared_ptr<ContentManager> getContent() const { return content; }
+    std::shared_ptr<Runtime> getRuntime() const { return runtime; }
 
 protected:
     Script(const std::shared_ptr<Config>& config,
@@ -115,6 +121,12 @@ protected:
 private:
     std::string name;
     void _load(const std::string& scriptPath);
+    fs::path getCompiledPath(const std::string& scriptPath, const std::string& compiledKey) const;
+    /// \brief load the compiled script if its header matches, invalid files are removed
+    bool loadCompiled(const fs::path& compiledPath, const std::string& compiledKey);
+    void storeCompiled(const fs::path& compiledPath, const std::string& compiledKey);
+    /// \brief remove compiled files of other versions of the script
+    void pruneCompiled(const fs::path& compiledPath);
     void _execute();
     std::unique_ptr<StringConverter> _p2i;
     std::unique_ptr<StringConverter> _j2i;
@@ -448,8 +448,10 @@ std::string DefaultSQLEmitter::emitSQL(const ASTNode* node) const
     std::string predicates = node->emit();
     if (predicates.length() > 0) {
         std::ostringstream sql;
+        // references only hold the metadata that differs from their base object
         sql << "from mt_cds_object c "
-            << "inner join mt_metadata m on c.id = m.item_id "
+            << "left join mt_cds_object rf on c.ref_id = rf.id "
+            << "inner join mt_metadata m on (c.id = m.item_id or c.ref_id = m.item_id) "
             << "where "
             << predicates;
         return sql.str();
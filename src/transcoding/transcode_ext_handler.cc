@@ -53,6 +53,7 @@
 #include "metadata/metadata_handler.h"
 #include "server.h"
 #include "transcoding_process_executor.h"
+#include "transcoding_scheduler.h"
 #include "update_manager.h"
 #include "util/process.h"
 #include "util/tools.h"
@@ -78,6 +79,10 @@ std::unique_ptr<IOHandler> TranscodeExternalHandler::open(std::shared_ptr<Transc
     if (profile == nullptr)
         throw_std_runtime_error("Transcoding of file " + location + "requested but no profile given");
 
+    // blocks until the scheduler admits another transcoder, may switch to a cheaper profile
+    auto slot = content->getTranscodingScheduler()->acquire(profile, config->getTranscodingProfileListOption(CFG_TRANSCODING_PROFILE_LIST));
+    profile = slot->getProfile();
+
     bool isURL = (IS_CDS_ITEM_INTERNAL_URL(obj->getObjectType()) || IS_CDS_ITEM_EXTERNAL_URL(obj->getObjectType()));
 
 #if 0
@@ -143,7 +148,7 @@ std::unique_ptr<IOHandler> TranscodeExternalHandler::open(std::shared_ptr<Transc
             try {
                 chmod(location.c_str(), S_IWUSR | S_IRUSR);
 
-                std::unique_ptr<IOHandler> c_ioh = std::make_unique<CurlIOHandler>(url, nullptr,
+                std::unique_ptr<IOHandler> c_ioh = std::make_unique<CurlIOHandler>(content->getCurlEngine(), url,
                     config->getIntOption(CFG_EXTERNAL_TRANSCODING_CURL_BUFFER_SIZE),
                     config->getIntOption(CFG_EXTERNAL_TRANSCODING_CURL_FILL_SIZE));
                 std::unique_ptr<IOHandler> p_ioh = std::make_unique<ProcessIOHandler>(content, location, nullptr);
@@ -194,6 +199,7 @@ std::unique_ptr<IOHandler> TranscodeExternalHandler::open(std::shared_ptr<Transc
     log_debug("Arguments: {}", profile->getArguments().c_str());
     auto main_proc = std::make_shared<TranscodingProcessExecutor>(profile->getCommand(), arglist);
     main_proc->removeFile(fifo_name);
+    main_proc->setSlot(std::move(slot));
     if (isURL && (!profile->acceptURL())) {
         main_proc->removeFile(location);
     }
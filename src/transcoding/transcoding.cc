@@ -50,6 +50,8 @@ TranscodingProfile::TranscodingProfile()
     thumbnail = false;
     sample_frequency = SOURCE; // keep original
     number_of_channels = SOURCE;
+    max_concurrent = 0;
+    priority = 0;
     fourcc_mode = FCC_None;
 }
 
@@ -66,6 +68,8 @@ TranscodingProfile::TranscodingProfile(transcoding_type_t tr_type, std::string n
     thumbnail = false;
     sample_frequency = SOURCE; // keep original
     number_of_channels = SOURCE;
+    max_concurrent = 0;
+    priority = 0;
     buffer_size = 0;
     chunk_size = 0;
     initial_fill_size = 0;
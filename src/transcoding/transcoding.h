@@ -185,6 +185,18 @@ public:
     void setNumChannels(int chans) { number_of_channels = chans; }
     int getNumChannels() const { return number_of_channels; }
 
+    /// \brief Maximum number of concurrent transcoders of this profile, 0 is unlimited
+    void setMaxConcurrent(int max) { max_concurrent = max; }
+    int getMaxConcurrent() const { return max_concurrent; }
+
+    /// \brief Requests with higher priority are admitted first if transcoding is saturated
+    void setPriority(int prio) { priority = prio; }
+    int getPriority() const { return priority; }
+
+    /// \brief Name of a cheaper profile that is used if this one is saturated
+    void setFallback(const std::string& fallback) { this->fallback = fallback; }
+    std::string getFallback() const { return fallback; }
+
     static std::string mapFourCcMode(avi_fourcc_listmode_t mode);
 
 protected:
@@ -205,6 +217,9 @@ protected:
     transcoding_type_t tr_type;
     int number_of_channels;
     int sample_frequency;
+    int max_concurrent;
+    int priority;
+    std::string fallback;
     std::map<std::string, std::string> attributes;
     std::vector<std::string> fourcc_list;
     avi_fourcc_listmode_t fourcc_mode;
@@ -34,6 +34,8 @@
 #include <unistd.h>
 #include <utility>
 
+#include "transcoding_scheduler.h"
+
 TranscodingProcessExecutor::TranscodingProcessExecutor(const std::string& command, const std::vector<std::string>& arglist)
     : ProcessExecutor(command, arglist)
 {
@@ -44,6 +46,11 @@ void TranscodingProcessExecutor::removeFile(const std::string& filename)
     file_list.push_back(filename);
 }
 
+void TranscodingProcessExecutor::setSlot(std::unique_ptr<TranscodingSlot> slot)
+{
+    this->slot = std::move(slot);
+}
+
 TranscodingProcessExecutor::~TranscodingProcessExecutor()
 {
     kill();
@@ -51,4 +58,5 @@ TranscodingProcessExecutor::~TranscodingProcessExecutor()
     for (const auto& name : file_list) {
         unlink(name.c_str());
     }
+    slot.reset();
 }
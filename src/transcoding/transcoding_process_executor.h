@@ -32,8 +32,12 @@
 #ifndef __TRANSCODING_PROCESS_EXECUTOR_H__
 #define __TRANSCODING_PROCESS_EXECUTOR_H__
 
+#include <memory>
+
 #include "util/process_executor.h"
 
+class TranscodingSlot;
+
 class TranscodingProcessExecutor : public ProcessExecutor {
 public:
     TranscodingProcessExecutor(const std::string& command,
@@ -42,12 +46,17 @@ public:
     /// will be removed once the class is destroyed.
     void removeFile(const std::string& filename);
 
+    /// \brief Keeps the admission slot of the scheduler until the process is gone.
+    void setSlot(std::unique_ptr<TranscodingSlot> slot);
+
     ~TranscodingProcessExecutor() override;
 
 protected:
     /// \brief The files in this list will be removed once the class is no
     /// longer in use.
     std::vector<std::string> file_list;
+
+    std::unique_ptr<TranscodingSlot> slot;
 };
 
 #endif // __TRANSCODING_PROCESS_EXECUTOR_H__
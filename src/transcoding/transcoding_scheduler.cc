@@ -0,0 +1,217 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    transcoding_scheduler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file transcoding_scheduler.cc
+
+#include "transcoding_scheduler.h" // API
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+#include "config/config.h"
+#include "exceptions.h"
+#include "transcoding.h"
+#include "util/logger.h"
+
+TranscodingSlot::TranscodingSlot(std::shared_ptr<TranscodingScheduler> scheduler, std::shared_ptr<TranscodingProfile> profile, bool degraded)
+    : scheduler(std::move(scheduler))
+    , profile(std::move(profile))
+    , degraded(degraded)
+{
+}
+
+TranscodingSlot::~TranscodingSlot()
+{
+    if (scheduler != nullptr)
+        scheduler->release(profile->getName());
+}
+
+TranscodingScheduler::TranscodingScheduler(int maxConcurrent, int maxCpuLoad, int queueTimeout, bool degrade)
+    : maxConcurrent(maxConcurrent)
+    , maxCpuLoad(maxCpuLoad)
+    , queueTimeout(queueTimeout)
+    , degrade(degrade)
+    , runningTotal(0)
+    , nextSeq(0)
+    , totalWait(0)
+{
+}
+
+TranscodingScheduler::TranscodingScheduler(std::shared_ptr<Config> config)
+    : TranscodingScheduler(0, 0, 0, false)
+{
+    this->config = std::move(config);
+    loadLimits();
+}
+
+void TranscodingScheduler::loadLimits()
+{
+    if (config == nullptr)
+        return;
+    maxConcurrent = config->getIntOption(CFG_TRANSCODING_MAX_CONCURRENT);
+    maxCpuLoad = config->getIntOption(CFG_TRANSCODING_MAX_CPU_LOAD);
+    queueTimeout = std::chrono::seconds(config->getIntOption(CFG_TRANSCODING_QUEUE_TIMEOUT));
+    degrade = config->getBoolOption(CFG_TRANSCODING_DEGRADE);
+}
+
+int TranscodingScheduler::getCpuLoad() const
+{
+    double load[1];
+    if (getloadavg(load, 1) < 1)
+        return 0;
+    unsigned int cores = std::max(std::thread::hardware_concurrency(), 1U);
+    return static_cast<int>(load[0] * 100 / cores);
+}
+
+bool TranscodingScheduler::isSaturated(const std::shared_ptr<TranscodingProfile>& profile, bool checkCpu) const
+{
+    if (maxConcurrent > 0 && runningTotal >= maxConcurrent)
+        return true;
+
+    if (profile->getMaxConcurrent() > 0) {
+        auto it = running.find(profile->getName());
+        if (it != running.end() && it->second >= profile->getMaxConcurrent())
+            return true;
+    }
+
+    // never block the first transcoder on load caused by somebody else
+    return checkCpu && maxCpuLoad > 0 && runningTotal > 0 && getCpuLoad() >= maxCpuLoad;
+}
+
+std::shared_ptr<TranscodingProfile> TranscodingScheduler::findAdmissible(const std::shared_ptr<TranscodingProfile>& profile, const std::shared_ptr<TranscodingProfileList>& profiles) const
+{
+    if (!isSaturated(profile, true))
+        return profile;
+
+    if (!degrade || profiles == nullptr)
+        return nullptr;
+
+    // fallback profiles are cheaper by definition, so only the limits apply to them
+    std::unordered_set<std::string> visited { profile->getName() };
+    auto current = profile;
+    while (!current->getFallback().empty() && visited.find(current->getFallback()) == visited.end()) {
+        visited.insert(current->getFallback());
+        auto fallback = profiles->getByName(current->getFallback());
+        if (fallback == nullptr || fallback->getTargetMimeType() != profile->getTargetMimeType())
+            return nullptr;
+        if (!isSaturated(fallback, false))
+            return fallback;
+        current = fallback;
+    }
+    return nullptr;
+}
+
+bool TranscodingScheduler::isNext(const Waiter* waiter, const std::shared_ptr<TranscodingProfileList>& profiles) const
+{
+    for (const auto& w : queue) {
+        if (findAdmissible(w->profile, profiles) != nullptr)
+            return w == waiter;
+    }
+    return false;
+}
+
+std::unique_ptr<TranscodingSlot> TranscodingScheduler::acquire(const std::shared_ptr<TranscodingProfile>& profile, const std::shared_ptr<TranscodingProfileList>& profiles)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    AutoLockU lock(mutex);
+    loadLimits();
+    auto deadline = start + queueTimeout;
+    Waiter waiter { profile->getPriority(), nextSeq++, profile };
+    auto pos = std::upper_bound(queue.begin(), queue.end(), &waiter, [](const Waiter* a, const Waiter* b) {
+        return a->priority > b->priority || (a->priority == b->priority && a->seq < b->seq);
+    });
+    queue.insert(pos, &waiter);
+    stats.maxQueued = std::max(stats.maxQueued, static_cast<int>(queue.size()));
+
+    std::shared_ptr<TranscodingProfile> admitted;
+    while (true) {
+        // limits may have been raised in the web UI meanwhile
+        loadLimits();
+        if (isNext(&waiter, profiles)) {
+            admitted = findAdmissible(profile, profiles);
+            if (admitted != nullptr)
+                break;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+            break;
+        // wake up regularly, the cpu load changes without notification
+        cond.wait_until(lock, std::min(deadline, now + std::chrono::seconds(1)));
+    }
+    queue.erase(std::find(queue.begin(), queue.end(), &waiter));
+
+    if (admitted == nullptr) {
+        stats.rejected++;
+        cond.notify_all();
+        throw_std_runtime_error("Transcoding profile " + profile->getName() + " not admitted within " + std::to_string(queueTimeout.count()) + " seconds");
+    }
+
+    running[admitted->getName()]++;
+    runningTotal++;
+
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    stats.admitted++;
+    stats.lastWait = wait;
+    stats.maxWait = std::max(stats.maxWait, wait);
+    totalWait += wait;
+    stats.avgWait = totalWait / stats.admitted;
+
+    bool degraded = admitted != profile;
+    if (degraded) {
+        stats.degraded++;
+        log_info("Transcoding saturated, using profile {} instead of {}", admitted->getName(), profile->getName());
+    }
+    log_debug("Admitted transcoding profile {} after {} ms, {} running", admitted->getName(), wait.count(), runningTotal);
+
+    // the next waiter might be admissible as well
+    cond.notify_all();
+    lock.unlock();
+
+    return std::make_unique<TranscodingSlot>(shared_from_this(), admitted, degraded);
+}
+
+void TranscodingScheduler::release(const std::string& profileName)
+{
+    AutoLock lock(mutex);
+    auto it = running.find(profileName);
+    if (it != running.end()) {
+        if (--it->second <= 0)
+            running.erase(it);
+        runningTotal--;
+    }
+    cond.notify_all();
+}
+
+TranscodingStats TranscodingScheduler::getStats()
+{
+    AutoLock lock(mutex);
+    auto result = stats;
+    result.running = runningTotal;
+    result.queued = queue.size();
+    result.runningByProfile = running;
+    return result;
+}
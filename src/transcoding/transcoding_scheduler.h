@@ -0,0 +1,142 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    transcoding_scheduler.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file transcoding_scheduler.h
+/// \brief Definitions of the TranscodingScheduler class.
+
+#ifndef __TRANSCODING_SCHEDULER_H__
+#define __TRANSCODING_SCHEDULER_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Config;
+class TranscodingProfile;
+class TranscodingProfileList;
+class TranscodingScheduler;
+
+/// \brief Snapshot of the scheduler counters for monitoring
+struct TranscodingStats {
+    int running = 0;
+    int queued = 0;
+    int maxQueued = 0;
+    long admitted = 0;
+    long degraded = 0;
+    long rejected = 0;
+    std::chrono::milliseconds lastWait { 0 };
+    std::chrono::milliseconds maxWait { 0 };
+    std::chrono::milliseconds avgWait { 0 };
+    std::map<std::string, int> runningByProfile;
+};
+
+/// \brief Admission ticket for one transcoding process
+///
+/// The slot is released when the object is destroyed, normally together
+/// with the TranscodingProcessExecutor it is attached to.
+class TranscodingSlot {
+public:
+    TranscodingSlot(std::shared_ptr<TranscodingScheduler> scheduler, std::shared_ptr<TranscodingProfile> profile, bool degraded);
+    ~TranscodingSlot();
+
+    TranscodingSlot(const TranscodingSlot&) = delete;
+    TranscodingSlot& operator=(const TranscodingSlot&) = delete;
+
+    /// \brief profile that was admitted, may differ from the requested one if degraded
+    std::shared_ptr<TranscodingProfile> getProfile() const { return profile; }
+    bool isDegraded() const { return degraded; }
+
+protected:
+    std::shared_ptr<TranscodingScheduler> scheduler;
+    std::shared_ptr<TranscodingProfile> profile;
+    bool degraded;
+};
+
+/// \brief Limits the number of concurrently running transcoders
+///
+/// Requests that cannot be admitted wait in a queue ordered by profile
+/// priority and arrival. If degrading is enabled and the requested profile
+/// is saturated, the profile named as fallback is used instead.
+class TranscodingScheduler : public std::enable_shared_from_this<TranscodingScheduler> {
+public:
+    /// \param maxConcurrent global limit of running transcoders, 0 is unlimited
+    /// \param maxCpuLoad load average in percent of all cores above which no further transcoder is started, 0 disables the check
+    /// \param queueTimeout seconds a request may wait for admission
+    /// \param degrade allow switching to the fallback profile when saturated
+    TranscodingScheduler(int maxConcurrent, int maxCpuLoad, int queueTimeout, bool degrade);
+    /// \brief take the limits from the configuration, changes made in the web UI apply to the next request
+    explicit TranscodingScheduler(std::shared_ptr<Config> config);
+    virtual ~TranscodingScheduler() = default;
+
+    /// \brief wait until a transcoder for the profile may be started
+    ///
+    /// \param profile requested profile
+    /// \param profiles list to resolve fallback profiles from
+    /// \return slot holding the admitted profile, throws if the queue timeout expires
+    std::unique_ptr<TranscodingSlot> acquire(const std::shared_ptr<TranscodingProfile>& profile, const std::shared_ptr<TranscodingProfileList>& profiles);
+
+    TranscodingStats getStats();
+
+protected:
+    /// \brief current system load in percent of all available cores
+    virtual int getCpuLoad() const;
+
+    struct Waiter {
+        int priority;
+        long seq;
+        std::shared_ptr<TranscodingProfile> profile;
+    };
+
+    bool isSaturated(const std::shared_ptr<TranscodingProfile>& profile, bool checkCpu) const;
+    std::shared_ptr<TranscodingProfile> findAdmissible(const std::shared_ptr<TranscodingProfile>& profile, const std::shared_ptr<TranscodingProfileList>& profiles) const;
+    bool isNext(const Waiter* waiter, const std::shared_ptr<TranscodingProfileList>& profiles) const;
+    void release(const std::string& profileName);
+    /// \brief re-read the limits from the configuration, if any
+    void loadLimits();
+
+    std::shared_ptr<Config> config;
+    int maxConcurrent;
+    int maxCpuLoad;
+    std::chrono::seconds queueTimeout;
+    bool degrade;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+    using AutoLockU = std::unique_lock<decltype(mutex)>;
+
+    std::vector<Waiter*> queue;
+    std::map<std::string, int> running;
+    int runningTotal;
+    long nextSeq;
+    TranscodingStats stats;
+    std::chrono::milliseconds totalWait;
+
+    friend class TranscodingSlot;
+};
+
+#endif // __TRANSCODING_SCHEDULER_H__
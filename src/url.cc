@@ -34,10 +34,17 @@
 
 #include <pthread.h>
 #include <sstream>
+#include <utility>
 
 #include "config/config_manager.h"
+#include "util/curl_engine.h"
 #include "util/tools.h"
 
+URL::URL(std::shared_ptr<CurlEngine> engine)
+    : engine(std::move(engine))
+{
+}
+
 std::string URL::download(const std::string& URL, long* HTTP_retcode,
     CURL* curl_handle, bool only_header,
     bool verbose, bool redirect)
@@ -91,7 +98,7 @@ std::string URL::download(const std::string& URL, long* HTTP_retcode,
         curl_easy_setopt(curl_handle, CURLOPT_MAXREDIRS, -1);
     }
 
-    res = curl_easy_perform(curl_handle);
+    res = (engine != nullptr) ? engine->perform(curl_handle) : curl_easy_perform(curl_handle);
     if (res != CURLE_OK) {
         log_error("{}", error_buffer);
         if (cleanup)
@@ -41,8 +41,13 @@
 
 #include "common.h"
 
+class CurlEngine;
+
 class URL {
 public:
+    /// \brief transfers are run on the given engine, or directly if it is nullptr
+    explicit URL(std::shared_ptr<CurlEngine> engine = nullptr);
+
     /// \brief This is a simplified version of the File_Info class as used
     /// in libupnp.
     class Stat {
@@ -80,16 +85,18 @@ public:
     /// \param only_header set true if you only want the header and not the
     /// body
     /// \param vebose enable curl verbose option
-    static std::string download(const std::string& URL,
+    std::string download(const std::string& URL,
         long* HTTP_retcode,
         CURL* curl_handle = nullptr,
         bool only_header = false,
         bool verbose = false,
         bool redirect = false);
 
-    static std::unique_ptr<Stat> getInfo(const std::string& URL, CURL* curl_handle = nullptr);
+    std::unique_ptr<Stat> getInfo(const std::string& URL, CURL* curl_handle = nullptr);
 
 protected:
+    std::shared_ptr<CurlEngine> engine;
+
     /// \brief This function is installed as a callback for libcurl, when
     /// we download data from a remote site.
     static size_t dl(void* buf, size_t size, size_t nmemb, void* data);
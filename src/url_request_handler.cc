@@ -115,7 +115,7 @@ void URLRequestHandler::getInfo(const char* filename, UpnpFileInfo* info)
 
         log_debug("Online content url: {}", url.c_str());
         try {
-            auto st = URL::getInfo(url);
+            auto st = URL(content->getCurlEngine()).getInfo(url);
             UpnpFileInfo_set_FileLength(info, st->getSize());
             header = "Accept-Ranges: bytes";
             log_debug("URL used for request: {}", st->getURL().c_str());
@@ -212,7 +212,7 @@ std::unique_ptr<IOHandler> URLRequestHandler::open(const char* filename,
     }
 
     std::string header;
-    auto u = std::make_unique<URL>();
+    auto u = std::make_unique<URL>(content->getCurlEngine());
     try {
         auto st = u->getInfo(url);
         // info->file_length = st->getSize();
@@ -231,8 +231,9 @@ std::unique_ptr<IOHandler> URLRequestHandler::open(const char* filename,
         info->http_header = ixmlCloneDOMString(header.c_str());
     */
 
-    ///\todo make curl io handler configurable for url request handler
-    auto io_handler = std::make_unique<CurlIOHandler>(url, nullptr, 1024 * 1024, 0);
+    auto io_handler = std::make_unique<CurlIOHandler>(content->getCurlEngine(), url,
+        config->getIntOption(CFG_ONLINE_CONTENT_FETCH_BUFFER_SIZE),
+        config->getIntOption(CFG_ONLINE_CONTENT_FETCH_BUFFER_FILL_SIZE));
     io_handler->open(mode);
     content->triggerPlayHook(obj);
     return io_handler;
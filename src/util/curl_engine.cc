@@ -0,0 +1,222 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    curl_engine.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file curl_engine.cc
+
+#ifdef HAVE_CURL
+#include "curl_engine.h" // API
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+
+#include "exceptions.h"
+#include "util/logger.h"
+
+CurlEngine::CurlEngine(long maxConnections)
+    : shutdownFlag(false)
+{
+    multi = curl_multi_init();
+    if (multi == nullptr)
+        throw_std_runtime_error("failed to init curl multi handle");
+    curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, maxConnections);
+
+    if (pipe(wakeupPipe) != 0) {
+        curl_multi_cleanup(multi);
+        throw_std_runtime_error("failed to create curl engine pipe");
+    }
+    fcntl(wakeupPipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(wakeupPipe[1], F_SETFL, O_NONBLOCK);
+
+    thread_ = std::thread { &CurlEngine::threadProc, this };
+}
+
+CurlEngine::~CurlEngine()
+{
+    shutdown();
+    close(wakeupPipe[0]);
+    close(wakeupPipe[1]);
+    curl_multi_cleanup(multi);
+}
+
+void CurlEngine::shutdown()
+{
+    {
+        AutoLock lock(mutex);
+        if (shutdownFlag)
+            return;
+        shutdownFlag = true;
+    }
+    wakeup();
+    if (thread_.joinable())
+        thread_.join();
+
+    // nobody else is driving the multi handle anymore
+    processRequests();
+    for (const auto& [handle, done] : transfers) {
+        curl_multi_remove_handle(multi, handle);
+        if (done)
+            done(CURLE_ABORTED_BY_CALLBACK);
+    }
+    transfers.clear();
+    log_debug("curl engine stopped");
+}
+
+void CurlEngine::start(CURL* handle, DoneCallback done)
+{
+    post(Request { Command::Add, handle, std::move(done), nullptr });
+}
+
+void CurlEngine::cancel(CURL* handle)
+{
+    if (std::this_thread::get_id() == thread_.get_id()) {
+        if (transfers.erase(handle) > 0)
+            curl_multi_remove_handle(multi, handle);
+        return;
+    }
+    auto processed = std::make_shared<std::promise<void>>();
+    auto future = processed->get_future();
+    post(Request { Command::Remove, handle, nullptr, processed });
+    future.wait();
+}
+
+void CurlEngine::resume(CURL* handle)
+{
+    post(Request { Command::Resume, handle, nullptr, nullptr });
+}
+
+CURLcode CurlEngine::perform(CURL* handle)
+{
+    auto result = std::make_shared<std::promise<CURLcode>>();
+    auto future = result->get_future();
+    start(handle, [result](CURLcode res) { result->set_value(res); });
+    return future.get();
+}
+
+void CurlEngine::post(Request request)
+{
+    bool running;
+    {
+        AutoLock lock(mutex);
+        running = !shutdownFlag;
+        if (running)
+            requests.push(std::move(request));
+    }
+    if (running) {
+        wakeup();
+        return;
+    }
+
+    // engine is gone, complete the request right away
+    if (request.command == Command::Add && request.done)
+        request.done(CURLE_ABORTED_BY_CALLBACK);
+    if (request.processed)
+        request.processed->set_value();
+}
+
+void CurlEngine::wakeup()
+{
+    char c = 0;
+    if (write(wakeupPipe[1], &c, 1) < 0 && errno != EAGAIN)
+        log_error("Failed to wake up curl engine: {}", strerror(errno));
+}
+
+void CurlEngine::processRequests()
+{
+    std::queue<Request> pending;
+    {
+        AutoLock lock(mutex);
+        std::swap(pending, requests);
+    }
+
+    while (!pending.empty()) {
+        auto& request = pending.front();
+        switch (request.command) {
+        case Command::Add:
+            if (curl_multi_add_handle(multi, request.handle) == CURLM_OK) {
+                transfers[request.handle] = std::move(request.done);
+            } else if (request.done) {
+                request.done(CURLE_FAILED_INIT);
+            }
+            break;
+        case Command::Remove:
+            if (transfers.erase(request.handle) > 0)
+                curl_multi_remove_handle(multi, request.handle);
+            break;
+        case Command::Resume:
+            if (transfers.find(request.handle) != transfers.end())
+                curl_easy_pause(request.handle, CURLPAUSE_CONT);
+            break;
+        }
+        if (request.processed)
+            request.processed->set_value();
+        pending.pop();
+    }
+}
+
+void CurlEngine::threadProc()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!shutdownFlag) {
+        lock.unlock();
+
+        processRequests();
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        CURLMsg* msg;
+        int left = 0;
+        while ((msg = curl_multi_info_read(multi, &left)) != nullptr) {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+            CURL* handle = msg->easy_handle;
+            CURLcode res = msg->data.result;
+            curl_multi_remove_handle(multi, handle);
+
+            auto it = transfers.find(handle);
+            if (it != transfers.end()) {
+                auto done = std::move(it->second);
+                transfers.erase(it);
+                if (done)
+                    done(res);
+            }
+        }
+
+        struct curl_waitfd wfd {
+            wakeupPipe[0], CURL_WAIT_POLLIN, 0
+        };
+        curl_multi_wait(multi, &wfd, 1, 1000, nullptr);
+        if (wfd.revents != 0) {
+            char buf[64];
+            while (read(wakeupPipe[0], buf, sizeof(buf)) > 0) {
+            }
+        }
+
+        lock.lock();
+    }
+}
+
+#endif // HAVE_CURL
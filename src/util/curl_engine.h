@@ -0,0 +1,102 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    curl_engine.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file curl_engine.h
+/// \brief Definition of the CurlEngine class.
+
+#ifdef HAVE_CURL
+
+#ifndef __CURL_ENGINE_H__
+#define __CURL_ENGINE_H__
+
+#include <curl/curl.h>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+/// \brief Runs all curl transfers of the server on one curl_multi handle
+///
+/// Transfers share the connection cache of the multi handle and are driven
+/// by a single thread. The callbacks of the easy handles are called on that
+/// thread, so they must not block; a write callback that has no room left
+/// returns CURL_WRITEFUNC_PAUSE and the reader calls resume() later.
+class CurlEngine {
+public:
+    using DoneCallback = std::function<void(CURLcode)>;
+
+    explicit CurlEngine(long maxConnections);
+    ~CurlEngine();
+
+    /// \brief add a configured easy handle to the engine
+    /// \param done called on the engine thread when the transfer is finished
+    void start(CURL* handle, DoneCallback done);
+
+    /// \brief remove a transfer, returns when the engine does not touch the handle anymore
+    void cancel(CURL* handle);
+
+    /// \brief continue a transfer that was paused by its write callback
+    void resume(CURL* handle);
+
+    /// \brief run a transfer and wait for its completion, replaces curl_easy_perform
+    CURLcode perform(CURL* handle);
+
+    void shutdown();
+
+protected:
+    enum class Command {
+        Add,
+        Remove,
+        Resume
+    };
+
+    struct Request {
+        Command command;
+        CURL* handle;
+        DoneCallback done;
+        std::shared_ptr<std::promise<void>> processed;
+    };
+
+    void threadProc();
+    void processRequests();
+    void post(Request request);
+    void wakeup();
+
+    CURLM* multi;
+    std::map<CURL*, DoneCallback> transfers;
+
+    std::mutex mutex;
+    using AutoLock = std::lock_guard<std::mutex>;
+    std::queue<Request> requests;
+    bool shutdownFlag;
+
+    int wakeupPipe[2];
+    std::thread thread_;
+};
+
+#endif // __CURL_ENGINE_H__
+
+#endif // HAVE_CURL
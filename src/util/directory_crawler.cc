@@ -0,0 +1,265 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    directory_crawler.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file directory_crawler.cc
+
+#include "directory_crawler.h" // API
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "util/logger.h"
+
+#define DIRECTORY_CRAWLER_MAX_FINISHED 64
+// a consumer that waits for a listing checks for cancellation this often
+#define DIRECTORY_CRAWLER_CHECK_INTERVAL std::chrono::milliseconds(500)
+
+DirectoryCrawler::Crawl::Crawl(DirectoryCrawler* crawler, bool followSymlinks, bool hidden, bool directoriesOnly)
+    : crawler(crawler)
+    , followSymlinks(followSymlinks)
+    , hidden(hidden)
+    , directoriesOnly(directoriesOnly)
+    , busy(0)
+    , stopped(false)
+{
+}
+
+bool DirectoryCrawler::Crawl::canRead() const
+{
+    return !stopped && !pending.empty() && finished.size() < DIRECTORY_CRAWLER_MAX_FINISHED;
+}
+
+std::unique_ptr<DirectoryCrawler::Listing> DirectoryCrawler::Crawl::next(const std::function<bool()>& cancelled)
+{
+    AutoLockU lock(crawler->mutex);
+    auto ready = [this] { return stopped || !finished.empty() || isDone(); };
+    while (!crawler->cond.wait_for(lock, DIRECTORY_CRAWLER_CHECK_INTERVAL, ready)) {
+        if (cancelled != nullptr && cancelled()) {
+            lock.unlock();
+            stop();
+            return nullptr;
+        }
+    }
+    if (stopped || finished.empty()) {
+        crawler->remove(this);
+        return nullptr;
+    }
+
+    auto listing = std::move(finished.front());
+    finished.pop_front();
+    crawler->cond.notify_all();
+    return listing;
+}
+
+void DirectoryCrawler::Crawl::stop()
+{
+    {
+        AutoLock lock(crawler->mutex);
+        stopped = true;
+        pending.clear();
+        finished.clear();
+        crawler->remove(this);
+    }
+    crawler->cond.notify_all();
+}
+
+DirectoryCrawler::DirectoryCrawler(std::size_t threadCount)
+    : threadCount(threadCount > 0 ? threadCount : 1)
+    , shutdownFlag(false)
+{
+}
+
+DirectoryCrawler::~DirectoryCrawler()
+{
+    shutdown();
+}
+
+std::shared_ptr<DirectoryCrawler::Crawl> DirectoryCrawler::start(const fs::path& root, bool followSymlinks, bool hidden, bool directoriesOnly)
+{
+    auto crawl = std::make_shared<Crawl>(this, followSymlinks, hidden, directoriesOnly);
+    {
+        AutoLock lock(mutex);
+        if (shutdownFlag) {
+            crawl->stopped = true;
+            return crawl;
+        }
+        crawl->pending.push_back(root);
+        remove(nullptr);
+        crawls.push_back(crawl);
+
+        // the workers are kept for all following crawls
+        if (workers.empty()) {
+            for (std::size_t i = 0; i < threadCount; i++)
+                workers.emplace_back(&DirectoryCrawler::threadProc, this);
+        }
+    }
+    cond.notify_all();
+    return crawl;
+}
+
+void DirectoryCrawler::shutdown()
+{
+    {
+        AutoLock lock(mutex);
+        shutdownFlag = true;
+        for (auto& weak : crawls) {
+            if (auto crawl = weak.lock()) {
+                crawl->stopped = true;
+                crawl->pending.clear();
+                crawl->finished.clear();
+            }
+        }
+        crawls.clear();
+    }
+    cond.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers.clear();
+}
+
+void DirectoryCrawler::remove(const Crawl* crawl)
+{
+    crawls.erase(std::remove_if(crawls.begin(), crawls.end(), [=](const auto& c) {
+        auto locked = c.lock();
+        return locked == nullptr || locked.get() == crawl;
+    }),
+        crawls.end());
+}
+
+void DirectoryCrawler::threadProc()
+{
+    AutoLockU lock(mutex);
+    while (true) {
+        std::shared_ptr<Crawl> crawl;
+        cond.wait(lock, [this, &crawl] {
+            if (shutdownFlag)
+                return true;
+            for (const auto& weak : crawls) {
+                // a crawl whose owner is gone is not read any further
+                crawl = weak.lock();
+                if (crawl != nullptr && crawl->canRead())
+                    return true;
+            }
+            crawl = nullptr;
+            return false;
+        });
+        if (shutdownFlag)
+            break;
+
+        auto location = std::move(crawl->pending.back());
+        crawl->pending.pop_back();
+        crawl->busy++;
+        lock.unlock();
+
+        auto listing = readDirectory(*crawl, location);
+
+        lock.lock();
+        crawl->busy--;
+        if (listing != nullptr && !crawl->stopped) {
+            for (const auto& entry : listing->entries) {
+                if (entry.isDirectory)
+                    crawl->pending.push_back(entry.path);
+            }
+            crawl->finished.push_back(std::move(listing));
+        }
+        cond.notify_all();
+    }
+}
+
+std::unique_ptr<DirectoryCrawler::Listing> DirectoryCrawler::readDirectory(const Crawl& crawl, const fs::path& location)
+{
+    DIR* dir = opendir(location.c_str());
+    if (!dir) {
+        log_warning("Could not list directory {}: {}", location.c_str(), std::strerror(errno));
+        return nullptr;
+    }
+
+    auto listing = std::make_unique<Listing>();
+    listing->location = location;
+
+    struct dirent* dent;
+    while ((dent = readdir(dir)) != nullptr) {
+        const char* name = dent->d_name;
+        if (name[0] == '.') {
+            if (name[1] == 0 || (name[1] == '.' && name[2] == 0))
+                continue;
+            if (!crawl.hidden)
+                continue;
+        }
+        auto path = location / name;
+
+        bool isDirectory = false;
+        bool needsStat = true;
+#ifdef DT_UNKNOWN
+        switch (dent->d_type) {
+        case DT_DIR:
+            isDirectory = true;
+            needsStat = false;
+            break;
+        case DT_LNK:
+            if (!crawl.followSymlinks) {
+                log_debug("link {} skipped", path.c_str());
+                continue;
+            }
+            break;
+        case DT_UNKNOWN:
+            break;
+        default:
+            if (crawl.directoriesOnly)
+                continue;
+            needsStat = false;
+            break;
+        }
+#endif
+        if (needsStat) {
+            struct stat statbuf;
+            if (lstat(path.c_str(), &statbuf) != 0) {
+                log_warning("Failed to stat {}: {}", path.c_str(), std::strerror(errno));
+                continue;
+            }
+            if (S_ISLNK(statbuf.st_mode)) {
+                if (!crawl.followSymlinks) {
+                    log_debug("link {} skipped", path.c_str());
+                    continue;
+                }
+                if (stat(path.c_str(), &statbuf) != 0) {
+                    log_warning("Failed to stat {}: {}", path.c_str(), std::strerror(errno));
+                    continue;
+                }
+            }
+            isDirectory = S_ISDIR(statbuf.st_mode);
+        }
+        if (crawl.directoriesOnly && !isDirectory)
+            continue;
+        listing->entries.push_back(Entry { std::move(path), isDirectory });
+    }
+    closedir(dir);
+    return listing;
+}
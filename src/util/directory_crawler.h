@@ -0,0 +1,137 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    directory_crawler.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+
+/// \file directory_crawler.h
+/// \brief Definition of the DirectoryCrawler class.
+
+#ifndef __DIRECTORY_CRAWLER_H__
+#define __DIRECTORY_CRAWLER_H__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace fs = std::filesystem;
+
+/// \brief Reads directory trees on a fixed number of worker threads
+///
+/// The workers are started with the first crawl and serve all crawls
+/// until shutdown. Independent subdirectories are read concurrently, the
+/// caller consumes the finished directories of its crawl one by one. The
+/// type reported by readdir is used where available, so only entries of
+/// unknown type and followed symlinks need a stat call. The number of
+/// finished directories that are not consumed yet is limited per crawl to
+/// keep memory bounded.
+class DirectoryCrawler {
+public:
+    struct Entry {
+        fs::path path;
+        bool isDirectory;
+    };
+
+    struct Listing {
+        fs::path location;
+        /// \brief directories and everything else that is not a dropped symlink
+        std::vector<Entry> entries;
+    };
+
+    /// \brief One directory tree that is read by the workers
+    ///
+    /// Dropping the last reference ends the crawl.
+    class Crawl {
+    public:
+        Crawl(DirectoryCrawler* crawler, bool followSymlinks, bool hidden, bool directoriesOnly);
+
+        Crawl(const Crawl&) = delete;
+        Crawl& operator=(const Crawl&) = delete;
+
+        /// \brief wait for the next read directory
+        /// \param cancelled checked regularly while waiting, the crawl is stopped if it returns true
+        /// \return nullptr if all directories were returned or the crawl was stopped
+        std::unique_ptr<Listing> next(const std::function<bool()>& cancelled = nullptr);
+
+        /// \brief stop reading, pending directories are dropped
+        void stop();
+
+    protected:
+        friend class DirectoryCrawler;
+
+        DirectoryCrawler* crawler;
+        bool followSymlinks;
+        bool hidden;
+        bool directoriesOnly;
+
+        /// \brief directories to read, the last one is read first to stay close to the previous one
+        std::vector<fs::path> pending;
+        std::deque<std::unique_ptr<Listing>> finished;
+        /// \brief number of directories being read right now
+        std::size_t busy;
+        bool stopped;
+
+        bool canRead() const;
+        bool isDone() const { return pending.empty() && busy == 0; }
+    };
+
+    /// \param threadCount number of worker threads
+    explicit DirectoryCrawler(std::size_t threadCount);
+    ~DirectoryCrawler();
+
+    DirectoryCrawler(const DirectoryCrawler&) = delete;
+    DirectoryCrawler& operator=(const DirectoryCrawler&) = delete;
+
+    /// \brief start reading the tree below root
+    /// \param followSymlinks descend into and report symlinks
+    /// \param hidden report entries starting with a dot
+    /// \param directoriesOnly report subdirectories only
+    std::shared_ptr<Crawl> start(const fs::path& root, bool followSymlinks, bool hidden, bool directoriesOnly = false);
+
+    /// \brief stop all crawls and the workers
+    void shutdown();
+
+protected:
+    void threadProc();
+    static std::unique_ptr<Listing> readDirectory(const Crawl& crawl, const fs::path& location);
+    /// \brief drop a crawl that is stopped or done, requires the lock
+    void remove(const Crawl* crawl);
+
+    std::size_t threadCount;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    using AutoLock = std::lock_guard<decltype(mutex)>;
+    using AutoLockU = std::unique_lock<decltype(mutex)>;
+
+    /// \brief crawls that still have directories to read or to return, owned by their caller
+    std::vector<std::weak_ptr<Crawl>> crawls;
+    bool shutdownFlag;
+
+    std::vector<std::thread> workers;
+};
+
+#endif // __DIRECTORY_CRAWLER_H__
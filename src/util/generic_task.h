@@ -10,9 +10,12 @@ enum task_type_t {
     Invalid,
     AddFile,
     RemoveObject,
+    MoveFile,
+    FileChanges,
     LoadAccounting,
     RescanDirectory,
-    FetchOnlineContent
+    FetchOnlineContent,
+    VirtualLayout
 };
 
 enum task_owner_t {
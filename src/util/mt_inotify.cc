@@ -117,7 +117,7 @@ void Inotify::removeWatch(int wd) const
     }
 }
 
-struct inotify_event* Inotify::nextEvent()
+struct inotify_event* Inotify::nextEvent(int timeout)
 {
     static std::array<struct inotify_event, MAX_EVENTS> event;
     static struct inotify_event* ret;
@@ -149,7 +149,7 @@ struct inotify_event* Inotify::nextEvent()
             // how much of the event do we have?
             bytes = reinterpret_cast<char*>(&event[0]) + bytes - reinterpret_cast<char*>(ret);
             memcpy(&event[0], ret, bytes);
-            return nextEvent();
+            return nextEvent(timeout);
         }
         return ret;
     }
@@ -174,8 +174,11 @@ struct inotify_event* Inotify::nextEvent()
     if (stop_fd_read > fd_max)
         fd_max = stop_fd_read;
 
+    struct timeval tv;
+    tv.tv_sec = timeout / 1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
     rc = select(fd_max + 1, &read_fds,
-        nullptr, nullptr, nullptr);
+        nullptr, nullptr, timeout < 0 ? nullptr : &tv);
     if (rc < 0) {
         return nullptr;
     }
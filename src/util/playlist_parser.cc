@@ -0,0 +1,191 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    playlist_parser.cc - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file playlist_parser.cc
+
+#include "playlist_parser.h" // API
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <string_view>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "exceptions.h"
+
+namespace {
+std::string_view trim(std::string_view line)
+{
+    auto start = line.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos)
+        return {};
+    auto end = line.find_last_not_of(" \t\r\n");
+    return line.substr(start, end - start + 1);
+}
+
+bool startsWithNoCase(std::string_view line, std::string_view prefix)
+{
+    return line.size() >= prefix.size() && strncasecmp(line.data(), prefix.data(), prefix.size()) == 0;
+}
+
+/// \brief call handler for every non empty line
+template <typename Handler>
+void forEachLine(const char* data, std::size_t size, Handler handler)
+{
+    std::string_view text(data, size);
+    // byte order mark of m3u8 files
+    if (text.substr(0, 3) == "\xEF\xBB\xBF")
+        text.remove_prefix(3);
+
+    while (!text.empty()) {
+        auto eol = text.find('\n');
+        auto line = trim(text.substr(0, eol));
+        if (!line.empty())
+            handler(line);
+        if (eol == std::string_view::npos)
+            break;
+        text.remove_prefix(eol + 1);
+    }
+}
+
+std::string getLocation(std::string_view location, const fs::path& base)
+{
+    std::string result(location);
+    if (PlaylistParser::isURL(result) || result.front() == '/' || base.empty())
+        return result;
+    return (base / result).lexically_normal().string();
+}
+
+std::vector<PlaylistParser::Entry> parseM3U(const char* data, std::size_t size, const fs::path& base)
+{
+    std::vector<PlaylistParser::Entry> entries;
+    std::string title;
+    forEachLine(data, size, [&](std::string_view line) {
+        if (startsWithNoCase(line, "#EXTINF:")) {
+            // #EXTINF:<duration>,<title>
+            auto comma = line.find(',');
+            title = (comma == std::string_view::npos) ? "" : std::string(trim(line.substr(comma + 1)));
+        } else if (line.front() != '#') {
+            entries.push_back(PlaylistParser::Entry { getLocation(line, base), title, static_cast<int>(entries.size()) + 1 });
+            title.clear();
+        }
+    });
+    return entries;
+}
+
+std::vector<PlaylistParser::Entry> parsePLS(const char* data, std::size_t size, const fs::path& base)
+{
+    // FileN and TitleN may come in any order
+    std::map<int, std::pair<std::string, std::string>> numbered;
+    forEachLine(data, size, [&](std::string_view line) {
+        bool isFile = startsWithNoCase(line, "File");
+        if (!isFile && !startsWithNoCase(line, "Title"))
+            return;
+        auto eq = line.find('=');
+        if (eq == std::string_view::npos)
+            return;
+        auto number = trim(line.substr(isFile ? 4 : 5, eq - (isFile ? 4 : 5)));
+        auto value = trim(line.substr(eq + 1));
+        if (number.empty() || number.size() > 9 || value.empty() || number.find_first_not_of("0123456789") != std::string_view::npos)
+            return;
+        auto& entry = numbered[std::stoi(std::string(number))];
+        (isFile ? entry.first : entry.second) = std::string(value);
+    });
+
+    std::vector<PlaylistParser::Entry> entries;
+    entries.reserve(numbered.size());
+    for (const auto& [number, entry] : numbered) {
+        if (!entry.first.empty())
+            entries.push_back(PlaylistParser::Entry { getLocation(entry.first, base), entry.second, number > 0 ? number : static_cast<int>(entries.size()) + 1 });
+    }
+    return entries;
+}
+} // namespace
+
+PlaylistParser::Type PlaylistParser::getType(const std::string& mimetype)
+{
+    if (mimetype == "audio/x-mpegurl")
+        return Type::M3U;
+    if (mimetype == "audio/x-scpls")
+        return Type::PLS;
+    return Type::None;
+}
+
+bool PlaylistParser::isURL(const std::string& location)
+{
+    return location.find("://") != std::string::npos;
+}
+
+std::vector<PlaylistParser::Entry> PlaylistParser::parse(Type type, const char* data, std::size_t size, const fs::path& base)
+{
+    switch (type) {
+    case Type::M3U:
+        return parseM3U(data, size, base);
+    case Type::PLS:
+        return parsePLS(data, size, base);
+    case Type::None:
+        break;
+    }
+    return {};
+}
+
+std::vector<PlaylistParser::Entry> PlaylistParser::parseFile(Type type, const fs::path& path)
+{
+#ifdef O_CLOEXEC
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+#endif
+    if (fd < 0)
+        throw_std_runtime_error("failed to open file: " + path.string() + ": " + std::strerror(errno));
+
+    struct stat statbuf;
+    if (fstat(fd, &statbuf) != 0 || !S_ISREG(statbuf.st_mode)) {
+        ::close(fd);
+        throw_std_runtime_error("Not a file: " + path.string());
+    }
+    if (statbuf.st_size == 0) {
+        ::close(fd);
+        return {};
+    }
+
+    auto size = static_cast<std::size_t>(statbuf.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        throw_std_runtime_error("failed to map file: " + path.string() + ": " + std::strerror(errno));
+
+    std::vector<Entry> entries;
+    try {
+        entries = parse(type, static_cast<const char*>(data), size, path.parent_path());
+    } catch (...) {
+        ::munmap(data, size);
+        throw;
+    }
+    ::munmap(data, size);
+    return entries;
+}
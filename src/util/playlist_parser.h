@@ -0,0 +1,70 @@
+/*GRB*
+
+    Gerbera - https://gerbera.io/
+
+    playlist_parser.h - this file is part of Gerbera.
+
+    Copyright (C) 2020 Gerbera Contributors
+
+    Gerbera is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 2
+    as published by the Free Software Foundation.
+
+    Gerbera is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Gerbera.  If not, see <http://www.gnu.org/licenses/>.
+
+    $Id$
+*/
+
+/// \file playlist_parser.h
+/// \brief Definition of the PlaylistParser class.
+
+#ifndef __PLAYLIST_PARSER_H__
+#define __PLAYLIST_PARSER_H__
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+namespace fs = std::filesystem;
+
+/// \brief Reads the entries of M3U and PLS playlists
+///
+/// The file is mapped into memory and split into lines in place, only the
+/// locations and titles of the entries are copied.
+class PlaylistParser {
+public:
+    enum class Type {
+        None,
+        M3U,
+        PLS,
+    };
+
+    struct Entry {
+        /// \brief URL or absolute path of the entry
+        std::string location;
+        std::string title;
+        /// \brief position in the playlist, starting at 1
+        int order;
+    };
+
+    /// \brief playlist type of the mimetype
+    static Type getType(const std::string& mimetype);
+
+    /// \brief parse a playlist that is held in memory
+    /// \param base directory that relative locations are resolved against
+    static std::vector<Entry> parse(Type type, const char* data, std::size_t size, const fs::path& base);
+
+    /// \brief map a playlist file and parse it
+    static std::vector<Entry> parseFile(Type type, const fs::path& path);
+
+    /// \brief the location is an URL and not a file
+    static bool isURL(const std::string& location);
+};
+
+#endif // __PLAYLIST_PARSER_H__
@@ -202,19 +202,19 @@ std::unique_ptr<StringConverter> StringConverter::m2i(const std::shared_ptr<Conf
     return conv;
 }
 
-#ifdef HAVE_JS
-std::unique_ptr<StringConverter> StringConverter::j2i(const std::shared_ptr<Config>& cm)
+std::unique_ptr<StringConverter> StringConverter::p2i(const std::shared_ptr<Config>& cm)
 {
     auto conv = std::make_unique<StringConverter>(
-        cm->getOption(CFG_IMPORT_SCRIPTING_CHARSET),
+        cm->getOption(CFG_IMPORT_PLAYLIST_CHARSET),
         DEFAULT_INTERNAL_CHARSET);
     return conv;
 }
 
-std::unique_ptr<StringConverter> StringConverter::p2i(const std::shared_ptr<Config>& cm)
+#ifdef HAVE_JS
+std::unique_ptr<StringConverter> StringConverter::j2i(const std::shared_ptr<Config>& cm)
 {
     auto conv = std::make_unique<StringConverter>(
-        cm->getOption(CFG_IMPORT_PLAYLIST_CHARSET),
+        cm->getOption(CFG_IMPORT_SCRIPTING_CHARSET),
         DEFAULT_INTERNAL_CHARSET);
     return conv;
 }
@@ -62,12 +62,11 @@ public:
 
     /// \brief metadata to internal
     static std::unique_ptr<StringConverter> m2i(const std::shared_ptr<Config>& cm);
+    /// \brief playlist to internal
+    static std::unique_ptr<StringConverter> p2i(const std::shared_ptr<Config>& cm);
 #ifdef HAVE_JS
     /// \brief scripting to internal
     static std::unique_ptr<StringConverter> j2i(const std::shared_ptr<Config>& cm);
-
-    /// \brief playlist to internal
-    static std::unique_ptr<StringConverter> p2i(const std::shared_ptr<Config>& cm);
 #endif
 #if defined(HAVE_JS) || defined(HAVE_TAGLIB) || defined(ATRAILERS) || defined(HAVE_MATROSKA)
     /// \brief safeguard - internal to internal - needed to catch some
@@ -36,9 +36,12 @@
 #include <cerrno>
 #include <climits>
 #include <cstdlib>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <queue>
@@ -46,6 +49,7 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <tuple>
 #include <unistd.h>
 #include <utility>
 
@@ -625,27 +629,105 @@ std::string getMIMETypeFromBuffer(const void* buffer, size_t length)
     return getMIME("", buffer, length, false);
 }
 
-std::string getMIME(const fs::path& filepath, const void* buffer, size_t length, bool allowSymlinks)
+namespace {
+// set before the first lookup, the handles load it when they are created
+std::string magicFile;
+
+/// \brief magic handle of the current thread, loading the database is expensive
+class MagicHandle {
+public:
+    MagicHandle()
+    {
+        cookie = magic_open(MAGIC_MIME_TYPE);
+        if (cookie == nullptr) {
+            log_warning("Failed to initialize libmagic");
+            return;
+        }
+        if (magic_load(cookie, magicFile.empty() ? nullptr : magicFile.c_str()) != 0) {
+            log_warning("Failed to load magic database: {}", magic_error(cookie));
+            magic_close(cookie);
+            cookie = nullptr;
+        }
+    }
+    ~MagicHandle()
+    {
+        if (cookie != nullptr)
+            magic_close(cookie);
+    }
+    MagicHandle(const MagicHandle&) = delete;
+    MagicHandle& operator=(const MagicHandle&) = delete;
+
+    magic_t cookie;
+};
+
+/// \brief results of file lookups, a changed file gets a new mtime or inode
+class MimeCache {
+public:
+    using Key = std::tuple<dev_t, ino_t, time_t, bool>;
+
+    std::optional<std::string> get(const Key& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it == entries.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    void put(const Key& key, const std::string& mimetype)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entries.size() >= MIME_CACHE_SIZE) {
+            entries.erase(order.front());
+            order.pop_front();
+        }
+        if (entries.emplace(key, mimetype).second)
+            order.push_back(key);
+    }
+
+private:
+    static constexpr size_t MIME_CACHE_SIZE = 8192;
+    std::mutex mutex;
+    std::map<Key, std::string> entries;
+    std::deque<Key> order;
+};
+MimeCache mimeCache;
+} // namespace
+
+void setMagicFile(const std::string& file)
 {
-    int magicFlags = allowSymlinks ? MAGIC_MIME_TYPE | MAGIC_SYMLINK : MAGIC_MIME_TYPE;
+    magicFile = file;
+}
 
-    /* MAGIC_MIME_TYPE tells magic to return ONLY the mimetype */
-    magic_t magic_cookie = magic_open(magicFlags);
+std::string getMIME(const fs::path& filepath, const void* buffer, size_t length, bool allowSymlinks)
+{
+    std::optional<MimeCache::Key> key;
+    if (!filepath.empty()) {
+        struct stat statbuf;
+        int ret = allowSymlinks ? stat(filepath.c_str(), &statbuf) : lstat(filepath.c_str(), &statbuf);
+        if (ret == 0) {
+            key = MimeCache::Key { statbuf.st_dev, statbuf.st_ino, statbuf.st_mtime, allowSymlinks };
+            auto cached = mimeCache.get(*key);
+            if (cached)
+                return *cached;
+        }
+    }
 
-    if (magic_cookie == nullptr) {
-        log_warning("Failed to initialize libmagic");
+    thread_local MagicHandle handle;
+    if (handle.cookie == nullptr)
         return "";
-    }
 
-    if (magic_load(magic_cookie, nullptr) != 0) {
-        log_warning("Failed to load magic database: {}", magic_error(magic_cookie));
-        magic_close(magic_cookie);
+    /* MAGIC_MIME_TYPE tells magic to return ONLY the mimetype */
+    magic_setflags(handle.cookie, allowSymlinks ? MAGIC_MIME_TYPE | MAGIC_SYMLINK : MAGIC_MIME_TYPE);
+
+    const char* mime = filepath.empty() ? magic_buffer(handle.cookie, buffer, length) : magic_file(handle.cookie, filepath.c_str());
+    if (mime == nullptr) {
+        log_debug("libmagic failed for {}: {}", filepath.c_str(), magic_error(handle.cookie));
         return "";
     }
-
-    const char* mime = filepath.empty() ? magic_buffer(magic_cookie, buffer, length) : magic_file(magic_cookie, filepath.c_str());
     std::string out = mime;
-    magic_close(magic_cookie);
+    if (key)
+        mimeCache.put(*key, out);
     return out;
 }
 #endif
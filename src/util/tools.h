@@ -203,7 +203,14 @@ std::string getMIMETypeFromFile(const fs::path& file, bool allowSymlinks);
 /// \brief Extracts mimetype from a buffer using filemagic
 std::string getMIMETypeFromBuffer(const void* buffer, size_t length);
 /// \brief Extracts mimetype from a filepath OR buffer using filemagic
+///
+/// Every thread keeps its own loaded magic database, results for files
+/// are cached by device, inode and modification time.
 std::string getMIME(const fs::path& filepath, const void* buffer, size_t length, bool allowSymlinks);
+/// \brief Magic database for getMIME, empty for the system default
+///
+/// Has to be set before the first lookup.
+void setMagicFile(const std::string& file);
 
 #endif // HAVE_MAGIC
 
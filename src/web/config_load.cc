@@ -260,6 +260,18 @@ void web::configLoad::process()
         createItem(item, cs->getItemPath(pr, ATTR_TRANSCODING_PROFILES, ATTR_TRANSCODING_PROFILES_PROFLE, ATTR_TRANSCODING_PROFILES_PROFLE_USECHUNKEDENC), cs->option, ATTR_TRANSCODING_PROFILES_PROFLE_USECHUNKEDENC);
         setValue(item, entry->getChunked());
 
+        item = values.append_child("item");
+        createItem(item, cs->getItemPath(pr, ATTR_TRANSCODING_PROFILES, ATTR_TRANSCODING_PROFILES_PROFLE, ATTR_TRANSCODING_PROFILES_PROFLE_MAX_CONCURRENT), cs->option, ATTR_TRANSCODING_PROFILES_PROFLE_MAX_CONCURRENT);
+        setValue(item, entry->getMaxConcurrent());
+
+        item = values.append_child("item");
+        createItem(item, cs->getItemPath(pr, ATTR_TRANSCODING_PROFILES, ATTR_TRANSCODING_PROFILES_PROFLE, ATTR_TRANSCODING_PROFILES_PROFLE_PRIORITY), cs->option, ATTR_TRANSCODING_PROFILES_PROFLE_PRIORITY);
+        setValue(item, entry->getPriority());
+
+        item = values.append_child("item");
+        createItem(item, cs->getItemPath(pr, ATTR_TRANSCODING_PROFILES, ATTR_TRANSCODING_PROFILES_PROFLE, ATTR_TRANSCODING_PROFILES_PROFLE_FALLBACK), cs->option, ATTR_TRANSCODING_PROFILES_PROFLE_FALLBACK);
+        setValue(item, entry->getFallback());
+
         item = values.append_child("item");
         createItem(item, cs->getItemPath(pr, ATTR_TRANSCODING_PROFILES, ATTR_TRANSCODING_PROFILES_PROFLE, ATTR_TRANSCODING_PROFILES_PROFLE_AGENT, ATTR_TRANSCODING_PROFILES_PROFLE_AGENT_COMMAND), cs->option, ATTR_TRANSCODING_PROFILES_PROFLE_AGENT_COMMAND);
         setValue(item, entry->getCommand());
@@ -329,7 +341,7 @@ void web::configLoad::process()
         }
     }
 
-    std::vector<config_option_t> dict_options = { CFG_SERVER_UI_ACCOUNT_LIST, CFG_IMPORT_MAPPINGS_EXTENSION_TO_MIMETYPE_LIST, CFG_IMPORT_MAPPINGS_MIMETYPE_TO_CONTENTTYPE_LIST, CFG_IMPORT_MAPPINGS_MIMETYPE_TO_UPNP_CLASS_LIST, CFG_IMPORT_LAYOUT_MAPPING };
+    std::vector<config_option_t> dict_options = { CFG_SERVER_UI_ACCOUNT_LIST, CFG_IMPORT_MAPPINGS_EXTENSION_TO_MIMETYPE_LIST, CFG_IMPORT_MAPPINGS_MIMETYPE_TO_CONTENTTYPE_LIST, CFG_IMPORT_MAPPINGS_MIMETYPE_TO_UPNP_CLASS_LIST, CFG_IMPORT_LAYOUT_MAPPING, CFG_IMPORT_SCRIPTING_VIRTUAL_LAYOUT_AUDIO };
 
     for (const auto& dict_option : dict_options) {
         int i = 0;
@@ -34,6 +34,7 @@
 #include <utility>
 
 #include "content_manager.h"
+#include "transcoding/transcoding_scheduler.h"
 
 web::tasks::tasks(std::shared_ptr<Config> config, std::shared_ptr<Database> database,
     std::shared_ptr<ContentManager> content, std::shared_ptr<SessionManager> sessionManager)
@@ -57,6 +58,18 @@ void web::tasks::process()
         for (const auto& task : taskList) {
             appendTask(task, &tasksEl);
         }
+
+        auto stats = content->getTranscodingScheduler()->getStats();
+        auto transcodingEl = root.append_child("transcoding");
+        transcodingEl.append_attribute("running") = stats.running;
+        transcodingEl.append_attribute("queued") = stats.queued;
+        transcodingEl.append_attribute("max-queued") = stats.maxQueued;
+        transcodingEl.append_attribute("admitted") = stats.admitted;
+        transcodingEl.append_attribute("degraded") = stats.degraded;
+        transcodingEl.append_attribute("rejected") = stats.rejected;
+        transcodingEl.append_attribute("last-wait") = static_cast<long>(stats.lastWait.count());
+        transcodingEl.append_attribute("max-wait") = static_cast<long>(stats.maxWait.count());
+        transcodingEl.append_attribute("avg-wait") = static_cast<long>(stats.avgWait.count());
     } else if (action == "cancel") {
         int taskID = intParam("task_id");
         content->invalidateTask(taskID);
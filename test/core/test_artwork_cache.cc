@@ -0,0 +1,125 @@
+#include <metadata/artwork_cache.h>
+
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "../mock/temp_directory.h"
+#include "iohandler/io_handler.h"
+
+class ArtworkCacheTest : public TempDirectoryTest {
+public:
+    ArtworkCacheTest()
+        : TempDirectoryTest("artcache")
+    {
+    }
+
+    void SetUp() override
+    {
+        TempDirectoryTest::SetUp();
+        fs::create_directories(root / "music");
+        cacheDir = root / "cache";
+    }
+
+    fs::path writeTrack(const std::string& name)
+    {
+        auto path = root / "music" / name;
+        std::ofstream(path) << name;
+        return path;
+    }
+
+    size_t countImages()
+    {
+        size_t count = 0;
+        for (const auto& entry : fs::recursive_directory_iterator(cacheDir)) {
+            if (entry.is_regular_file())
+                count++;
+        }
+        return count;
+    }
+
+    fs::path cacheDir;
+    std::vector<std::byte> cover = std::vector<std::byte>(64, std::byte { 0x17 });
+};
+
+TEST_F(ArtworkCacheTest, ServesStoredArtwork)
+{
+    auto track = writeTrack("a.mp3");
+    ArtworkCache subject(cacheDir, 10);
+
+    EXPECT_EQ(subject.open(track), nullptr);
+    EXPECT_NE(subject.store(track, cover.data(), cover.size()), nullptr);
+    EXPECT_NE(subject.open(track), nullptr);
+}
+
+TEST_F(ArtworkCacheTest, SharedCoverIsStoredOnce)
+{
+    ArtworkCache subject(cacheDir, 10);
+    subject.store(writeTrack("1.mp3"), cover.data(), cover.size());
+    subject.store(writeTrack("2.mp3"), cover.data(), cover.size());
+
+    auto other = std::vector<std::byte>(64, std::byte { 0x18 });
+    subject.store(writeTrack("3.mp3"), other.data(), other.size());
+
+    EXPECT_EQ(countImages(), 2u);
+    EXPECT_NE(ArtworkCache::getContentName(cover.data(), cover.size()), ArtworkCache::getContentName(other.data(), other.size()));
+}
+
+TEST_F(ArtworkCacheTest, ModifiedFileIsNotServed)
+{
+    auto track = writeTrack("a.mp3");
+    ArtworkCache subject(cacheDir, 10);
+    subject.store(track, cover.data(), cover.size());
+
+    fs::last_write_time(track, fs::last_write_time(track) + std::chrono::seconds(10));
+
+    EXPECT_EQ(subject.open(track), nullptr);
+}
+
+TEST_F(ArtworkCacheTest, DropsLeastRecentlyUsed)
+{
+    auto a = writeTrack("a.mp3");
+    auto b = writeTrack("b.mp3");
+    auto c = writeTrack("c.mp3");
+    ArtworkCache subject(cacheDir, 2);
+
+    subject.store(a, cover.data(), cover.size());
+    subject.store(b, cover.data(), cover.size());
+    EXPECT_NE(subject.open(a), nullptr);
+    subject.store(c, cover.data(), cover.size());
+
+    EXPECT_NE(subject.open(a), nullptr);
+    EXPECT_EQ(subject.open(b), nullptr);
+    EXPECT_NE(subject.open(c), nullptr);
+}
+
+TEST_F(ArtworkCacheTest, EvictedImageIsDeleted)
+{
+    ArtworkCache subject(cacheDir, 2);
+    auto other = std::vector<std::byte>(64, std::byte { 0x18 });
+    auto third = std::vector<std::byte>(64, std::byte { 0x19 });
+
+    subject.store(writeTrack("a.mp3"), cover.data(), cover.size());
+    subject.store(writeTrack("b.mp3"), cover.data(), cover.size());
+    subject.store(writeTrack("c.mp3"), other.data(), other.size());
+    // a is dropped, its cover is still used by b
+    EXPECT_EQ(countImages(), 2u);
+
+    subject.store(writeTrack("d.mp3"), third.data(), third.size());
+    EXPECT_EQ(countImages(), 2u);
+    EXPECT_FALSE(fs::exists(cacheDir / ArtworkCache::getContentName(cover.data(), cover.size()).substr(0, 2)
+        / ArtworkCache::getContentName(cover.data(), cover.size())));
+}
+
+TEST_F(ArtworkCacheTest, UnusedImagesAreRemovedOnStartup)
+{
+    {
+        ArtworkCache subject(cacheDir, 10);
+        subject.store(writeTrack("a.mp3"), cover.data(), cover.size());
+    }
+    std::ofstream(cacheDir / "keep.txt") << "not ours";
+    EXPECT_EQ(countImages(), 2u);
+
+    ArtworkCache reloaded(cacheDir, 10);
+    EXPECT_EQ(countImages(), 1u);
+    EXPECT_TRUE(fs::exists(cacheDir / "keep.txt"));
+}
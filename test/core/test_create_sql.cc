@@ -0,0 +1,31 @@
+#include <database/sqlite3/sqlite3_create_sql.h>
+#ifdef HAVE_MYSQL
+#include <database/mysql/mysql_create_sql.h>
+#endif
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <zlib.h>
+
+static unsigned long inflatedSize(const unsigned char* data, unsigned long size, unsigned long expected)
+{
+    // one spare byte shows if the blob inflates to more than declared
+    std::vector<unsigned char> buf(expected + 1);
+    unsigned long length = buf.size();
+    EXPECT_EQ(uncompress(buf.data(), &length, data, size), Z_OK);
+    return length;
+}
+
+TEST(CreateSqlTest, Sqlite3BlobMatchesDeclaredSizes)
+{
+    EXPECT_EQ(sizeof(sqlite3_create_sql), static_cast<std::size_t>(SL3_CREATE_SQL_DEFLATED_SIZE));
+    EXPECT_EQ(inflatedSize(sqlite3_create_sql, SL3_CREATE_SQL_DEFLATED_SIZE, SL3_CREATE_SQL_INFLATED_SIZE), static_cast<unsigned long>(SL3_CREATE_SQL_INFLATED_SIZE));
+}
+
+#ifdef HAVE_MYSQL
+TEST(CreateSqlTest, MysqlBlobMatchesDeclaredSizes)
+{
+    EXPECT_EQ(sizeof(mysql_create_sql), static_cast<std::size_t>(MS_CREATE_SQL_DEFLATED_SIZE));
+    EXPECT_EQ(inflatedSize(mysql_create_sql, MS_CREATE_SQL_DEFLATED_SIZE, MS_CREATE_SQL_INFLATED_SIZE), static_cast<unsigned long>(MS_CREATE_SQL_INFLATED_SIZE));
+}
+#endif
@@ -0,0 +1,94 @@
+#include <util/directory_crawler.h>
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <set>
+
+#include "../mock/temp_directory.h"
+
+class DirectoryCrawlerTest : public TempDirectoryTest {
+public:
+    DirectoryCrawlerTest()
+        : TempDirectoryTest("crawler")
+    {
+    }
+
+    void SetUp() override
+    {
+        TempDirectoryTest::SetUp();
+        for (int i = 0; i < 5; i++) {
+            auto dir = root / ("dir" + std::to_string(i)) / "sub";
+            fs::create_directories(dir);
+            std::ofstream(dir / "a.mp3") << "a";
+            std::ofstream(dir.parent_path() / "b.mp3") << "b";
+        }
+        std::ofstream(root / ".hidden.mp3") << "h";
+        fs::create_directory_symlink(root / "dir0", root / "link");
+    }
+
+    std::set<fs::path> crawl(DirectoryCrawler& subject, bool followSymlinks, bool hidden, std::set<fs::path>* dirs = nullptr)
+    {
+        std::set<fs::path> files;
+        auto crawl = subject.start(root, followSymlinks, hidden);
+        while (auto listing = crawl->next()) {
+            for (const auto& entry : listing->entries) {
+                if (!entry.isDirectory)
+                    files.insert(entry.path);
+                else if (dirs != nullptr)
+                    dirs->insert(entry.path);
+            }
+        }
+        return files;
+    }
+
+};
+
+TEST_F(DirectoryCrawlerTest, ReportsWholeTree)
+{
+    DirectoryCrawler subject(3);
+    std::set<fs::path> dirs;
+    auto files = crawl(subject, false, false, &dirs);
+
+    EXPECT_EQ(files.size(), 10u);
+    EXPECT_EQ(dirs.size(), 10u);
+    EXPECT_EQ(files.count(root / "dir3" / "sub" / "a.mp3"), 1u);
+    EXPECT_EQ(dirs.count(root / "link"), 0u);
+}
+
+TEST_F(DirectoryCrawlerTest, FollowsSymlinksAndHidden)
+{
+    DirectoryCrawler subject(2);
+    auto files = crawl(subject, true, true);
+
+    EXPECT_EQ(files.size(), 13u);
+    EXPECT_EQ(files.count(root / ".hidden.mp3"), 1u);
+    EXPECT_EQ(files.count(root / "link" / "sub" / "a.mp3"), 1u);
+}
+
+TEST_F(DirectoryCrawlerTest, StopEndsListing)
+{
+    DirectoryCrawler subject(2);
+    auto crawl = subject.start(root, false, false);
+    EXPECT_NE(crawl->next(), nullptr);
+    crawl->stop();
+    EXPECT_EQ(crawl->next(), nullptr);
+}
+
+TEST_F(DirectoryCrawlerTest, ServesCrawlsOneAfterAnother)
+{
+    DirectoryCrawler subject(2);
+    auto first = crawl(subject, false, false);
+    auto second = crawl(subject, true, true);
+
+    EXPECT_EQ(first.size(), 10u);
+    EXPECT_EQ(second.size(), 13u);
+}
+
+TEST_F(DirectoryCrawlerTest, DroppedCrawlEnds)
+{
+    DirectoryCrawler subject(1);
+    subject.start(root, false, false);
+    auto files = crawl(subject, false, false);
+
+    EXPECT_EQ(files.size(), 10u);
+}
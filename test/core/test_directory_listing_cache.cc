@@ -0,0 +1,44 @@
+#include <metadata/directory_listing_cache.h>
+
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "../mock/temp_directory.h"
+
+class DirectoryListingCacheTest : public TempDirectoryTest {
+public:
+    DirectoryListingCacheTest()
+        : TempDirectoryTest("listing")
+    {
+    }
+
+    void SetUp() override
+    {
+        TempDirectoryTest::SetUp();
+        fs::create_directories(root / "sub");
+        std::ofstream(root / "Cover.JPG") << "cover";
+        std::ofstream(root / "movie.srt") << "subtitle";
+    }
+
+};
+
+TEST_F(DirectoryListingCacheTest, FindsFilesByCase)
+{
+    DirectoryListingCache subject(4);
+
+    EXPECT_EQ(subject.find(root, "movie.srt", true), root / "movie.srt");
+    EXPECT_EQ(subject.find(root, "cover.jpg", true), fs::path());
+    EXPECT_EQ(subject.find(root, "cover.jpg", false), root / "Cover.JPG");
+    EXPECT_EQ(subject.find(root, "sub", false), fs::path());
+}
+
+TEST_F(DirectoryListingCacheTest, ChangedFolderIsReadAgain)
+{
+    DirectoryListingCache subject(4);
+    EXPECT_EQ(subject.find(root, "folder.jpg", false), fs::path());
+
+    std::ofstream(root / "folder.jpg") << "folder";
+    fs::last_write_time(root, fs::last_write_time(root) + std::chrono::seconds(10));
+
+    EXPECT_EQ(subject.find(root, "folder.jpg", false), root / "folder.jpg");
+}
@@ -0,0 +1,75 @@
+#include <metadata/media_file.h>
+
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "../mock/temp_directory.h"
+
+class MediaFileTest : public TempDirectoryTest {
+public:
+    MediaFileTest()
+        : TempDirectoryTest("mediafile")
+    {
+    }
+
+    void SetUp() override
+    {
+        TempDirectoryTest::SetUp();
+        path = root / "media.bin";
+        std::ofstream out(path, std::ios::binary);
+        for (int i = 0; i < 1000; i++)
+            out.put(static_cast<char>(i % 251));
+    }
+
+    fs::path path;
+};
+
+TEST_F(MediaFileTest, ReadsHeaderAndTrailerFromMemory)
+{
+    MediaFile subject(path, 100, 100);
+    char buffer[10];
+
+    EXPECT_EQ(subject.getSize(), 1000);
+    EXPECT_EQ(subject.read(0, buffer, 10), 10u);
+    EXPECT_EQ(buffer[5], 5);
+    EXPECT_EQ(subject.read(990, buffer, 20), 10u);
+    EXPECT_EQ(buffer[0], static_cast<char>(990 % 251));
+    EXPECT_EQ(subject.getReadCount(), 0u);
+}
+
+TEST_F(MediaFileTest, ReadsMiddleFromFile)
+{
+    MediaFile subject(path, 100, 100);
+    char buffer[10];
+
+    EXPECT_EQ(subject.read(500, buffer, 10), 10u);
+    EXPECT_EQ(buffer[0], static_cast<char>(500 % 251));
+    EXPECT_EQ(subject.read(1000, buffer, 10), 0u);
+    EXPECT_EQ(subject.getReadCount(), 1u);
+}
+
+TEST_F(MediaFileTest, ReadsOnlyWhatIsNeeded)
+{
+    MediaFile subject(path, 100, 100);
+
+    // the file is changed after opening, the new data shows that nothing was read ahead
+    {
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp(5);
+        out.put('x');
+        out.seekp(995);
+        out.put('y');
+    }
+
+    char buffer[10];
+    EXPECT_EQ(subject.read(0, buffer, 10), 10u);
+    EXPECT_EQ(buffer[5], 'x');
+    EXPECT_EQ(subject.read(990, buffer, 10), 10u);
+    EXPECT_EQ(buffer[5], 'y');
+    EXPECT_EQ(subject.getReadCount(), 0u);
+}
+
+TEST_F(MediaFileTest, RejectsDirectories)
+{
+    EXPECT_THROW(MediaFile(fs::temp_directory_path()), std::runtime_error);
+}
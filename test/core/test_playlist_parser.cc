@@ -0,0 +1,61 @@
+#include <util/playlist_parser.h>
+
+#include <gtest/gtest.h>
+#include <string>
+
+static std::vector<PlaylistParser::Entry> parse(PlaylistParser::Type type, const std::string& text)
+{
+    return PlaylistParser::parse(type, text.data(), text.size(), "/music/lists");
+}
+
+TEST(PlaylistParserTest, ReadsExtendedM3U)
+{
+    auto entries = parse(PlaylistParser::Type::M3U,
+        "\xEF\xBB\xBF#EXTM3U\r\n"
+        "#EXTINF:123, First Song\r\n"
+        "../a/1.mp3\r\n"
+        "\r\n"
+        "/abs/2.mp3\n"
+        "#EXTINF:-1,Radio\n"
+        "http://radio.example/stream\n");
+
+    ASSERT_EQ(entries.size(), 3u);
+    EXPECT_EQ(entries[0].location, "/music/a/1.mp3");
+    EXPECT_EQ(entries[0].title, "First Song");
+    EXPECT_EQ(entries[0].order, 1);
+    EXPECT_EQ(entries[1].location, "/abs/2.mp3");
+    EXPECT_EQ(entries[1].title, "");
+    EXPECT_EQ(entries[2].location, "http://radio.example/stream");
+    EXPECT_EQ(entries[2].title, "Radio");
+    EXPECT_EQ(entries[2].order, 3);
+    EXPECT_TRUE(PlaylistParser::isURL(entries[2].location));
+}
+
+TEST(PlaylistParserTest, ReadsNumberedPLSEntries)
+{
+    auto entries = parse(PlaylistParser::Type::PLS,
+        "[playlist]\n"
+        "NumberOfEntries=3\n"
+        "Title2=Second\n"
+        "File2=2.mp3\n"
+        "file1 = http://radio.example/stream\n"
+        "Title1=Radio\n"
+        "Length1=-1\n"
+        "Title3=Without file\n"
+        "Version=2\n");
+
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].location, "http://radio.example/stream");
+    EXPECT_EQ(entries[0].title, "Radio");
+    EXPECT_EQ(entries[0].order, 1);
+    EXPECT_EQ(entries[1].location, "/music/lists/2.mp3");
+    EXPECT_EQ(entries[1].title, "Second");
+    EXPECT_EQ(entries[1].order, 2);
+}
+
+TEST(PlaylistParserTest, MapsPlaylistMimetypes)
+{
+    EXPECT_EQ(PlaylistParser::getType("audio/x-mpegurl"), PlaylistParser::Type::M3U);
+    EXPECT_EQ(PlaylistParser::getType("audio/x-scpls"), PlaylistParser::Type::PLS);
+    EXPECT_EQ(PlaylistParser::getType("audio/mpeg"), PlaylistParser::Type::None);
+}
@@ -0,0 +1,38 @@
+#include <database/sql_database.h>
+
+#include <gtest/gtest.h>
+
+static const std::map<std::string, std::string> base {
+    { "dc:title", "Song" },
+    { "upnp:artist", "Artist" },
+    { "upnp:album", "Album" },
+    { "upnp:genre", "Rock" },
+};
+
+TEST(ReferenceMetadataTest, StoresOnlyDifferences)
+{
+    auto metadata = base;
+    metadata["upnp:genre"] = "Pop";
+    metadata["upnp:date"] = "2020";
+
+    auto stored = SQLDatabase::getReferenceMetadata(base, metadata);
+    EXPECT_EQ(stored, (std::map<std::string, std::string> { { "upnp:genre", "Pop" }, { "upnp:date", "2020" } }));
+    EXPECT_EQ(SQLDatabase::mergeReferenceMetadata(stored, base), metadata);
+}
+
+TEST(ReferenceMetadataTest, DroppedKeysStayDropped)
+{
+    auto metadata = base;
+    metadata.erase("upnp:album");
+    metadata["upnp:genre"] = "";
+
+    auto stored = SQLDatabase::getReferenceMetadata(base, metadata);
+    EXPECT_EQ(stored.size(), 2u);
+    EXPECT_EQ(SQLDatabase::mergeReferenceMetadata(stored, base), metadata);
+}
+
+TEST(ReferenceMetadataTest, UnchangedReferenceStoresNothing)
+{
+    EXPECT_TRUE(SQLDatabase::getReferenceMetadata(base, base).empty());
+    EXPECT_EQ(SQLDatabase::mergeReferenceMetadata({}, base), base);
+}
@@ -0,0 +1,83 @@
+#include <config/config_options.h>
+#include <layout/template_layout.h>
+#include <metadata/metadata_handler.h>
+
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+
+using Key = TemplateLayout::Key;
+
+static std::string expand(const std::string& text, const TemplateLayout::Values& values, bool path)
+{
+    std::string result;
+    TemplateLayout::Template(text).expand(values, path, result);
+    return result;
+}
+
+TEST(TemplateLayoutTest, ExpandsPathsWithDefaults)
+{
+    std::map<std::string, std::string> meta {
+        { MetadataHandler::getMetaFieldName(M_ARTIST), "AC/DC" },
+        { MetadataHandler::getMetaFieldName(M_DATE), "1980-07-25" },
+    };
+    std::string objTitle = "track.mp3";
+    auto values = TemplateLayout::getValues(meta, objTitle);
+
+    EXPECT_EQ(expand("/Audio/Artists/%artist%/%album%", values, true), "/Audio/Artists/AC\\/DC/Unknown");
+    EXPECT_EQ(expand("/Audio/Year/%year%", values, true), "/Audio/Year/1980");
+    EXPECT_EQ(expand("/Audio/Composers/%composer%", values, true), "/Audio/Composers/None");
+    EXPECT_EQ(expand("100%% %title%", values, true), "100% track.mp3");
+}
+
+TEST(TemplateLayoutTest, DropsMissingValuesFromTitles)
+{
+    std::map<std::string, std::string> meta {
+        { MetadataHandler::getMetaFieldName(M_TITLE), "Song" },
+        { MetadataHandler::getMetaFieldName(M_ARTIST), "Artist" },
+    };
+    std::string objTitle = "track.mp3";
+    auto values = TemplateLayout::getValues(meta, objTitle);
+    EXPECT_EQ(expand("%artist% - %album% - %title%", values, false), "Artist - Song");
+
+    meta[MetadataHandler::getMetaFieldName(M_ALBUM)] = "Album";
+    values = TemplateLayout::getValues(meta, objTitle);
+    EXPECT_EQ(expand("%artist% - %album% - %title%", values, false), "Artist - Album - Song");
+}
+
+TEST(TemplateLayoutTest, DerivesContainerClasses)
+{
+    TemplateLayout::Rule album("/Audio/Artists/%artist%/%album%", "");
+    EXPECT_EQ(album.upnpClass, UPNP_DEFAULT_CLASS_MUSIC_ALBUM);
+    EXPECT_TRUE(album.isAlbum);
+
+    TemplateLayout::Rule genre("/Audio/Genres/%genre%", "%title%");
+    EXPECT_EQ(genre.upnpClass, UPNP_DEFAULT_CLASS_MUSIC_GENRE);
+    EXPECT_FALSE(genre.isAlbum);
+
+    TemplateLayout::Rule all("/Audio/Artists/%artist%/All Songs", "%title%");
+    EXPECT_EQ(all.upnpClass, "");
+
+    EXPECT_EQ(TemplateLayout::Template("%album%").singleKey(), Key::Album);
+    EXPECT_EQ(TemplateLayout::Template("%album% (%year%)").singleKey(), Key::Literal);
+    EXPECT_THROW(TemplateLayout::Template("/Audio/%unknown%"), std::runtime_error);
+    EXPECT_THROW(TemplateLayout::Template("/Audio/%artist"), std::runtime_error);
+    EXPECT_THROW(TemplateLayout::Rule("Audio/%artist%", ""), std::runtime_error);
+}
+
+TEST(TemplateLayoutTest, KeepsRulesInConfigOrder)
+{
+    std::map<std::string, std::string> rules {
+        { "/Audio/B", "%title%" },
+        { "/Audio/A", "%title%" },
+        { "/Audio/C", "%title%" },
+    };
+    DictionaryOption option(rules, { "/Audio/C", "/Audio/A" });
+    auto ordered = option.getOrderedDictionaryOption();
+
+    ASSERT_EQ(ordered.size(), 3u);
+    EXPECT_EQ(ordered[0].first, "/Audio/C");
+    EXPECT_EQ(ordered[1].first, "/Audio/A");
+    EXPECT_EQ(ordered[2].first, "/Audio/B");
+    EXPECT_EQ(TemplateLayout::getDefaultRules().front().first, "/Audio/All Audio");
+}
@@ -0,0 +1,139 @@
+#include <metadata/ffmpeg_handler.h>
+#include <metadata/thumbnail_cache.h>
+
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "../mock/temp_directory.h"
+
+#if defined(HAVE_FFMPEG) && defined(HAVE_FFMPEGTHUMBNAILER)
+
+class ThumbnailCacheTest : public TempDirectoryTest {
+public:
+    ThumbnailCacheTest()
+        : TempDirectoryTest("thumbcache")
+    {
+    }
+
+    void SetUp() override
+    {
+        TempDirectoryTest::SetUp();
+        fs::create_directories(root / "movies");
+        cacheDir = root / "cache";
+    }
+
+    fs::path writeMovie(const std::string& name, const std::string& content)
+    {
+        auto path = root / "movies" / name;
+        std::ofstream(path) << content;
+        return path;
+    }
+
+    static std::vector<std::byte> image(size_t size)
+    {
+        return std::vector<std::byte>(size, std::byte { 0x42 });
+    }
+
+    fs::path cacheDir;
+};
+
+TEST_F(ThumbnailCacheTest, ReturnsStoredThumbnail)
+{
+    auto movie = writeMovie("a.avi", "movie");
+    ThumbnailCache subject(cacheDir, "128", 0);
+
+    EXPECT_FALSE(subject.get(movie).has_value());
+    subject.put(movie, image(10));
+
+    EXPECT_TRUE(subject.isValid(movie));
+    auto data = subject.get(movie);
+    ASSERT_TRUE(data.has_value());
+    EXPECT_EQ(data->size(), 10u);
+}
+
+TEST_F(ThumbnailCacheTest, ChangedMovieInvalidatesThumbnail)
+{
+    auto movie = writeMovie("a.avi", "movie");
+    ThumbnailCache subject(cacheDir, "128", 0);
+    subject.put(movie, image(10));
+
+    writeMovie("a.avi", "a longer movie");
+
+    EXPECT_FALSE(subject.isValid(movie));
+    EXPECT_FALSE(subject.get(movie).has_value());
+    EXPECT_FALSE(fs::exists(getThumbnailCachePath(cacheDir, movie)));
+}
+
+TEST_F(ThumbnailCacheTest, ChangedSettingsInvalidateThumbnail)
+{
+    auto movie = writeMovie("a.avi", "movie");
+    {
+        ThumbnailCache subject(cacheDir, "128", 0);
+        subject.put(movie, image(10));
+        subject.save();
+    }
+
+    ThumbnailCache reloaded(cacheDir, "128", 0);
+    EXPECT_TRUE(reloaded.isValid(movie));
+
+    ThumbnailCache other(cacheDir, "256", 0);
+    EXPECT_FALSE(other.isValid(movie));
+}
+
+TEST_F(ThumbnailCacheTest, EvictsLeastRecentlyUsed)
+{
+    auto a = writeMovie("a.avi", "a");
+    auto b = writeMovie("b.avi", "b");
+    auto c = writeMovie("c.avi", "c");
+    ThumbnailCache subject(cacheDir, "128", 25);
+
+    subject.put(a, image(10));
+    subject.put(b, image(10));
+    EXPECT_TRUE(subject.get(a).has_value());
+    subject.put(c, image(10));
+
+    EXPECT_TRUE(subject.isValid(a));
+    EXPECT_FALSE(subject.isValid(b));
+    EXPECT_TRUE(subject.isValid(c));
+    EXPECT_EQ(subject.getSize(), 20u);
+}
+
+TEST_F(ThumbnailCacheTest, SweepRemovesOrphans)
+{
+    auto kept = writeMovie("kept.avi", "kept");
+    auto gone = writeMovie("gone.avi", "gone");
+    ThumbnailCache subject(cacheDir, "128", 0);
+    subject.put(kept, image(10));
+    subject.put(gone, image(10));
+
+    auto stray = getThumbnailCachePath(cacheDir, root / "movies" / "stray.avi");
+    std::ofstream(stray) << "old";
+    fs::last_write_time(stray, fs::file_time_type::clock::now() - std::chrono::hours(1));
+
+    subject.sweep([&](const fs::path& movie) { return movie == kept; });
+
+    EXPECT_TRUE(subject.isValid(kept));
+    EXPECT_FALSE(subject.isValid(gone));
+    EXPECT_FALSE(fs::exists(getThumbnailCachePath(cacheDir, gone)));
+    EXPECT_FALSE(fs::exists(stray));
+}
+
+TEST_F(ThumbnailCacheTest, FlushWaitsBeforeWritingIndex)
+{
+    auto movie = writeMovie("a.avi", "movie");
+    {
+        ThumbnailCache subject(cacheDir, "128", 0);
+        subject.put(movie, image(10));
+        subject.flush();
+
+        ThumbnailCache reloaded(cacheDir, "128", 0);
+        EXPECT_FALSE(reloaded.isValid(movie));
+
+        subject.save();
+    }
+
+    ThumbnailCache reloaded(cacheDir, "128", 0);
+    EXPECT_TRUE(reloaded.isValid(movie));
+}
+
+#endif
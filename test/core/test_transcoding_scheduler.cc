@@ -0,0 +1,87 @@
+#include "transcoding/transcoding.h"
+#include "transcoding/transcoding_scheduler.h"
+
+#include <gtest/gtest.h>
+
+class TranscodingSchedulerTest : public ::testing::Test {
+public:
+    void SetUp() override
+    {
+        profiles = std::make_shared<TranscodingProfileList>();
+        high = std::make_shared<TranscodingProfile>(TR_External, "video-high");
+        high->setTargetMimeType("video/mpeg");
+        high->setMaxConcurrent(1);
+        high->setFallback("video-low");
+        low = std::make_shared<TranscodingProfile>(TR_External, "video-low");
+        low->setTargetMimeType("video/mpeg");
+        profiles->add("video/x-matroska", high);
+        profiles->add("video/mp4", low);
+    }
+
+    std::shared_ptr<TranscodingProfileList> profiles;
+    std::shared_ptr<TranscodingProfile> high;
+    std::shared_ptr<TranscodingProfile> low;
+};
+
+class FixedLoadScheduler : public TranscodingScheduler {
+public:
+    FixedLoadScheduler(int maxConcurrent, int maxCpuLoad, bool degrade, int load)
+        : TranscodingScheduler(maxConcurrent, maxCpuLoad, 0, degrade)
+        , load(load)
+    {
+    }
+
+protected:
+    int getCpuLoad() const override { return load; }
+    int load;
+};
+
+TEST_F(TranscodingSchedulerTest, RejectsAboveGlobalLimit)
+{
+    auto scheduler = std::make_shared<TranscodingScheduler>(1, 0, 0, false);
+    auto slot = scheduler->acquire(low, profiles);
+    EXPECT_THROW(scheduler->acquire(low, profiles), std::runtime_error);
+
+    auto stats = scheduler->getStats();
+    EXPECT_EQ(stats.running, 1);
+    EXPECT_EQ(stats.admitted, 1);
+    EXPECT_EQ(stats.rejected, 1);
+
+    slot.reset();
+    EXPECT_EQ(scheduler->getStats().running, 0);
+    EXPECT_NO_THROW(scheduler->acquire(low, profiles));
+}
+
+TEST_F(TranscodingSchedulerTest, DegradesToFallbackProfile)
+{
+    auto scheduler = std::make_shared<TranscodingScheduler>(0, 0, 0, true);
+    auto first = scheduler->acquire(high, profiles);
+    EXPECT_EQ(first->getProfile(), high);
+    EXPECT_FALSE(first->isDegraded());
+
+    auto second = scheduler->acquire(high, profiles);
+    EXPECT_EQ(second->getProfile(), low);
+    EXPECT_TRUE(second->isDegraded());
+    EXPECT_EQ(scheduler->getStats().degraded, 1);
+    EXPECT_EQ(scheduler->getStats().runningByProfile["video-low"], 1);
+}
+
+TEST_F(TranscodingSchedulerTest, FallbackNeedsSameMimeType)
+{
+    low->setTargetMimeType("video/mp4");
+    auto scheduler = std::make_shared<TranscodingScheduler>(0, 0, 0, true);
+    auto first = scheduler->acquire(high, profiles);
+    EXPECT_THROW(scheduler->acquire(high, profiles), std::runtime_error);
+}
+
+TEST_F(TranscodingSchedulerTest, CpuLoadBlocksOnlyAdditionalTranscoders)
+{
+    auto scheduler = std::make_shared<FixedLoadScheduler>(0, 80, false, 95);
+    auto first = scheduler->acquire(low, profiles);
+    EXPECT_THROW(scheduler->acquire(low, profiles), std::runtime_error);
+
+    auto degrading = std::make_shared<FixedLoadScheduler>(0, 80, true, 95);
+    auto slot = degrading->acquire(low, profiles);
+    auto next = degrading->acquire(high, profiles);
+    EXPECT_TRUE(next->isDegraded());
+}
@@ -16,6 +16,7 @@ public:
     int getIntOption(config_option_t option) const override { return 0; }
     bool getBoolOption(config_option_t option) const override { return false; }
     std::map<std::string, std::string> getDictionaryOption(config_option_t option) const override { return std::map<std::string, std::string>(); }
+    std::vector<std::pair<std::string, std::string>> getOrderedDictionaryOption(config_option_t option) const override { return std::vector<std::pair<std::string, std::string>>(); }
     std::vector<std::string> getArrayOption(config_option_t option) const override { return std::vector<std::string>(); }
     std::shared_ptr<AutoscanList> getAutoscanListOption(config_option_t option) const override { return nullptr; }
     std::shared_ptr<ClientConfigList> getClientConfigListOption(config_option_t option) const override { return nullptr; }
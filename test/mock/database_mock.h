@@ -48,6 +48,10 @@ public:
     std::unique_ptr<ChangedContainers> removeObject(int objectID, bool all) override { return nullptr; }
     std::unique_ptr<std::unordered_set<int>> getObjects(int parentID, bool withoutContainer) override { return nullptr; }
     std::unique_ptr<ChangedContainers> removeObjects(const std::unique_ptr<std::unordered_set<int>>& list, bool all = false) override { return nullptr; }
+    std::unique_ptr<ChangedContainers> removeReferences(int objectID) override { return nullptr; }
+    std::unordered_map<std::string, PathInfo> getChildPaths(int parentID) override { return std::unordered_map<std::string, PathInfo>(); }
+    void storeFingerprint(const std::shared_ptr<CdsObject>& obj) override { }
+    std::vector<int> moveObject(int objectID, const fs::path& newPath, int parentID) override { return std::vector<int>(); }
 
     std::shared_ptr<CdsObject> loadObjectByServiceID(const std::string& serviceID) override { return nullptr; }
     std::unique_ptr<std::vector<int>> getServiceObjectIDs(char servicePrefix) override { return nullptr; }
@@ -78,6 +82,8 @@ public:
     int ensurePathExistence(fs::path path, int* changedContainer) override { return 0; }
 
     void clearFlagInDB(int flag) override { }
+    void clearFlagInDB(const std::vector<int>& objectIDs, int flag) override { }
+    std::vector<int> getObjectsWithFlag(int flag) override { return {}; }
     std::string getFsRootName() override { return ""; }
 
     void threadCleanup() override { }
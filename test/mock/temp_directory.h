@@ -0,0 +1,34 @@
+#ifndef __TEMP_DIRECTORY_H__
+#define __TEMP_DIRECTORY_H__
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+namespace fs = std::filesystem;
+
+/// \brief Fixture providing an empty directory below the system temp directory
+///
+/// The directory is created before and removed after each test.
+class TempDirectoryTest : public ::testing::Test {
+protected:
+    explicit TempDirectoryTest(const std::string& name)
+        : root(fs::temp_directory_path() / ("gerbera-" + name + "-" + std::to_string(getpid())))
+    {
+    }
+
+    void SetUp() override
+    {
+        fs::remove_all(root);
+        fs::create_directories(root);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(root);
+    }
+
+    fs::path root;
+};
+
+#endif // __TEMP_DIRECTORY_H__